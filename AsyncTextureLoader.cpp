@@ -0,0 +1,642 @@
+#include "AsyncTextureLoader.h"
+#include "GLCaps.h"
+#include "KtxFormat.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stb_image.h>
+
+// Pick the GL pixel format matching the decoded channel count
+static GLenum formatForChannels(int channels)
+{
+    switch (channels)
+    {
+    case 1:  return GL_RED;
+    case 2:  return GL_RG;
+    case 3:  return GL_RGB;
+    default: return GL_RGBA;
+    }
+}
+
+// Bilinear resample of an RGBA8 image to the layer size
+static void resampleRGBA(const unsigned char* src, int srcW, int srcH,
+    unsigned char* dst, int dstW, int dstH)
+{
+    for (int y = 0; y < dstH; y++)
+    {
+        float sy = ((y + 0.5f) * srcH / dstH) - 0.5f;
+        int y0 = std::max(0, std::min((int)sy, srcH - 1));
+        int y1 = std::min(y0 + 1, srcH - 1);
+        float fy = std::max(0.0f, sy - y0);
+
+        for (int x = 0; x < dstW; x++)
+        {
+            float sx = ((x + 0.5f) * srcW / dstW) - 0.5f;
+            int x0 = std::max(0, std::min((int)sx, srcW - 1));
+            int x1 = std::min(x0 + 1, srcW - 1);
+            float fx = std::max(0.0f, sx - x0);
+
+            for (int c = 0; c < 4; c++)
+            {
+                float top = src[(y0 * srcW + x0) * 4 + c] * (1.0f - fx) + src[(y0 * srcW + x1) * 4 + c] * fx;
+                float bottom = src[(y1 * srcW + x0) * 4 + c] * (1.0f - fx) + src[(y1 * srcW + x1) * 4 + c] * fx;
+                dst[(y * dstW + x) * 4 + c] = (unsigned char)(top * (1.0f - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+}
+
+// 2x2 box filter of an RGBA8 level into the next one; odd edges reuse the
+// last row/column
+static void downsampleRGBA(const unsigned char* src, int srcW, int srcH,
+    unsigned char* dst, int dstW, int dstH)
+{
+    for (int y = 0; y < dstH; y++)
+    {
+        int y0 = std::min(y * 2, srcH - 1);
+        int y1 = std::min(y * 2 + 1, srcH - 1);
+        for (int x = 0; x < dstW; x++)
+        {
+            int x0 = std::min(x * 2, srcW - 1);
+            int x1 = std::min(x * 2 + 1, srcW - 1);
+            for (int c = 0; c < 4; c++)
+            {
+                int sum = src[((size_t)y0 * srcW + x0) * 4 + c] + src[((size_t)y0 * srcW + x1) * 4 + c] +
+                    src[((size_t)y1 * srcW + x0) * 4 + c] + src[((size_t)y1 * srcW + x1) * 4 + c];
+                dst[((size_t)y * dstW + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+AsyncTextureLoader::AsyncTextureLoader(
+    unsigned int workerCount,
+    unsigned int pboCount,
+    size_t pboSize,
+    size_t uploadBudgetPerFrame
+)
+    : jobsInFlight(0),
+    stopping(false),
+    nextSlot(0),
+    pboSize(pboSize),
+    uploadBudgetPerFrame(uploadBudgetPerFrame),
+    lastFrameUploadBytes(0)
+{
+    // PBO ring - allocated once, reused for every upload
+    pboRing.resize(std::max(1u, pboCount));
+    for (PboSlot& slot : pboRing)
+    {
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, pboSize, NULL, GL_STREAM_DRAW);
+        slot.fence = 0;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    for (unsigned int i = 0; i < std::max(1u, workerCount); i++)
+        workers.emplace_back(&AsyncTextureLoader::workerLoop, this);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+    shutdown();
+}
+
+unsigned int AsyncTextureLoader::LoadTextureAsync(const char* path, CompletionCallback onComplete)
+{
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    createPlaceholder(textureID);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        decodeQueue.push_back({ textureID, -1, 0, 0, 0, path, onComplete, nullptr });
+    }
+    queueCondition.notify_one();
+
+    return textureID;
+}
+
+void AsyncTextureLoader::LoadLayerAsync(const char* path, unsigned int arrayTextureID, int layer,
+    int layerWidth, int layerHeight, GLenum layerFormat, LayerCallback onComplete)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        decodeQueue.push_back({ arrayTextureID, layer, layerWidth, layerHeight, layerFormat, path,
+            nullptr, onComplete });
+    }
+    queueCondition.notify_one();
+}
+
+void AsyncTextureLoader::createPlaceholder(unsigned int textureID)
+{
+    // 2x2 grey checker so unfinished textures are visible but not distracting
+    const unsigned char pixels[] = {
+        96, 96, 96, 255,    160, 160, 160, 255,
+        160, 160, 160, 255, 96, 96, 96, 255
+    };
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// ============================================================================
+// WORKER THREADS
+// ============================================================================
+
+void AsyncTextureLoader::workerLoop()
+{
+    while (true)
+    {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+            if (stopping)
+                return;
+
+            job = std::move(decodeQueue.front());
+            decodeQueue.pop_front();
+            decodingTextures.push_back(job.textureID);
+            jobsInFlight++;
+        }
+
+        DecodedImage image{ job.textureID, job.layer, job.path, std::move(job.onComplete),
+            std::move(job.onLayerComplete), nullptr, {}, nullptr, {}, 0, 0, 0, 0, false };
+        if (loadCooked(job, image))
+        {
+            // Levels point into the mapping; nothing to decode
+        }
+        else if (job.layer < 0)
+        {
+            int channels = 0;
+            image.pixels = stbi_load(image.path.c_str(), &image.width, &image.height, &channels, 0);
+            if (image.pixels)
+            {
+                image.internalFormat = image.format = formatForChannels(channels);
+                image.levels.push_back({ image.pixels, image.width, image.height,
+                    (size_t)image.width * channels, image.height });
+            }
+        }
+        else if (job.layerFormat == GL_RGBA8)
+        {
+            decodeLayer(job, image);
+        }
+        // A compressed array only takes matching cooked layers; this one stays a placeholder
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        decodedQueue.push_back(std::move(image));
+        decodingTextures.erase(std::find(decodingTextures.begin(), decodingTextures.end(), job.textureID));
+        jobsInFlight--;
+        decodedCondition.notify_all();
+    }
+}
+
+// Map the cooked KTX and point the levels into it. False (and the caller
+// decodes the source) when there is none, it is damaged, the driver cannot
+// sample its format, or it does not match the array layer it is meant for.
+bool AsyncTextureLoader::loadCooked(const DecodeJob& job, DecodedImage& image)
+{
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->open(KtxFormat::cookedPath(image.path).c_str()))
+        return false;
+
+    KtxFormat::Header header;
+    std::vector<KtxFormat::Level> ktxLevels;
+    if (KtxFormat::parse(file->data(), file->size(), header, ktxLevels) != KtxFormat::PARSE_OK)
+        return false;
+
+    bool compressed = header.glType == 0;
+    uint32_t blockBytes = KtxFormat::blockBytes(header.glInternalFormat);
+    if (compressed && (blockBytes == 0 || !GLCaps::hasS3TC()))
+        return false;
+    if (!compressed && (header.glType != GL_UNSIGNED_BYTE || header.glFormat != GL_RGBA))
+        return false;
+
+    if (job.layer >= 0)
+    {
+        size_t fullChain = 1;
+        for (int w = job.layerWidth, h = job.layerHeight; w > 1 || h > 1; w = std::max(1, w / 2), h = std::max(1, h / 2))
+            fullChain++;
+        if (header.glInternalFormat != job.layerFormat || (int)header.pixelWidth != job.layerWidth ||
+            (int)header.pixelHeight != job.layerHeight || ktxLevels.size() != fullChain)
+            return false;
+    }
+
+    std::vector<Level> levels;
+    for (const KtxFormat::Level& source : ktxLevels)
+    {
+        Level level = { source.pixels, (int)source.width, (int)source.height, 0, 0 };
+        if (compressed)
+        {
+            level.rowBytes = (size_t)((source.width + 3) / 4) * blockBytes;
+            level.rowCount = (int)((source.height + 3) / 4);
+        }
+        else
+        {
+            level.rowBytes = (size_t)source.width * 4;
+            level.rowCount = (int)source.height;
+        }
+        if (level.rowBytes * level.rowCount != source.imageSize)
+            return false;
+        levels.push_back(level);
+    }
+
+    if (!KtxFormat::findSourceSize(file->data(), file->size(), header, image.width, image.height))
+    {
+        image.width = (int)header.pixelWidth;
+        image.height = (int)header.pixelHeight;
+    }
+    image.internalFormat = header.glInternalFormat;
+    image.format = header.glFormat;
+    image.compressed = compressed;
+    image.levels = std::move(levels);
+    image.cookedFile = std::move(file);
+    return true;
+}
+
+// Decode as RGBA, resample to the layer size and build the full mip chain,
+// all into one allocation
+void AsyncTextureLoader::decodeLayer(const DecodeJob& job, DecodedImage& image)
+{
+    int channels = 0;
+    unsigned char* source = stbi_load(image.path.c_str(), &image.width, &image.height, &channels, 4);
+    if (!source)
+        return;
+    image.internalFormat = GL_RGBA8;
+    image.format = GL_RGBA;
+
+    size_t totalBytes = 0;
+    for (int w = job.layerWidth, h = job.layerHeight; ; w = std::max(1, w / 2), h = std::max(1, h / 2))
+    {
+        totalBytes += (size_t)w * h * 4;
+        if (w == 1 && h == 1)
+            break;
+    }
+    image.layerPixels.resize(totalBytes);
+
+    unsigned char* level = image.layerPixels.data();
+    int width = job.layerWidth;
+    int height = job.layerHeight;
+    resampleRGBA(source, image.width, image.height, level, width, height);
+    stbi_image_free(source);
+    image.levels.push_back({ level, width, height, (size_t)width * 4, height });
+
+    while (width > 1 || height > 1)
+    {
+        unsigned char* next = level + (size_t)width * height * 4;
+        int nextWidth = std::max(1, width / 2);
+        int nextHeight = std::max(1, height / 2);
+        downsampleRGBA(level, width, height, next, nextWidth, nextHeight);
+        image.levels.push_back({ next, nextWidth, nextHeight, (size_t)nextWidth * 4, nextHeight });
+
+        level = next;
+        width = nextWidth;
+        height = nextHeight;
+    }
+}
+
+// ============================================================================
+// GL THREAD
+// ============================================================================
+
+bool AsyncTextureLoader::acquireSlot(PboSlot*& slot)
+{
+    PboSlot& candidate = pboRing[nextSlot];
+    if (candidate.fence)
+    {
+        GLenum status = glClientWaitSync(candidate.fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+            return false;   // GPU still reading this slot, try again next frame
+
+        glDeleteSync(candidate.fence);
+        candidate.fence = 0;
+    }
+
+    slot = &candidate;
+    nextSlot = (nextSlot + 1) % pboRing.size();
+    return true;
+}
+
+// Hand rows [firstRow, firstRow + rows) of one level to GL, from the bound
+// PBO (data is an offset) or from client memory. Compressed rows are block
+// rows, so the texel offset is a multiple of 4 and the last one may be short.
+void AsyncTextureLoader::copyRows(const DecodedImage& image, int level, int firstRow, int rows, const void* data)
+{
+    const Level& source = image.levels[level];
+    if (image.compressed)
+    {
+        int y = firstRow * 4;
+        int height = std::min(rows * 4, source.height - y);
+        GLsizei bytes = (GLsizei)(rows * source.rowBytes);
+        if (image.layer < 0)
+        {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, source.width, height,
+                image.internalFormat, bytes, data);
+        }
+        else
+        {
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, y, image.layer, source.width, height, 1,
+                image.internalFormat, bytes, data);
+        }
+    }
+    else if (image.layer < 0)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, firstRow, source.width, rows,
+            image.format, GL_UNSIGNED_BYTE, data);
+    }
+    else
+    {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, firstRow, image.layer, source.width, rows, 1,
+            image.format, GL_UNSIGNED_BYTE, data);
+    }
+}
+
+// Copy as many rows as the budget and ring allow. Returns true once every
+// level of the image has been handed to GL.
+bool AsyncTextureLoader::uploadRows(Upload& upload, size_t& budget)
+{
+    DecodedImage& image = upload.image;
+    GLenum target = image.layer < 0 ? GL_TEXTURE_2D : GL_TEXTURE_2D_ARRAY;
+
+    glBindTexture(target, image.textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (image.layer < 0 && upload.level == 0 && upload.nextRow == 0)
+    {
+        // Replace the placeholder with storage of the real size, every level
+        // of it when the image brings its own mip chain
+        for (int i = 0; i < (int)image.levels.size(); i++)
+        {
+            const Level& level = image.levels[i];
+            if (image.compressed)
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, i, image.internalFormat, level.width, level.height, 0,
+                    (GLsizei)(level.rowBytes * level.rowCount), NULL);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, i, image.internalFormat, level.width, level.height, 0,
+                    image.format, GL_UNSIGNED_BYTE, NULL);
+            }
+        }
+        if (image.levels.size() > 1)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image.levels.size() - 1);
+    }
+
+    while (upload.level < (int)image.levels.size() && budget > 0)
+    {
+        const Level& level = image.levels[upload.level];
+        size_t rowBytes = level.rowBytes;
+        size_t rowsPerSlot = pboSize / rowBytes;
+
+        if (rowsPerSlot == 0)
+        {
+            // Row does not fit in a PBO - fall back to a direct client-memory
+            // upload, once the whole frame budget is free to cover it
+            if (budget < uploadBudgetPerFrame)
+                break;
+            size_t bytes = rowBytes * (level.rowCount - upload.nextRow);
+            copyRows(image, upload.level, upload.nextRow, level.rowCount - upload.nextRow,
+                level.pixels + upload.nextRow * rowBytes);
+            budget -= std::min(budget, bytes);
+            lastFrameUploadBytes += bytes;
+            upload.nextRow = level.rowCount;
+        }
+
+        while (upload.nextRow < level.rowCount && budget > 0)
+        {
+            PboSlot* slot = nullptr;
+            if (!acquireSlot(slot))
+                break;
+
+            size_t rowsLeft = (size_t)(level.rowCount - upload.nextRow);
+            size_t rowsInBudget = std::max<size_t>(1, budget / rowBytes);
+            size_t rows = std::min(rowsLeft, std::min(rowsPerSlot, rowsInBudget));
+            size_t bytes = rows * rowBytes;
+            const unsigned char* src = level.pixels + upload.nextRow * rowBytes;
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+            void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (dst)
+            {
+                memcpy(dst, src, bytes);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                copyRows(image, upload.level, upload.nextRow, (int)rows, (void*)0);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                copyRows(image, upload.level, upload.nextRow, (int)rows, src);
+            }
+            slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            upload.nextRow += (int)rows;
+            budget -= std::min(budget, bytes);
+            lastFrameUploadBytes += bytes;
+        }
+
+        if (upload.nextRow < level.rowCount)
+            break;
+        upload.level++;
+        upload.nextRow = 0;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (upload.level < (int)image.levels.size())
+        return false;
+
+    // Array layers and cooked images arrive with their mip chain; decoded 2D
+    // textures build theirs here
+    if (image.layer < 0)
+    {
+        if (image.levels.size() == 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    glBindTexture(target, 0);
+    return true;
+}
+
+void AsyncTextureLoader::notify(const CompletionCallback& onComplete, const LayerCallback& onLayerComplete,
+    unsigned int textureID, int layer, bool success, int width, int height)
+{
+    if (onComplete)
+        onComplete(textureID, success);
+    if (onLayerComplete)
+        onLayerComplete(layer, success, success ? width : 0, success ? height : 0);
+}
+
+void AsyncTextureLoader::update()
+{
+    lastFrameUploadBytes = 0;
+
+    // 1. Collect finished decodes. Failures are reported after the lock is
+    // released, so their callbacks may queue a retry or a fallback image.
+    std::vector<DecodedImage> failed;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        while (!decodedQueue.empty())
+        {
+            DecodedImage image = std::move(decodedQueue.front());
+            decodedQueue.pop_front();
+
+            if (image.levels.empty())
+                failed.push_back(std::move(image));
+            else
+                uploads.push_back({ std::move(image), 0, 0 });
+        }
+    }
+    for (const DecodedImage& image : failed)
+    {
+        std::cout << "Failed to load texture: " << image.path << std::endl;
+        notify(image.onComplete, image.onLayerComplete, image.textureID, image.layer, false, 0, 0);
+    }
+
+    // 2. Stream rows through the PBO ring within this frame's budget
+    size_t budget = uploadBudgetPerFrame;
+    while (!uploads.empty() && budget > 0)
+    {
+        Upload& upload = uploads.front();
+        if (!uploadRows(upload, budget))
+            break;
+
+        DecodedImage& image = upload.image;
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        completions.push_back({ image.textureID, image.layer, image.width, image.height,
+            std::move(image.onComplete), std::move(image.onLayerComplete), fence });
+        stbi_image_free(upload.image.pixels);
+        uploads.pop_front();
+    }
+
+    // 3. Fire callbacks for textures the GPU has finished with
+    for (size_t i = 0; i < completions.size();)
+    {
+        GLenum status = glClientWaitSync(completions[i].fence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            const PendingCompletion& completion = completions[i];
+            glDeleteSync(completion.fence);
+            notify(completion.onComplete, completion.onLayerComplete, completion.textureID,
+                completion.layer, true, completion.width, completion.height);
+            completions.erase(completions.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+bool AsyncTextureLoader::isIdle() const
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return decodeQueue.empty() && decodedQueue.empty() && jobsInFlight == 0 &&
+        uploads.empty() && completions.empty();
+}
+
+void AsyncTextureLoader::cancel(unsigned int textureID)
+{
+    std::vector<DecodedImage> dropped;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        decodeQueue.erase(std::remove_if(decodeQueue.begin(), decodeQueue.end(),
+            [textureID](const DecodeJob& job) { return job.textureID == textureID; }), decodeQueue.end());
+
+        // A worker holding one of its jobs pushes the result when done
+        decodedCondition.wait(lock, [this, textureID] {
+            return std::find(decodingTextures.begin(), decodingTextures.end(), textureID) == decodingTextures.end();
+        });
+
+        for (size_t i = 0; i < decodedQueue.size();)
+        {
+            if (decodedQueue[i].textureID == textureID)
+            {
+                dropped.push_back(std::move(decodedQueue[i]));
+                decodedQueue.erase(decodedQueue.begin() + i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+    for (DecodedImage& image : dropped)
+        stbi_image_free(image.pixels);
+
+    // Partial uploads can stop anywhere; the PBO slots keep their own fences
+    for (size_t i = 0; i < uploads.size();)
+    {
+        if (uploads[i].image.textureID == textureID)
+        {
+            stbi_image_free(uploads[i].image.pixels);
+            uploads.erase(uploads.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    for (size_t i = 0; i < completions.size();)
+    {
+        if (completions[i].textureID == textureID)
+        {
+            glDeleteSync(completions[i].fence);
+            completions.erase(completions.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+size_t AsyncTextureLoader::getLastFrameUploadBytes() const
+{
+    return lastFrameUploadBytes;
+}
+
+void AsyncTextureLoader::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopping && workers.empty())
+            return;
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+
+    for (DecodedImage& image : decodedQueue)
+        stbi_image_free(image.pixels);
+    decodedQueue.clear();
+    decodeQueue.clear();
+
+    for (Upload& upload : uploads)
+        stbi_image_free(upload.image.pixels);
+    uploads.clear();
+
+    for (PendingCompletion& completion : completions)
+        glDeleteSync(completion.fence);
+    completions.clear();
+
+    for (PboSlot& slot : pboRing)
+    {
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        glDeleteBuffers(1, &slot.buffer);
+    }
+    pboRing.clear();
+}
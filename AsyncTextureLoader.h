@@ -0,0 +1,175 @@
+#ifndef ASYNC_TEXTURE_LOADER_H
+#define ASYNC_TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+#include "MappedFile.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streams textures from disk without blocking the GL thread.
+//
+// LoadTextureAsync() returns a texture ID straight away; the texture holds a
+// small placeholder image until the real one arrives. Images are decoded on
+// worker threads, then copied into a ring of pixel-buffer objects and uploaded
+// a few rows at a time, never more than uploadBudgetPerFrame bytes per update().
+// A fence is placed after the last upload of each texture and the completion
+// callback fires once that fence has signalled.
+//
+// LoadLayerAsync() streams into one layer of an existing texture array the
+// same way; resampling to the layer size and building the mip chain happen on
+// the worker too, so the GL thread only copies finished levels.
+//
+// Both prefer a cooked KTX next to the source (KtxFormat::cookedPath, see
+// Tools/TextureCooker): it is memory-mapped on the worker and its
+// pre-filtered, possibly block-compressed levels go through the same PBO
+// ring with no decode, resample or glGenerateMipmap.
+class AsyncTextureLoader
+{
+public:
+    // Called on the GL thread (from update()) once a texture is fully resident
+    using CompletionCallback = std::function<void(unsigned int textureID, bool success)>;
+
+    // As above for array layers; sourceWidth/sourceHeight are the image's size
+    // before resampling (0 when it failed to load)
+    using LayerCallback = std::function<void(int layer, bool success, int sourceWidth, int sourceHeight)>;
+
+    AsyncTextureLoader(
+        unsigned int workerCount = 2,
+        unsigned int pboCount = 3,
+        size_t pboSize = 4 * 1024 * 1024,
+        size_t uploadBudgetPerFrame = 8 * 1024 * 1024
+    );
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    // Queue a file for loading. Must be called on the GL thread.
+    unsigned int LoadTextureAsync(const char* path, CompletionCallback onComplete = nullptr);
+
+    // Queue a file for one layer of a GL_TEXTURE_2D_ARRAY whose storage
+    // (layerWidth x layerHeight in layerFormat, full mip chain) already
+    // exists. A cooked KTX is used if it matches that storage exactly;
+    // otherwise the source is decoded, which only GL_RGBA8 arrays accept.
+    // The layer keeps whatever the caller put there until the upload
+    // completes. Must be called on the GL thread.
+    void LoadLayerAsync(const char* path, unsigned int arrayTextureID, int layer,
+        int layerWidth, int layerHeight, GLenum layerFormat, LayerCallback onComplete = nullptr);
+
+    // Pump decoded images into GL and retire finished uploads. Call once per frame.
+    void update();
+
+    // True when nothing is queued, decoding, uploading or waiting on a fence
+    bool isIdle() const;
+
+    // Forget every job for a texture - queued, decoding, uploading or waiting
+    // on a fence - without firing its callbacks. Blocks while a worker is
+    // still decoding one of them. Call on the GL thread before deleting a
+    // texture the loader may still write to.
+    void cancel(unsigned int textureID);
+
+    // Bytes pushed through the PBO ring during the last update()
+    size_t getLastFrameUploadBytes() const;
+
+    // Stop the workers and release all GL objects. Called by the destructor.
+    void shutdown();
+
+private:
+    struct DecodeJob {
+        unsigned int textureID;
+        int layer;               // array layer, -1 for a 2D texture
+        int layerWidth;
+        int layerHeight;
+        GLenum layerFormat;
+        std::string path;
+        CompletionCallback onComplete;
+        LayerCallback onLayerComplete;
+    };
+
+    // One mip level to upload, pointing into the image's pixel storage.
+    // Rows are pixel rows, or rows of 4x4 blocks for compressed formats.
+    struct Level {
+        const unsigned char* pixels;
+        int width;
+        int height;
+        size_t rowBytes;
+        int rowCount;
+    };
+
+    struct DecodedImage {
+        unsigned int textureID;
+        int layer;
+        std::string path;
+        CompletionCallback onComplete;
+        LayerCallback onLayerComplete;
+        unsigned char* pixels;   // 2D textures: owned, freed with stbi_image_free
+        std::vector<unsigned char> layerPixels;   // array layers: every level, resampled
+        std::unique_ptr<MappedFile> cookedFile;   // cooked KTX: levels point into the mapping
+        std::vector<Level> levels;                // empty when decoding failed
+        int width;               // source size before any resampling
+        int height;
+        GLenum internalFormat;
+        GLenum format;           // uncompressed only
+        bool compressed;
+    };
+
+    struct Upload {
+        DecodedImage image;
+        int level;               // level being copied
+        int nextRow;             // first row of that level not yet copied into a PBO
+    };
+
+    struct PendingCompletion {
+        unsigned int textureID;
+        int layer;
+        int width;
+        int height;
+        CompletionCallback onComplete;
+        LayerCallback onLayerComplete;
+        GLsync fence;
+    };
+
+    struct PboSlot {
+        GLuint buffer;
+        GLsync fence;            // guards the slot until the GPU has consumed it
+    };
+
+    void workerLoop();
+    void createPlaceholder(unsigned int textureID);
+    bool loadCooked(const DecodeJob& job, DecodedImage& image);
+    void decodeLayer(const DecodeJob& job, DecodedImage& image);
+    bool acquireSlot(PboSlot*& slot);
+    void copyRows(const DecodedImage& image, int level, int firstRow, int rows, const void* data);
+    bool uploadRows(Upload& upload, size_t& budget);
+    static void notify(const CompletionCallback& onComplete, const LayerCallback& onLayerComplete,
+        unsigned int textureID, int layer, bool success, int width, int height);
+
+    // Worker side
+    std::vector<std::thread> workers;
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<DecodeJob> decodeQueue;
+    std::deque<DecodedImage> decodedQueue;
+    std::condition_variable decodedCondition;
+    std::vector<unsigned int> decodingTextures;   // one entry per job a worker holds
+    size_t jobsInFlight;
+    bool stopping;
+
+    // GL side
+    std::vector<PboSlot> pboRing;
+    unsigned int nextSlot;
+    size_t pboSize;
+    size_t uploadBudgetPerFrame;
+    size_t lastFrameUploadBytes;
+    std::deque<Upload> uploads;
+    std::vector<PendingCompletion> completions;
+};
+
+#endif
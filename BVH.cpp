@@ -0,0 +1,356 @@
+#include "BVH.h"
+#include <algorithm>
+#include <cfloat>
+
+static const int BIN_COUNT = 16;
+static const uint32_t MAX_LEAF_SIZE = 2;      // always split above this
+static const int MAX_STACK_DEPTH = 64;       // traversal stack; build stops splitting before it
+
+static float surfaceArea(const glm::vec3& minCorner, const glm::vec3& maxCorner)
+{
+    glm::vec3 extent = glm::max(maxCorner - minCorner, glm::vec3(0.0f));
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+static bool overlaps(const glm::vec3& minA, const glm::vec3& maxA, const AABB& b)
+{
+    return minA.x <= b.maxCorner.x && maxA.x >= b.minCorner.x &&
+           minA.y <= b.maxCorner.y && maxA.y >= b.minCorner.y &&
+           minA.z <= b.maxCorner.z && maxA.z >= b.minCorner.z;
+}
+
+// Slab test; returns the entry distance or FLT_MAX on a miss
+static float intersectRay(const glm::vec3& minCorner, const glm::vec3& maxCorner,
+    const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance)
+{
+    glm::vec3 t0 = (minCorner - origin) * inverseDirection;
+    glm::vec3 t1 = (maxCorner - origin) * inverseDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return entry <= exit ? entry : FLT_MAX;
+}
+
+BVH::BVH()
+{
+}
+
+void BVH::build(const std::vector<AABB>& bounds)
+{
+    nodes.clear();
+    objectIndices.resize(bounds.size());
+    slotBounds.clear();
+    if (bounds.empty())
+        return;
+
+    std::vector<glm::vec3> centroids(bounds.size());
+    for (size_t i = 0; i < bounds.size(); i++)
+    {
+        objectIndices[i] = (uint32_t)i;
+        centroids[i] = (bounds[i].minCorner + bounds[i].maxCorner) * 0.5f;
+    }
+
+    // A binary tree over n leaves has at most 2n - 1 nodes
+    nodes.reserve(bounds.size() * 2);
+    BVHNode root;
+    root.leftFirst = 0;
+    root.count = (uint32_t)bounds.size();
+    nodes.push_back(root);
+    updateLeafBounds(0, bounds);
+    subdivide(0, 0, bounds, centroids);
+
+    // Leaf slots are final now; store the boxes in that order for the queries
+    slotBounds.resize(bounds.size());
+    for (size_t i = 0; i < objectIndices.size(); i++)
+        slotBounds[i] = bounds[objectIndices[i]];
+}
+
+void BVH::refit(const std::vector<AABB>& bounds)
+{
+    for (size_t i = 0; i < objectIndices.size(); i++)
+        slotBounds[i] = bounds[objectIndices[i]];
+
+    // Children always come after their parent, so walk backwards
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        BVHNode& node = nodes[i];
+        if (node.count > 0)
+        {
+            updateLeafBounds((uint32_t)i, bounds);
+            continue;
+        }
+        const BVHNode& left = nodes[node.leftFirst];
+        const BVHNode& right = nodes[node.leftFirst + 1];
+        node.minCorner = glm::min(left.minCorner, right.minCorner);
+        node.maxCorner = glm::max(left.maxCorner, right.maxCorner);
+    }
+}
+
+void BVH::updateLeafBounds(uint32_t nodeIndex, const std::vector<AABB>& bounds)
+{
+    BVHNode& node = nodes[nodeIndex];
+    node.minCorner = glm::vec3(FLT_MAX);
+    node.maxCorner = glm::vec3(-FLT_MAX);
+    for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+    {
+        const AABB& box = bounds[objectIndices[i]];
+        node.minCorner = glm::min(node.minCorner, box.minCorner);
+        node.maxCorner = glm::max(node.maxCorner, box.maxCorner);
+    }
+}
+
+void BVH::subdivide(uint32_t nodeIndex, int depth, const std::vector<AABB>& bounds,
+    const std::vector<glm::vec3>& centroids)
+{
+    uint32_t first = nodes[nodeIndex].leftFirst;
+    uint32_t count = nodes[nodeIndex].count;
+    if (count <= MAX_LEAF_SIZE || depth >= MAX_STACK_DEPTH - 2)
+        return;
+
+    glm::vec3 centroidMin(FLT_MAX);
+    glm::vec3 centroidMax(-FLT_MAX);
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        centroidMin = glm::min(centroidMin, centroids[objectIndices[i]]);
+        centroidMax = glm::max(centroidMax, centroids[objectIndices[i]]);
+    }
+
+    // Binned SAH: cost of a split is count * area on both sides
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = FLT_MAX;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float extent = centroidMax[axis] - centroidMin[axis];
+        if (extent <= 0.0f)
+            continue;
+
+        glm::vec3 binMin[BIN_COUNT];
+        glm::vec3 binMax[BIN_COUNT];
+        uint32_t binCount[BIN_COUNT] = {};
+        for (int b = 0; b < BIN_COUNT; b++)
+        {
+            binMin[b] = glm::vec3(FLT_MAX);
+            binMax[b] = glm::vec3(-FLT_MAX);
+        }
+
+        float scale = BIN_COUNT / extent;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            uint32_t object = objectIndices[i];
+            int b = std::min(BIN_COUNT - 1, (int)((centroids[object][axis] - centroidMin[axis]) * scale));
+            binCount[b]++;
+            binMin[b] = glm::min(binMin[b], bounds[object].minCorner);
+            binMax[b] = glm::max(binMax[b], bounds[object].maxCorner);
+        }
+
+        // Sweep from the left, then from the right
+        float leftArea[BIN_COUNT - 1];
+        uint32_t leftCount[BIN_COUNT - 1];
+        glm::vec3 sweepMin(FLT_MAX);
+        glm::vec3 sweepMax(-FLT_MAX);
+        uint32_t sweepCount = 0;
+        for (int b = 0; b < BIN_COUNT - 1; b++)
+        {
+            sweepCount += binCount[b];
+            if (binCount[b] > 0)
+            {
+                sweepMin = glm::min(sweepMin, binMin[b]);
+                sweepMax = glm::max(sweepMax, binMax[b]);
+            }
+            leftCount[b] = sweepCount;
+            leftArea[b] = sweepCount > 0 ? surfaceArea(sweepMin, sweepMax) : 0.0f;
+        }
+
+        sweepMin = glm::vec3(FLT_MAX);
+        sweepMax = glm::vec3(-FLT_MAX);
+        sweepCount = 0;
+        for (int b = BIN_COUNT - 1; b > 0; b--)
+        {
+            sweepCount += binCount[b];
+            if (binCount[b] > 0)
+            {
+                sweepMin = glm::min(sweepMin, binMin[b]);
+                sweepMax = glm::max(sweepMax, binMax[b]);
+            }
+            if (sweepCount == 0 || leftCount[b - 1] == 0)
+                continue;
+
+            float cost = leftCount[b - 1] * leftArea[b - 1] + sweepCount * surfaceArea(sweepMin, sweepMax);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    BVHNode& node = nodes[nodeIndex];
+    float leafCost = count * surfaceArea(node.minCorner, node.maxCorner);
+    if (bestAxis < 0 || bestCost >= leafCost)
+        return;
+
+    // Partition the slots in place around the chosen bin boundary
+    float scale = BIN_COUNT / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+    uint32_t* begin = objectIndices.data() + first;
+    uint32_t* middle = std::partition(begin, begin + count,
+        [&](uint32_t object) {
+            int b = std::min(BIN_COUNT - 1, (int)((centroids[object][bestAxis] - centroidMin[bestAxis]) * scale));
+            return b < bestSplit;
+        });
+    uint32_t leftCountFinal = (uint32_t)(middle - begin);
+    if (leftCountFinal == 0 || leftCountFinal == count)
+        return;
+
+    uint32_t leftIndex = (uint32_t)nodes.size();
+    BVHNode left;
+    left.leftFirst = first;
+    left.count = leftCountFinal;
+    BVHNode right;
+    right.leftFirst = first + leftCountFinal;
+    right.count = count - leftCountFinal;
+    nodes.push_back(left);
+    nodes.push_back(right);
+
+    nodes[nodeIndex].leftFirst = leftIndex;
+    nodes[nodeIndex].count = 0;
+
+    updateLeafBounds(leftIndex, bounds);
+    updateLeafBounds(leftIndex + 1, bounds);
+    subdivide(leftIndex, depth + 1, bounds, centroids);
+    subdivide(leftIndex + 1, depth + 1, bounds, centroids);
+}
+
+void BVH::queryFrustum(const Frustum& frustum, std::vector<int>& objects) const
+{
+    if (nodes.empty())
+        return;
+
+    uint32_t stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const BVHNode& node = nodes[stack[--top]];
+        AABB nodeBox = { node.minCorner, node.maxCorner };
+        if (!frustum.intersects(nodeBox))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                if (frustum.intersects(slotBounds[i]))
+                    objects.push_back((int)objectIndices[i]);
+            }
+            continue;
+        }
+        stack[top++] = node.leftFirst + 1;
+        stack[top++] = node.leftFirst;
+    }
+}
+
+void BVH::queryOverlap(const AABB& box, std::vector<int>& objects) const
+{
+    if (nodes.empty())
+        return;
+
+    uint32_t stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const BVHNode& node = nodes[stack[--top]];
+        if (!overlaps(node.minCorner, node.maxCorner, box))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                if (overlaps(slotBounds[i].minCorner, slotBounds[i].maxCorner, box))
+                    objects.push_back((int)objectIndices[i]);
+            }
+            continue;
+        }
+        stack[top++] = node.leftFirst + 1;
+        stack[top++] = node.leftFirst;
+    }
+}
+
+int BVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+    float& hitDistance) const
+{
+    if (nodes.empty())
+        return -1;
+
+    // IEEE division gives +/-inf on zero components, which the slab test handles
+    glm::vec3 inverseDirection = 1.0f / direction;
+    int hitObject = -1;
+    float closest = maxDistance;
+
+    uint32_t stack[MAX_STACK_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const BVHNode& node = nodes[stack[--top]];
+        if (intersectRay(node.minCorner, node.maxCorner, origin, inverseDirection, closest) == FLT_MAX)
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; i++)
+            {
+                float distance = intersectRay(slotBounds[i].minCorner, slotBounds[i].maxCorner,
+                    origin, inverseDirection, closest);
+                if (distance < closest || (distance == closest && hitObject < 0))
+                {
+                    closest = distance;
+                    hitObject = (int)objectIndices[i];
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so the far one is usually pruned
+        const BVHNode& left = nodes[node.leftFirst];
+        const BVHNode& right = nodes[node.leftFirst + 1];
+        float leftDistance = intersectRay(left.minCorner, left.maxCorner, origin, inverseDirection, closest);
+        float rightDistance = intersectRay(right.minCorner, right.maxCorner, origin, inverseDirection, closest);
+        if (leftDistance <= rightDistance)
+        {
+            if (rightDistance != FLT_MAX)
+                stack[top++] = node.leftFirst + 1;
+            if (leftDistance != FLT_MAX)
+                stack[top++] = node.leftFirst;
+        }
+        else
+        {
+            if (leftDistance != FLT_MAX)
+                stack[top++] = node.leftFirst;
+            stack[top++] = node.leftFirst + 1;
+        }
+    }
+
+    if (hitObject >= 0)
+        hitDistance = closest;
+    return hitObject;
+}
+
+int BVH::getNodeCount() const
+{
+    return (int)nodes.size();
+}
+
+int BVH::getObjectCount() const
+{
+    return (int)objectIndices.size();
+}
+
+bool BVH::isEmpty() const
+{
+    return nodes.empty();
+}
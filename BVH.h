@@ -0,0 +1,54 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Frustum.h"
+
+// Flattened node, two per cache line. Siblings are stored next to each other,
+// so an internal node only needs the index of its left child.
+struct BVHNode {
+    glm::vec3 minCorner;
+    uint32_t leftFirst;    // internal: left child (right = left + 1); leaf: first slot
+    glm::vec3 maxCorner;
+    uint32_t count;        // objects in a leaf, 0 for internal nodes
+};
+
+static_assert(sizeof(BVHNode) == 32, "BVHNode is expected to be 32 bytes");
+
+// Bounding volume hierarchy over object AABBs, built with the binned surface
+// area heuristic. Object i is bounds[i] of the vector passed to build().
+// Objects that move keep their place in the tree: refit() only recomputes
+// the node boxes, which is enough while the motion stays local.
+class BVH
+{
+public:
+    BVH();
+
+    void build(const std::vector<AABB>& bounds);
+    void refit(const std::vector<AABB>& bounds);   // same objects as build()
+
+    void queryFrustum(const Frustum& frustum, std::vector<int>& objects) const;
+    void queryOverlap(const AABB& box, std::vector<int>& objects) const;
+
+    // Nearest object box hit along the ray, or -1. hitDistance is in units
+    // of direction's length; a ray starting inside a box hits it at 0.
+    int raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+        float& hitDistance) const;
+
+    int getNodeCount() const;
+    int getObjectCount() const;
+    bool isEmpty() const;
+
+private:
+    void subdivide(uint32_t nodeIndex, int depth, const std::vector<AABB>& bounds,
+        const std::vector<glm::vec3>& centroids);
+    void updateLeafBounds(uint32_t nodeIndex, const std::vector<AABB>& bounds);
+
+    std::vector<BVHNode> nodes;
+    std::vector<uint32_t> objectIndices;   // leaf slots -> object
+    std::vector<AABB> slotBounds;          // object boxes in leaf order
+};
+
+#endif
@@ -2,12 +2,15 @@
 #include "RenderUtils.h"
 #include "SceneConfig.h"
 #include "mesh.h"
+#include "MeshRegistry.h"
 #include <glm/gtc/matrix_transform.hpp>
 
+namespace {
+    MeshId deskMesh = Mesh::CUBE;
+    MeshId benchMesh = Mesh::CUBE;
+}
+
 void ClassroomObjects::renderClassroomStructure(
-    GLuint cubeVAO,
-    GLuint planeVAO,
-    GLuint windowVAO,
     Shader& shader,
     glm::mat4& view,
     glm::mat4& projection
@@ -20,7 +23,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // 1. Render the floor
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(0.0f, 0.0f, 0.0f),
         glm::vec3(ClassroomConfig::WIDTH, 1.0f, DEPTH),
         Colors::FLOOR_AMBIENT, Colors::FLOOR_DIFFUSE, Colors::FLOOR_SPECULAR
@@ -34,7 +37,7 @@ void ClassroomObjects::renderClassroomStructure(
     const glm::vec3 GREY_FLOOR_SPECULAR(0.2f, 0.2f, 0.2f);
 
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(ClassroomConfig::WIDTH, 0.0f, 0.0f),  // Position it adjacent to the current floor
         glm::vec3(ClassroomConfig::WIDTH, 1.0f, DEPTH),
         GREY_FLOOR_AMBIENT, GREY_FLOOR_DIFFUSE, GREY_FLOOR_SPECULAR
@@ -42,7 +45,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     //Additional grey floor in front of the classroom
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(0.0f, 0.0f, -DEPTH),  // Position it in front of the current floor
         glm::vec3(ClassroomConfig::WIDTH * 3, 1.0f, DEPTH),
         GREY_FLOOR_AMBIENT, GREY_FLOOR_DIFFUSE, GREY_FLOOR_SPECULAR
@@ -50,7 +53,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     //Additional grey floor behind the classroom
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(0.0f, 0.0f, DEPTH),  // Position it behind the current floor
         glm::vec3(ClassroomConfig::WIDTH * 3, 1.0f, DEPTH),
         GREY_FLOOR_AMBIENT, GREY_FLOOR_DIFFUSE, GREY_FLOOR_SPECULAR
@@ -59,7 +62,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     //Additional grey floor to the left of the classroom
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(-ClassroomConfig::WIDTH, 0.0f, 0.0f),  // Position it to the left of the current floor
         glm::vec3(ClassroomConfig::WIDTH, 1.0f, DEPTH),
         GREY_FLOOR_AMBIENT, GREY_FLOOR_DIFFUSE, GREY_FLOOR_SPECULAR
@@ -67,7 +70,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // 2. Render ceiling
     RenderUtils::renderPlane(
-        planeVAO, shader,
+        shader,
         glm::vec3(0.0f, ClassroomConfig::HEIGHT, 0.0f),
         glm::vec3(ClassroomConfig::WIDTH, 1.0f, DEPTH),
         Colors::CEILING_AMBIENT, Colors::CEILING_DIFFUSE, Colors::CEILING_SPECULAR,
@@ -81,7 +84,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Front wall (solid)
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(0.0f, ClassroomConfig::HEIGHT / 2.0f, frontZ),
         glm::vec3(ClassroomConfig::WIDTH, ClassroomConfig::HEIGHT, WALL_THICKNESS),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -89,7 +92,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Back wall (solid)
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(0.0f, ClassroomConfig::HEIGHT / 2.0f, -frontZ),
         glm::vec3(ClassroomConfig::WIDTH, ClassroomConfig::HEIGHT, WALL_THICKNESS),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -107,7 +110,7 @@ void ClassroomObjects::renderClassroomStructure(
         float wallDepth = (DEPTH / 2.0f) - windowFront;
         float wallCenterZ = windowFront + wallDepth / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(leftX, ClassroomConfig::HEIGHT / 2.0f, wallCenterZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT, wallDepth),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -116,7 +119,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Left wall - below window
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(leftX, (WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f) / 2.0f, centerWindowZ),
         glm::vec3(WALL_THICKNESS, WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f, WindowDimensions::WIDTH),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -126,7 +129,7 @@ void ClassroomObjects::renderClassroomStructure(
     {
         float topY = WindowDimensions::Y_POSITION + WindowDimensions::HEIGHT / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(leftX, topY + (ClassroomConfig::HEIGHT - topY) / 2.0f, centerWindowZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT - topY, WindowDimensions::WIDTH),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -138,7 +141,7 @@ void ClassroomObjects::renderClassroomStructure(
         float wallDepth = doorFront - windowBack;
         float wallCenterZ = windowBack + wallDepth / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(leftX, ClassroomConfig::HEIGHT / 2.0f, wallCenterZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT, wallDepth),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -149,7 +152,7 @@ void ClassroomObjects::renderClassroomStructure(
     {
         float topY = DoorConfig::HEIGHT;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(leftX, topY + (ClassroomConfig::HEIGHT - topY) / 2.0f, DoorConfig::Z_POSITION),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT - topY, DoorConfig::WIDTH),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -161,7 +164,7 @@ void ClassroomObjects::renderClassroomStructure(
         float wallDepth = doorBack - (-DEPTH / 2.0f);
         float wallCenterZ = -DEPTH / 2.0f + wallDepth / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(leftX, ClassroomConfig::HEIGHT / 2.0f, wallCenterZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT, wallDepth),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -174,7 +177,7 @@ void ClassroomObjects::renderClassroomStructure(
         float wallDepth = (DEPTH / 2.0f) - windowFront;
         float wallCenterZ = windowFront + wallDepth / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(rightX, ClassroomConfig::HEIGHT / 2.0f, wallCenterZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT, wallDepth),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -183,7 +186,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Right wall - below window
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(rightX, (WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f) / 2.0f, centerWindowZ),
         glm::vec3(WALL_THICKNESS, WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f, WindowDimensions::WIDTH),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -193,7 +196,7 @@ void ClassroomObjects::renderClassroomStructure(
     {
         float topY = WindowDimensions::Y_POSITION + WindowDimensions::HEIGHT / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(rightX, topY + (ClassroomConfig::HEIGHT - topY) / 2.0f, centerWindowZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT - topY, WindowDimensions::WIDTH),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -205,7 +208,7 @@ void ClassroomObjects::renderClassroomStructure(
         float wallDepth = windowBack - (-DEPTH / 2.0f);
         float wallCenterZ = -DEPTH / 2.0f + wallDepth / 2.0f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(rightX, ClassroomConfig::HEIGHT / 2.0f, wallCenterZ),
             glm::vec3(WALL_THICKNESS, ClassroomConfig::HEIGHT, wallDepth),
             Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -217,7 +220,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Left wall window
     RenderUtils::renderWindow(
-        windowVAO, shader,
+        shader,
         glm::vec3(leftX - 0.01f, WindowDimensions::Y_POSITION, 0.0f),
         glm::vec3(WindowDimensions::WIDTH, WindowDimensions::HEIGHT, 1.0f),
         Colors::WINDOW_AMBIENT, Colors::WINDOW_DIFFUSE, Colors::WINDOW_SPECULAR,
@@ -226,7 +229,7 @@ void ClassroomObjects::renderClassroomStructure(
 
     // Right wall window
     RenderUtils::renderWindow(
-        windowVAO, shader,
+        shader,
         glm::vec3(rightX + 0.01f, WindowDimensions::Y_POSITION, 0.0f),
         glm::vec3(WindowDimensions::WIDTH, WindowDimensions::HEIGHT, 1.0f),
         Colors::WINDOW_AMBIENT, Colors::WINDOW_DIFFUSE, Colors::WINDOW_SPECULAR,
@@ -236,208 +239,139 @@ void ClassroomObjects::renderClassroomStructure(
     glDepthMask(GL_TRUE);
 }
 
-void ClassroomObjects::renderDesk(
-    GLuint cubeVAO,
-    GLuint planeVAO,
-    Shader& shader,
-    glm::mat4& view,
-    glm::mat4& projection,
-    glm::vec3 position
-) {
-    using namespace DeskDimensions;
-
-    shader.use();
-    shader.setMat4("projection", projection);
-    shader.setMat4("view", view);
-
-    // Main surface
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(0.0f, HEIGHT - MAIN_THICKNESS / 2.0f, 0.0f),
-        glm::vec3(MAIN_WIDTH, MAIN_THICKNESS, MAIN_DEPTH),
-        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-    );
-
-    // Sub-surface
-    float subSurfaceY = HEIGHT - MAIN_THICKNESS - GAP - SUB_THICKNESS / 2.0f;
-    float subSurfaceZOffset = -(MAIN_DEPTH - SUB_DEPTH) / 2.0f;
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(0.0f, subSurfaceY, -subSurfaceZOffset),
-        glm::vec3(SUB_WIDTH, SUB_THICKNESS, SUB_DEPTH),
-        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-    );
-
-    // Panels
-    float frontPanelY = (HEIGHT - MAIN_THICKNESS + subSurfaceY - SUB_THICKNESS / 2.0f) / 2.0f;
-    float frontPanelHeight_calc = (HEIGHT - MAIN_THICKNESS) - (subSurfaceY - SUB_THICKNESS / 2.0f);
-
-    // Front panel
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(0.0f, frontPanelY, MAIN_DEPTH / 2.0f - PANEL_THICKNESS / 2.0f),
-        glm::vec3(MAIN_WIDTH, frontPanelHeight_calc, PANEL_THICKNESS),
-        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-    );
+static glm::mat4 boxPart(const glm::vec3& center, const glm::vec3& size)
+{
+    return glm::scale(glm::translate(glm::mat4(1.0f), center), size);
+}
 
-    // Left panel
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(-MAIN_WIDTH / 2.0f + PANEL_THICKNESS / 2.0f, frontPanelY, 0.0f),
-        glm::vec3(PANEL_THICKNESS, frontPanelHeight_calc, MAIN_DEPTH),
-        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-    );
+void ClassroomObjects::registerPrototypes()
+{
+    // Student desk around its floor centre: top, shelf, three panels, four legs
+    {
+        using namespace DeskDimensions;
+
+        float subSurfaceY = HEIGHT - MAIN_THICKNESS - GAP - SUB_THICKNESS / 2.0f;
+        float subSurfaceZOffset = -(MAIN_DEPTH - SUB_DEPTH) / 2.0f;
+        float panelY = (HEIGHT - MAIN_THICKNESS + subSurfaceY - SUB_THICKNESS / 2.0f) / 2.0f;
+        float panelHeight = (HEIGHT - MAIN_THICKNESS) - (subSurfaceY - SUB_THICKNESS / 2.0f);
+
+        float legOffsetX = MAIN_WIDTH / 2.0f - LEG_WIDTH / 2.0f;
+        float frontLegOffsetZ = MAIN_DEPTH / 2.0f - LEG_WIDTH / 2.0f;
+        float backLegOffsetZ = SUB_DEPTH / 2.0f - LEG_WIDTH * 4.0f;
+        float legHeight = subSurfaceY - SUB_THICKNESS / 2.0f;
+
+        std::vector<Mesh::PrototypePart> parts = {
+            { Mesh::CUBE, boxPart(glm::vec3(0.0f, HEIGHT - MAIN_THICKNESS / 2.0f, 0.0f),
+                glm::vec3(MAIN_WIDTH, MAIN_THICKNESS, MAIN_DEPTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(0.0f, subSurfaceY, -subSurfaceZOffset),
+                glm::vec3(SUB_WIDTH, SUB_THICKNESS, SUB_DEPTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(0.0f, panelY, MAIN_DEPTH / 2.0f - PANEL_THICKNESS / 2.0f),
+                glm::vec3(MAIN_WIDTH, panelHeight, PANEL_THICKNESS)) },
+            { Mesh::CUBE, boxPart(glm::vec3(-MAIN_WIDTH / 2.0f + PANEL_THICKNESS / 2.0f, panelY, 0.0f),
+                glm::vec3(PANEL_THICKNESS, panelHeight, MAIN_DEPTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(MAIN_WIDTH / 2.0f - PANEL_THICKNESS / 2.0f, panelY, 0.0f),
+                glm::vec3(PANEL_THICKNESS, panelHeight, MAIN_DEPTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(-legOffsetX, legHeight / 2.0f, frontLegOffsetZ),
+                glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(legOffsetX, legHeight / 2.0f, frontLegOffsetZ),
+                glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(-legOffsetX, legHeight / 2.0f, -backLegOffsetZ),
+                glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH)) },
+            { Mesh::CUBE, boxPart(glm::vec3(legOffsetX, legHeight / 2.0f, -backLegOffsetZ),
+                glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH)) },
+        };
+        deskMesh = MeshRegistry::addPrototype("DESK", parts);
+    }
 
-    // Right panel
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(MAIN_WIDTH / 2.0f - PANEL_THICKNESS / 2.0f, frontPanelY, 0.0f),
-        glm::vec3(PANEL_THICKNESS, frontPanelHeight_calc, MAIN_DEPTH),
-        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-    );
+    // Bench for one desk group around its floor centre: seat and four legs
+    {
+        using namespace BenchDimensions;
 
-    // Four legs
-    float legOffsetX = MAIN_WIDTH / 2.0f - LEG_WIDTH / 2.0f;
-    float frontlegOffsetZ = MAIN_DEPTH / 2.0f - LEG_WIDTH / 2.0f;
-    float backlegOffsetZ = SUB_DEPTH / 2.0f - LEG_WIDTH * 4.0f;
-    float legHeight = subSurfaceY - SUB_THICKNESS / 2.0f;
-
-    // Leg positions
-    glm::vec3 legPositions[4] = {
-        position + glm::vec3(-legOffsetX, legHeight / 2.0f, frontlegOffsetZ),
-        position + glm::vec3(legOffsetX, legHeight / 2.0f, frontlegOffsetZ),
-        position + glm::vec3(-legOffsetX, legHeight / 2.0f, -backlegOffsetZ),
-        position + glm::vec3(legOffsetX, legHeight / 2.0f, -backlegOffsetZ)
-    };
+        float width = benchWidth();
+        float xOffset = width / 2.0f - LEG_WIDTH / 2.0f;
+        float zOffset = DEPTH / 2.0f - LEG_WIDTH / 2.0f;
 
-    for (int i = 0; i < 4; i++) {
-        RenderUtils::renderCube(
-            cubeVAO, shader,
-            legPositions[i],
-            glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH),
-            Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
-        );
+        std::vector<Mesh::PrototypePart> parts = {
+            { Mesh::CUBE, boxPart(glm::vec3(0.0f, HEIGHT, 0.0f), glm::vec3(width, SEAT_THICKNESS, DEPTH)) },
+        };
+        for (int sx = -1; sx <= 1; sx += 2)
+        {
+            for (int sz = -1; sz <= 1; sz += 2)
+            {
+                parts.push_back({ Mesh::CUBE, boxPart(glm::vec3(sx * xOffset, HEIGHT / 2.0f, sz * zOffset),
+                    glm::vec3(LEG_WIDTH, HEIGHT, LEG_WIDTH)) });
+            }
+        }
+        benchMesh = MeshRegistry::addPrototype("BENCH", parts);
     }
 }
 
-void ClassroomObjects::renderBench(
-    GLuint cubeVAO,
+void ClassroomObjects::renderDesk(
     Shader& shader,
     glm::mat4& view,
     glm::mat4& projection,
-    glm::vec3 position,
-    float benchWidth,
-    float benchDepth,
-    float benchHeight,
-    float legWidth,
-    float legHeight
+    glm::vec3 position
 ) {
     shader.use();
     shader.setMat4("projection", projection);
     shader.setMat4("view", view);
 
-    // Bench seat
-    RenderUtils::renderCube(
-        cubeVAO, shader,
-        position + glm::vec3(0.0f, benchHeight, 0.0f),
-        glm::vec3(benchWidth, 0.1f, benchDepth),
-        Colors::BENCH_AMBIENT, Colors::BENCH_DIFFUSE, Colors::BENCH_SPECULAR
+    // Top, shelf, panels and legs are merged into the prototype
+    RenderUtils::renderPrototype(
+        shader, deskMesh, position,
+        Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
     );
-
-    // Four legs
-    float xOffset = benchWidth / 2.0f - legWidth / 2.0f;
-    float zOffset = benchDepth / 2.0f - legWidth / 2.0f;
-    float yOffset = legHeight / 2.0f;
-
-    for (int sx = -1; sx <= 1; sx += 2) {
-        for (int sz = -1; sz <= 1; sz += 2) {
-            RenderUtils::renderCube(
-                cubeVAO, shader,
-                position + glm::vec3(sx * xOffset, yOffset, sz * zOffset),
-                glm::vec3(legWidth, legHeight, legWidth),
-                Colors::BENCH_AMBIENT, Colors::BENCH_DIFFUSE, Colors::BENCH_SPECULAR
-            );
-        }
-    }
 }
 
-void ClassroomObjects::renderCeilingFan(
-    GLuint cubeVAO,
-    GLuint cylinderVAO,
+void ClassroomObjects::renderBench(
     Shader& shader,
     glm::mat4& view,
     glm::mat4& projection,
-    float currentTime,
-    bool fanOn
+    glm::vec3 position
 ) {
-    using namespace FanConfig;
-    using namespace ClassroomConfig;
-
     shader.use();
     shader.setMat4("projection", projection);
     shader.setMat4("view", view);
 
-    float fanSpeed = fanOn ? SPEED : 0.0f;
-    float rotation = currentTime * fanSpeed * 360.0f;
-
-    // Ceiling rod
-    RenderUtils::renderCylinder(
-        cylinderVAO, shader,
-        glm::vec3(0.0f, (HEIGHT + POSITION.y) / 2.0f, 0.0f),
-        glm::vec3(ProjectorConfig::MOUNT_RADIUS, ClassroomConfig::HEIGHT - POSITION.y, ProjectorConfig::MOUNT_RADIUS),
-        Colors::METAL_DARK_AMBIENT, Colors::METAL_DARK_DIFFUSE, Colors::METAL_DARK_SPECULAR
+    RenderUtils::renderPrototype(
+        shader, benchMesh, position,
+        Colors::BENCH_AMBIENT, Colors::BENCH_DIFFUSE, Colors::BENCH_SPECULAR
     );
+}
 
-    // Central disk (rotates)
-    glm::mat4 diskTransform = glm::mat4(1.0f);
-    diskTransform = glm::translate(diskTransform, POSITION);
-    diskTransform = glm::rotate(diskTransform, glm::radians(rotation), glm::vec3(0.0f, 1.0f, 0.0f));
+CeilingFanNodes ClassroomObjects::buildCeilingFan(SceneGraph& graph)
+{
+    using namespace FanConfig;
 
-    RenderUtils::renderCylinderWithMatrix(
-        cylinderVAO, shader,
-        diskTransform,
-        glm::vec3(DISK_RADIUS, DISK_HEIGHT, DISK_RADIUS),
-        Colors::METAL_LIGHT_AMBIENT, Colors::METAL_LIGHT_DIFFUSE, Colors::METAL_LIGHT_SPECULAR
-    );
+    CeilingFanNodes nodes;
+    int mount = graph.addNode(SceneGraph::NO_PARENT, glm::translate(glm::mat4(1.0f), POSITION));
+    nodes.rotor = graph.addNode(mount, glm::mat4(1.0f));
 
-    // Blades and connectors - each at different angle
     for (int i = 0; i < NUM_BLADES; i++)
     {
-        float angle = rotation + (i * 360.0f / NUM_BLADES);
+        // Arm: this blade's share of the circle
+        glm::mat4 arm = glm::rotate(glm::mat4(1.0f), glm::radians(i * 360.0f / NUM_BLADES), glm::vec3(0.0f, 1.0f, 0.0f));
+        int armNode = graph.addNode(nodes.rotor, arm);
 
-        // Connector stick - rotates with the fan
-        glm::mat4 connectorTransform = glm::mat4(1.0f);
-        connectorTransform = glm::translate(connectorTransform, POSITION);
-        connectorTransform = glm::rotate(connectorTransform, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        connectorTransform = glm::translate(connectorTransform, glm::vec3(1.2f, 0.0f, 0.0f));
-        connectorTransform = glm::rotate(connectorTransform, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        // Connector stick, lying along the arm
+        glm::mat4 connector = glm::translate(glm::mat4(1.0f), glm::vec3(1.2f, 0.0f, 0.0f));
+        connector = glm::rotate(connector, glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        nodes.connectors[i] = graph.addNode(armNode, connector);
 
-        RenderUtils::renderCylinderWithMatrix(
-            cylinderVAO, shader,
-            connectorTransform,
-            glm::vec3(0.1f, 0.5f, 0.1f),
-            glm::vec3(0.2f, 0.2f, 0.2f),
-            glm::vec3(0.35f, 0.35f, 0.35f),
-            glm::vec3(0.5f, 0.5f, 0.5f)
-        );
-
-        // Blade - rotates with the fan around Y-axis
-        glm::mat4 bladeTransform = glm::mat4(1.0f);
-        bladeTransform = glm::translate(bladeTransform, POSITION);
-        bladeTransform = glm::rotate(bladeTransform, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        bladeTransform = glm::translate(bladeTransform, glm::vec3(2.5f, 0.0f, 0.0f));
-
-        RenderUtils::renderCubeWithMatrix(
-            cubeVAO, shader,
-            bladeTransform,
-            glm::vec3(BLADE_LENGTH, BLADE_THICKNESS, BLADE_WIDTH),
-            Colors::METAL_LIGHT_AMBIENT, Colors::METAL_LIGHT_DIFFUSE, Colors::METAL_LIGHT_SPECULAR
-        );
+        // Blade
+        nodes.blades[i] = graph.addNode(armNode, glm::translate(glm::mat4(1.0f), glm::vec3(2.5f, 0.0f, 0.0f)));
     }
+    return nodes;
+}
+
+void ClassroomObjects::animateCeilingFan(SceneGraph& graph, const CeilingFanNodes& nodes, float currentTime, bool fanOn)
+{
+    float fanSpeed = fanOn ? FanConfig::SPEED : 0.0f;
+    float rotation = currentTime * fanSpeed * 360.0f;
+    graph.setLocal(nodes.rotor, glm::rotate(glm::mat4(1.0f), glm::radians(rotation), glm::vec3(0.0f, 1.0f, 0.0f)));
 }
 
 void ClassroomObjects::renderCeilingLights(
-    GLuint cubeVAO,
     Shader& lightCubeShader,
     glm::mat4& view,
     glm::mat4& projection,
@@ -452,8 +386,6 @@ void ClassroomObjects::renderCeilingLights(
     glm::vec3 lightColor = lightsOn ? glm::vec3(1.0f, 1.0f, 1.0f) : glm::vec3(0.15f, 0.15f, 0.15f);
     lightCubeShader.setVec3("lightColor", lightColor);
 
-    glBindVertexArray(cubeVAO);
-
     // Render 4 elongated light fixtures
     for (int i = 0; i < 4; i++)
     {
@@ -461,12 +393,26 @@ void ClassroomObjects::renderCeilingLights(
         model = glm::translate(model, lightPositions[i]);
         model = glm::scale(model, glm::vec3(6.0f, 0.2f, 0.5f));
         lightCubeShader.setMat4("model", model);
-        glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::CUBE));
+        MeshRegistry::draw(Mesh::CUBE);
     }
 }
 
+// Swing of a panel about its right edge; identity while closed
+static glm::mat4 hingeTransform(float width, bool isOpen)
+{
+    glm::mat4 hinge = glm::mat4(1.0f);
+    if (isOpen) {
+        // Move pivot to right edge
+        hinge = glm::translate(hinge, glm::vec3(width / 2.0f, 0.0f, 0.0f));
+        // Rotate 90 degrees clockwise (negative Y-axis rotation)
+        hinge = glm::rotate(hinge, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        // Move back
+        hinge = glm::translate(hinge, glm::vec3(-width / 2.0f, 0.0f, 0.0f));
+    }
+    return hinge;
+}
+
 void ClassroomObjects::renderFramedPanel(
-    GLuint cubeVAO,
     Shader& shader,
     const glm::mat4& view,
     const glm::mat4& projection,
@@ -476,35 +422,38 @@ void ClassroomObjects::renderFramedPanel(
     bool canRotate,
     bool isOpen
 ) {
-    shader.use();
-    shader.setMat4("projection", projection);
-    shader.setMat4("view", view);
-
-    float w = style.width;
-    float h = style.height;
-    float f = style.frameThickness;
-    float z = style.thickness + 0.1f;
-
     // Build base transformation matrix for the panel
     glm::mat4 baseTransform = glm::mat4(1.0f);
     baseTransform = glm::translate(baseTransform, position);
 
     // If this can rotate (door), rotate around the right edge
-    if (canRotate && isOpen) {
-        // Move pivot to right edge
-        baseTransform = glm::translate(baseTransform, glm::vec3(w / 2.0f, 0.0f, 0.0f));
-        // Rotate 90 degrees clockwise (negative Y-axis rotation)
-        baseTransform = glm::rotate(baseTransform, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        // Move back
-        baseTransform = glm::translate(baseTransform, glm::vec3(-w / 2.0f, 0.0f, 0.0f));
-    }
+    baseTransform = baseTransform * hingeTransform(style.width, canRotate && isOpen);
 
     // Apply initial rotation (for wall orientation)
     baseTransform = glm::rotate(baseTransform, glm::radians(rotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
 
+    renderFramedPanel(shader, view, projection, baseTransform, style);
+}
+
+void ClassroomObjects::renderFramedPanel(
+    Shader& shader,
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const glm::mat4& baseTransform,
+    const PanelStyle& style
+) {
+    shader.use();
+    shader.setMat4("projection", projection);
+    shader.setMat4("view", view);
+
+    float w = style.width;
+    float h = style.height;
+    float f = style.frameThickness;
+    float z = style.thickness + 0.1f;
+
     // Main surface
     RenderUtils::renderCubeWithMatrix(
-        cubeVAO, shader,
+        shader,
         baseTransform,
         glm::vec3(style.width, style.height, style.thickness),
         style.surfaceAmbient, style.surfaceDiffuse, style.surfaceSpecular
@@ -516,7 +465,7 @@ void ClassroomObjects::renderFramedPanel(
         m = glm::translate(m, offset);
 
         RenderUtils::renderCubeWithMatrix(
-            cubeVAO, shader,
+            shader,
             m,
             scale,
             style.frameAmbient, style.frameDiffuse, style.frameSpecular
@@ -538,7 +487,7 @@ void ClassroomObjects::renderFramedPanel(
         tray = glm::translate(tray, glm::vec3(0.0f, -h / 2 - f - style.trayOffset, 0.1f));
 
         RenderUtils::renderCubeWithMatrix(
-            cubeVAO, shader,
+            shader,
             tray,
             glm::vec3(w, style.trayHeight, style.trayDepth),
             style.frameAmbient, style.frameDiffuse, style.frameSpecular
@@ -546,9 +495,22 @@ void ClassroomObjects::renderFramedPanel(
     }
 }
 
+DoorNodes ClassroomObjects::buildDoor(SceneGraph& graph, const glm::vec3& position, float width, float rotationDegrees)
+{
+    DoorNodes nodes;
+    int frame = graph.addNode(SceneGraph::NO_PARENT, glm::translate(glm::mat4(1.0f), position));
+    nodes.hinge = graph.addNode(frame, hingeTransform(width, false));
+    nodes.panel = graph.addNode(nodes.hinge,
+        glm::rotate(glm::mat4(1.0f), glm::radians(rotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f)));
+    return nodes;
+}
+
+void ClassroomObjects::setDoorOpen(SceneGraph& graph, const DoorNodes& nodes, float width, bool isOpen)
+{
+    graph.setLocal(nodes.hinge, hingeTransform(width, isOpen));
+}
+
 void ClassroomObjects::renderProjector(
-    GLuint cubeVAO,
-    GLuint cylinderVAO,
     Shader& shader,
     glm::mat4& view,
     glm::mat4& projection,
@@ -562,7 +524,7 @@ void ClassroomObjects::renderProjector(
 
     // Ceiling mount pipe
     RenderUtils::renderCylinder(
-        cylinderVAO, shader,
+        shader,
         position + glm::vec3(0.0f, 1.5f, 0.0f),
         glm::vec3(MOUNT_RADIUS, MOUNT_LENGTH, MOUNT_RADIUS),
         Colors::METAL_DARK_AMBIENT, Colors::METAL_DARK_DIFFUSE, Colors::METAL_DARK_SPECULAR
@@ -570,7 +532,7 @@ void ClassroomObjects::renderProjector(
 
     // Main projector body
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         position,
         glm::vec3(BODY_WIDTH, BODY_HEIGHT, BODY_DEPTH),
         Colors::METAL_DARK_AMBIENT, Colors::METAL_DARK_DIFFUSE, Colors::METAL_DARK_SPECULAR
@@ -578,7 +540,7 @@ void ClassroomObjects::renderProjector(
 
     // Projector lens
     RenderUtils::renderCylinder(
-        cylinderVAO, shader,
+        shader,
         position - glm::vec3(0.0f, 0.0f, -0.5f),
         glm::vec3(LENS_RADIUS, LENS_LENGTH, LENS_RADIUS),
         Colors::LENS_AMBIENT, Colors::LENS_DIFFUSE, Colors::LENS_SPECULAR,
@@ -588,8 +550,78 @@ void ClassroomObjects::renderProjector(
 
 
 
+void ClassroomObjects::renderPoster(
+    Shader& shader,
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const glm::vec3& position,
+    const glm::vec3& scale,
+    GLuint textureID,
+    float rotationDegrees,
+    const glm::vec3& rotationAxis
+) {
+    shader.use();
+    shader.setMat4("projection", projection);
+    shader.setMat4("view", view);
+    shader.setInt("material.diffuse", 0);
+    shader.setInt("material.specular", 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    if (rotationDegrees != 0.0f) {
+        model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
+    }
+    model = glm::scale(model, scale);
+    shader.setMat4("model", model);
+    MeshRegistry::draw(Mesh::PLANE);
+}
+
+std::vector<PosterInstance> ClassroomObjects::layoutPosters(const TextureArray& posters)
+{
+    using namespace PosterConfig;
+
+    std::vector<PosterInstance> instances;
+    int count = posters.getLayerCount();
+    float totalWidth = count * WIDTH + (count - 1) * SPACING;
+    float backZ = -ClassroomConfig::DEPTH / 2.0f + ClassroomConfig::WALL_THICKNESS / 2.0f + WALL_OFFSET;
+
+    for (int i = 0; i < count; i++)
+    {
+        float x = -totalWidth / 2.0f + WIDTH / 2.0f + i * (WIDTH + SPACING);
+        float height = WIDTH / posters.getAspect(i);
+
+        // Plane lies in XZ facing +Y; stand it up to face into the room (+Z)
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, glm::vec3(x, Y_POSITION, backZ));
+        model = glm::rotate(model, glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        model = glm::scale(model, glm::vec3(WIDTH, 1.0f, height));
+
+        instances.push_back({ model, (float)i });
+    }
+    return instances;
+}
+
+void ClassroomObjects::renderPosters(
+    Shader& posterShader,
+    const glm::mat4& view,
+    const glm::mat4& projection,
+    const TextureArray& posters,
+    const PosterBatch& batch
+) {
+    posterShader.use();
+    posterShader.setMat4("projection", projection);
+    posterShader.setMat4("view", view);
+    posterShader.setInt("material.diffuse", 0);
+    posterShader.setVec3("material.specular", PosterConfig::SPECULAR);
+
+    posters.bind(GL_TEXTURE0);
+    batch.draw();
+}
+
 void ClassroomObjects::renderHallway(
-    GLuint cubeVAO,
     Shader& shader,
     glm::mat4& view,
     glm::mat4& projection
@@ -608,7 +640,7 @@ void ClassroomObjects::renderHallway(
 
     // Hallway floor
     RenderUtils::renderPlane(
-        cubeVAO, shader,
+        shader,
         glm::vec3(hallwayX, 0.0f, hallwayStartZ - LENGTH / 2.0f),
         glm::vec3(HallwayConfig::WIDTH, 1.0f, LENGTH),
         glm::vec3(0.35f, 0.35f, 0.35f),  // Darker gray for hallway floor
@@ -617,7 +649,7 @@ void ClassroomObjects::renderHallway(
     );
     // Hallway Ceiling
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(hallwayX, HallwayConfig::HEIGHT, hallwayStartZ - LENGTH / 2.0f + HallwayConfig::LENGTH / 2),
         glm::vec3(HallwayConfig::WIDTH, 1.0f, LENGTH * 2),
         Colors::CEILING_AMBIENT,
@@ -629,7 +661,7 @@ void ClassroomObjects::renderHallway(
 
     // Back wall of hallway
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(hallwayX, HallwayConfig::HEIGHT / 2.0f, hallwayStartZ - LENGTH),
         glm::vec3(HallwayConfig::WIDTH, HallwayConfig::HEIGHT, WALL_THICKNESS),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -640,7 +672,7 @@ void ClassroomObjects::renderHallway(
     // Right wall - section beyond the door
     float wallBeyondDoorLength = LENGTH - DoorConfig::WIDTH / 2.0f;
     RenderUtils::renderCube(
-        cubeVAO, shader,
+        shader,
         glm::vec3(hallwayX + HallwayConfig::WIDTH / 2.0f, HallwayConfig::HEIGHT / 2.0f, hallwayStartZ - DoorConfig::WIDTH / 2.0f - wallBeyondDoorLength / 2.0f),
         glm::vec3(WALL_THICKNESS, HallwayConfig::HEIGHT, wallBeyondDoorLength),
         Colors::WALL_AMBIENT, Colors::WALL_DIFFUSE, Colors::WALL_SPECULAR
@@ -666,7 +698,7 @@ void ClassroomObjects::renderHallway(
         float barY = railBaseY + (i * 1.5f);
 
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(railX, barY, railCenterZ),
             glm::vec3(RAIL_POST_WIDTH, RAIL_POST_WIDTH, railLength * 3 + 2.5),
             Colors::METAL_LIGHT_AMBIENT,
@@ -677,7 +709,7 @@ void ClassroomObjects::renderHallway(
     // Vertical pillar at the end of the railing
     for (int i = 0;i <= 3;i++) {
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             glm::vec3(railX,
                 HallwayConfig::HEIGHT / 2.0f,
                 startZ - 25 + i * 25), // End position in Z
@@ -690,8 +722,6 @@ void ClassroomObjects::renderHallway(
 }
     
     void ClassroomObjects::renderTeacherDesk(
-        GLuint cubeVAO,
-        GLuint planeVAO,
         Shader & shader,
         glm::mat4 & view,
         glm::mat4 & projection,
@@ -707,7 +737,7 @@ void ClassroomObjects::renderHallway(
         // 1. Main desk surface
         // Use TeacherDeskDimensions::HEIGHT to be explicit
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(0.0f, TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS / 2.0f, 0.0f),
             glm::vec3(MAIN_WIDTH, MAIN_THICKNESS, MAIN_DEPTH),
             Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
@@ -718,7 +748,7 @@ void ClassroomObjects::renderHallway(
 
         // 3. Back panel
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(0.0f, frontPanelY, -MAIN_DEPTH / 2.0f + PANEL_THICKNESS / 2.0f),
             glm::vec3(MAIN_WIDTH, TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS, PANEL_THICKNESS),
             Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
@@ -728,7 +758,7 @@ void ClassroomObjects::renderHallway(
         float leftPanelWidth = MAIN_DEPTH - DRAWER_DEPTH - 0.4f;
         float leftPanelBottomZ = -MAIN_DEPTH / 2.0f + leftPanelWidth / 2.0f + 0.2f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(-MAIN_WIDTH / 2.0f + PANEL_THICKNESS / 2.0f, frontPanelY, leftPanelBottomZ),
             glm::vec3(PANEL_THICKNESS, TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS, leftPanelWidth),
             Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
@@ -737,7 +767,7 @@ void ClassroomObjects::renderHallway(
         // 5. Left panel - above drawer section
         float aboveDrawerHeight = TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS - DRAWER_HEIGHT - 0.3f;
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(-MAIN_WIDTH / 2.0f + PANEL_THICKNESS / 2.0f, TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS - aboveDrawerHeight / 2.0f, 0.0f),
             glm::vec3(PANEL_THICKNESS, aboveDrawerHeight, DRAWER_DEPTH),
             Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
@@ -745,7 +775,7 @@ void ClassroomObjects::renderHallway(
 
         // 6. Right panel (full)
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(MAIN_WIDTH / 2.0f - PANEL_THICKNESS / 2.0f, frontPanelY, 0.0f),
             glm::vec3(PANEL_THICKNESS, TeacherDeskDimensions::HEIGHT - MAIN_THICKNESS, MAIN_DEPTH),
             Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
@@ -756,14 +786,14 @@ void ClassroomObjects::renderHallway(
         float drawerX = DRAWER_X_OFFSET;
 
         // Drawer sides (Front/Back/Left/Right)
-        RenderUtils::renderCube(cubeVAO, shader, position + glm::vec3(drawerX + DRAWER_WIDTH / 2.0f - DRAWER_THICKNESS / 2.0f, drawerY, 0.0f), glm::vec3(DRAWER_THICKNESS, DRAWER_HEIGHT, DRAWER_DEPTH), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
-        RenderUtils::renderCube(cubeVAO, shader, position + glm::vec3(drawerX - DRAWER_WIDTH / 2.0f + DRAWER_THICKNESS / 2.0f, drawerY, 0.0f), glm::vec3(DRAWER_THICKNESS, DRAWER_HEIGHT, DRAWER_DEPTH), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
-        RenderUtils::renderCube(cubeVAO, shader, position + glm::vec3(drawerX, drawerY, DRAWER_DEPTH / 2.0f - DRAWER_THICKNESS / 2.0f), glm::vec3(DRAWER_WIDTH, DRAWER_HEIGHT, DRAWER_THICKNESS), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
-        RenderUtils::renderCube(cubeVAO, shader, position + glm::vec3(drawerX, drawerY, -DRAWER_DEPTH / 2.0f + DRAWER_THICKNESS / 2.0f), glm::vec3(DRAWER_WIDTH, DRAWER_HEIGHT, DRAWER_THICKNESS), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
+        RenderUtils::renderCube(shader, position + glm::vec3(drawerX + DRAWER_WIDTH / 2.0f - DRAWER_THICKNESS / 2.0f, drawerY, 0.0f), glm::vec3(DRAWER_THICKNESS, DRAWER_HEIGHT, DRAWER_DEPTH), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
+        RenderUtils::renderCube(shader, position + glm::vec3(drawerX - DRAWER_WIDTH / 2.0f + DRAWER_THICKNESS / 2.0f, drawerY, 0.0f), glm::vec3(DRAWER_THICKNESS, DRAWER_HEIGHT, DRAWER_DEPTH), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
+        RenderUtils::renderCube(shader, position + glm::vec3(drawerX, drawerY, DRAWER_DEPTH / 2.0f - DRAWER_THICKNESS / 2.0f), glm::vec3(DRAWER_WIDTH, DRAWER_HEIGHT, DRAWER_THICKNESS), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
+        RenderUtils::renderCube(shader, position + glm::vec3(drawerX, drawerY, -DRAWER_DEPTH / 2.0f + DRAWER_THICKNESS / 2.0f), glm::vec3(DRAWER_WIDTH, DRAWER_HEIGHT, DRAWER_THICKNESS), Colors::WOOD_AMBIENT * 0.9f, Colors::WOOD_DIFFUSE * 0.9f, Colors::WOOD_SPECULAR);
 
         // 8. Drawer handle
         RenderUtils::renderCube(
-            cubeVAO, shader,
+            shader,
             position + glm::vec3(drawerX, drawerY, DRAWER_DEPTH / 2.0f - DRAWER_THICKNESS / 2.0f),
             glm::vec3(0.1f, 0.1f, 0.3f),
             Colors::METAL_DARK_AMBIENT, Colors::METAL_DARK_DIFFUSE, Colors::METAL_DARK_SPECULAR
@@ -783,10 +813,332 @@ void ClassroomObjects::renderHallway(
 
         for (int i = 0; i < 4; i++) {
             RenderUtils::renderCube(
-                cubeVAO, shader,
+                shader,
                 legPositions[i],
                 glm::vec3(LEG_WIDTH, legHeight, LEG_WIDTH),
                 Colors::WOOD_AMBIENT, Colors::WOOD_DIFFUSE, Colors::WOOD_SPECULAR
             );
         }
     }
+
+int ClassroomObjects::buildPortalGraph(PortalGraph& graph)
+{
+    using namespace ClassroomConfig;
+
+    float leftX = -WIDTH / 2.0f;
+    float rightX = WIDTH / 2.0f;
+    float halfDepth = DEPTH / 2.0f;
+
+    // Same hallway placement as renderHallway
+    float hallwayOuterX = leftX - HallwayConfig::WIDTH;
+    float hallwayStartZ = DoorConfig::Z_POSITION;
+    float hallwayEndZ = hallwayStartZ - HallwayConfig::LENGTH;
+
+    AABB outdoors = { glm::vec3(0.0f), glm::vec3(0.0f) };
+    AABB classroom = { glm::vec3(leftX, 0.0f, -halfDepth), glm::vec3(rightX, HEIGHT, halfDepth) };
+    AABB hallway = {
+        glm::vec3(hallwayOuterX, 0.0f, hallwayEndZ),
+        glm::vec3(leftX, HallwayConfig::HEIGHT, hallwayStartZ)
+    };
+
+    int outdoorsCell = graph.addCell(outdoors);
+    int classroomCell = graph.addCell(classroom);
+    int hallwayCell = graph.addCell(hallway);
+    graph.setExteriorCell(outdoorsCell);
+
+    // Door: classroom <-> hallway
+    float doorFront = DoorConfig::Z_POSITION + DoorConfig::WIDTH / 2.0f;
+    float doorBack = DoorConfig::Z_POSITION - DoorConfig::WIDTH / 2.0f;
+    int door = graph.addPortal(classroomCell, hallwayCell,
+        glm::vec3(leftX, 0.0f, doorBack),
+        glm::vec3(leftX, 0.0f, doorFront),
+        glm::vec3(leftX, DoorConfig::HEIGHT, doorFront),
+        glm::vec3(leftX, DoorConfig::HEIGHT, doorBack));
+
+    // Windows: classroom <-> outdoors, one per side wall
+    float windowBottom = WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f;
+    float windowTop = WindowDimensions::Y_POSITION + WindowDimensions::HEIGHT / 2.0f;
+    float windowHalfWidth = WindowDimensions::WIDTH / 2.0f;
+    float sideX[2] = { leftX, rightX };
+    for (int i = 0; i < 2; i++)
+    {
+        graph.addPortal(classroomCell, outdoorsCell,
+            glm::vec3(sideX[i], windowBottom, -windowHalfWidth),
+            glm::vec3(sideX[i], windowBottom, windowHalfWidth),
+            glm::vec3(sideX[i], windowTop, windowHalfWidth),
+            glm::vec3(sideX[i], windowTop, -windowHalfWidth));
+    }
+
+    // Hallway: open end towards the front, and the railing side
+    graph.addPortal(hallwayCell, outdoorsCell,
+        glm::vec3(hallwayOuterX, 0.0f, hallwayStartZ),
+        glm::vec3(leftX, 0.0f, hallwayStartZ),
+        glm::vec3(leftX, HallwayConfig::HEIGHT, hallwayStartZ),
+        glm::vec3(hallwayOuterX, HallwayConfig::HEIGHT, hallwayStartZ));
+    graph.addPortal(hallwayCell, outdoorsCell,
+        glm::vec3(hallwayOuterX, 0.0f, hallwayEndZ),
+        glm::vec3(hallwayOuterX, 0.0f, hallwayStartZ),
+        glm::vec3(hallwayOuterX, HallwayConfig::HEIGHT, hallwayStartZ),
+        glm::vec3(hallwayOuterX, HallwayConfig::HEIGHT, hallwayEndZ));
+
+    return door;
+}
+
+InteractiveObjects ClassroomObjects::populateEntities(
+    EntityWorld& world,
+    SceneObjects& objects,
+    const CeilingFanNodes& fanNodes,
+    const DoorNodes& doorNodes,
+    Shader& shader
+) {
+    using namespace FanConfig;
+
+    // Recording ignores the camera; the render functions still take one
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    float frontZ = ClassroomConfig::DEPTH / 2.0f;
+    const int NONE = EntityWorld::NONE;
+
+    InteractiveObjects interactive;
+    interactive.door = objects.add("door", true);
+    int blackboardObject = objects.add("blackboard", false);
+    int screenObject = objects.add("screen", false);
+    interactive.projector = objects.add("projector", false);
+    interactive.fan = objects.add("ceiling fan", true);
+    int teacherDeskObject = objects.add("teacher desk", false);
+
+    // Walls, floors, ceilings and windows: always submitted, left to the queue's culling
+    world.beginRecording(EntityPlacement{ NONE, NONE, OcclusionGroups::NONE });
+    renderClassroomStructure(shader, view, projection);
+    renderHallway(shader, view, projection);
+
+    // Door: between the classroom and the hallway, so in neither cell
+    PanelStyle door{
+        DoorConfig::WIDTH, DoorConfig::HEIGHT, 0.15f, 0.15f,
+        {0.2f, 0.1f, 0.05f}, {0.4f, 0.2f, 0.1f}, {0.3f, 0.15f, 0.08f},
+        {0.3f, 0.2f, 0.1f}, {0.6f, 0.4f, 0.2f}, {0.4f, 0.3f, 0.2f},
+        false
+    };
+    world.beginRecording(EntityPlacement{ interactive.door, NONE, OcclusionGroups::NONE }, doorNodes.panel);
+    renderFramedPanel(shader, view, projection, glm::mat4(1.0f), door);
+
+    // Blackboard
+    PanelStyle blackboard{
+        25.0f, 8.0f, 0.15f, 0.2f,
+        {0.3f, 0.2f, 0.1f}, {0.5f, 0.3f, 0.15f}, {0.2f, 0.15f, 0.1f},
+        {0.05f, 0.1f, 0.05f}, {0.1f, 0.2f, 0.1f}, {0.05f, 0.05f, 0.05f},
+        true
+    };
+    world.beginRecording(EntityPlacement{ blackboardObject, PortalCells::CLASSROOM, OcclusionGroups::ROOM_FIXTURES });
+    renderFramedPanel(shader, view, projection, glm::vec3(10.0f, 8.0f, frontZ - 0.2f), blackboard);
+
+    // Projection screen
+    PanelStyle screen{
+        15.0f, 9.0f, 0.05f, 0.15f,
+        {0.05f, 0.05f, 0.05f}, {0.1f, 0.1f, 0.1f}, {0.2f, 0.2f, 0.2f},
+        {0.8f, 0.8f, 0.8f}, {0.95f, 0.95f, 0.95f}, {0.3f, 0.3f, 0.3f},
+        false
+    };
+    world.beginRecording(EntityPlacement{ screenObject, PortalCells::CLASSROOM, OcclusionGroups::ROOM_FIXTURES });
+    renderFramedPanel(shader, view, projection, glm::vec3(-12.0f, 8.0f, frontZ - 0.2f), screen);
+
+    // Projector
+    world.beginRecording(EntityPlacement{ interactive.projector, PortalCells::CLASSROOM, OcclusionGroups::ROOM_FIXTURES });
+    renderProjector(shader, view, projection, glm::vec3(-10.0f, 12.0f, frontZ - 20.0f));
+
+    // Ceiling fan: the rod is fixed, everything else hangs off a graph node
+    EntityPlacement fan{ interactive.fan, PortalCells::CLASSROOM, OcclusionGroups::ROOM_FIXTURES };
+    world.beginRecording(fan);
+    RenderUtils::renderCylinder(
+        shader,
+        glm::vec3(0.0f, (ClassroomConfig::HEIGHT + POSITION.y) / 2.0f, 0.0f),
+        glm::vec3(ProjectorConfig::MOUNT_RADIUS, ClassroomConfig::HEIGHT - POSITION.y, ProjectorConfig::MOUNT_RADIUS),
+        Colors::METAL_DARK_AMBIENT, Colors::METAL_DARK_DIFFUSE, Colors::METAL_DARK_SPECULAR
+    );
+
+    world.beginRecording(fan, fanNodes.rotor);
+    RenderUtils::renderCylinderWithMatrix(
+        shader,
+        glm::mat4(1.0f),
+        glm::vec3(DISK_RADIUS, DISK_HEIGHT, DISK_RADIUS),
+        Colors::METAL_LIGHT_AMBIENT, Colors::METAL_LIGHT_DIFFUSE, Colors::METAL_LIGHT_SPECULAR
+    );
+
+    for (int i = 0; i < NUM_BLADES; i++)
+    {
+        world.beginRecording(fan, fanNodes.connectors[i]);
+        RenderUtils::renderCylinderWithMatrix(
+            shader,
+            glm::mat4(1.0f),
+            glm::vec3(0.1f, 0.5f, 0.1f),
+            glm::vec3(0.2f, 0.2f, 0.2f),
+            glm::vec3(0.35f, 0.35f, 0.35f),
+            glm::vec3(0.5f, 0.5f, 0.5f)
+        );
+
+        world.beginRecording(fan, fanNodes.blades[i]);
+        RenderUtils::renderCubeWithMatrix(
+            shader,
+            glm::mat4(1.0f),
+            glm::vec3(BLADE_LENGTH, BLADE_THICKNESS, BLADE_WIDTH),
+            Colors::METAL_LIGHT_AMBIENT, Colors::METAL_LIGHT_DIFFUSE, Colors::METAL_LIGHT_SPECULAR
+        );
+    }
+
+    // Desks and benches: one object each, one occlusion group per row
+    for (int row = 0; row < DeskLayout::NUM_ROWS; row++)
+    {
+        int group = OcclusionGroups::FIRST_DESK_ROW + row;
+        for (int col = 0; col < DeskLayout::NUM_COLS; col++)
+        {
+            world.beginRecording(EntityPlacement{ objects.add("bench", false), PortalCells::CLASSROOM, group });
+            renderBench(shader, view, projection, benchPosition(row, col));
+
+            for (int i = 0; i < DeskLayout::NUM_DESKS_PER_GROUP; i++)
+            {
+                world.beginRecording(EntityPlacement{ objects.add("desk", false), PortalCells::CLASSROOM, group });
+                renderDesk(shader, view, projection, deskPosition(row, col, i));
+            }
+        }
+    }
+
+    // Teacher's desk
+    world.beginRecording(EntityPlacement{ teacherDeskObject, PortalCells::CLASSROOM, OcclusionGroups::ROOM_FIXTURES });
+    renderTeacherDesk(shader, view, projection, teacherDeskPosition());
+
+    world.endRecording();
+    return interactive;
+}
+
+glm::vec3 ClassroomObjects::deskPosition(int row, int col, int desk)
+{
+    using namespace DeskLayout;
+
+    float deskStride = DeskDimensions::MAIN_WIDTH + PAIR_SPACING;
+    return glm::vec3(
+        START_X + col * (benchWidth() + COL_SPACING) + desk * deskStride,
+        0.0f,
+        START_Z + row * ROW_SPACING
+    );
+}
+
+glm::vec3 ClassroomObjects::benchPosition(int row, int col)
+{
+    using namespace DeskLayout;
+
+    // Centered under the column's desks, half a row behind them
+    float deskStride = DeskDimensions::MAIN_WIDTH + PAIR_SPACING;
+    return glm::vec3(
+        START_X + col * (benchWidth() + COL_SPACING) + (benchWidth() - PAIR_SPACING) / 2.0f - deskStride / 2.0f,
+        0.0f,
+        START_Z + row * ROW_SPACING - ROW_SPACING / 2.0f
+    );
+}
+
+float ClassroomObjects::benchWidth()
+{
+    return DeskLayout::NUM_DESKS_PER_GROUP * (DeskDimensions::MAIN_WIDTH + DeskLayout::PAIR_SPACING);
+}
+
+glm::vec3 ClassroomObjects::teacherDeskPosition()
+{
+    return glm::vec3(-15.0f, 0.0f, ClassroomConfig::DEPTH / 2.0f - 5.0f);  // Center front
+}
+
+static AABB centeredBox(const glm::vec3& center, const glm::vec3& size)
+{
+    AABB box = { center - size * 0.5f, center + size * 0.5f };
+    return box;
+}
+
+void ClassroomObjects::buildWallColliders(std::vector<AABB>& colliders)
+{
+    using namespace ClassroomConfig;
+
+    float leftX = -WIDTH / 2.0f;
+    float rightX = WIDTH / 2.0f;
+    float halfDepth = DEPTH / 2.0f;
+    float halfWall = WALL_THICKNESS / 2.0f;
+
+    // Front and back walls
+    colliders.push_back(centeredBox(glm::vec3(0.0f, HEIGHT / 2.0f, halfDepth), glm::vec3(WIDTH, HEIGHT, WALL_THICKNESS)));
+    colliders.push_back(centeredBox(glm::vec3(0.0f, HEIGHT / 2.0f, -halfDepth), glm::vec3(WIDTH, HEIGHT, WALL_THICKNESS)));
+
+    // Side walls around the window (both sides) and the door (left side), as in renderClassroomStructure
+    float windowFront = WindowDimensions::WIDTH / 2.0f;
+    float windowBack = -WindowDimensions::WIDTH / 2.0f;
+    float windowBottom = WindowDimensions::Y_POSITION - WindowDimensions::HEIGHT / 2.0f;
+    float windowTop = WindowDimensions::Y_POSITION + WindowDimensions::HEIGHT / 2.0f;
+    float doorFront = DoorConfig::Z_POSITION + DoorConfig::WIDTH / 2.0f;
+    float doorBack = DoorConfig::Z_POSITION - DoorConfig::WIDTH / 2.0f;
+
+    float sideX[2] = { leftX, rightX };
+    for (int i = 0; i < 2; i++)
+    {
+        float x0 = sideX[i] - halfWall;
+        float x1 = sideX[i] + halfWall;
+        colliders.push_back({ glm::vec3(x0, 0.0f, windowFront), glm::vec3(x1, HEIGHT, halfDepth) });
+        colliders.push_back({ glm::vec3(x0, 0.0f, windowBack), glm::vec3(x1, windowBottom, windowFront) });
+        colliders.push_back({ glm::vec3(x0, windowTop, windowBack), glm::vec3(x1, HEIGHT, windowFront) });
+    }
+    colliders.push_back({ glm::vec3(leftX - halfWall, 0.0f, doorFront), glm::vec3(leftX + halfWall, HEIGHT, windowBack) });
+    colliders.push_back({ glm::vec3(leftX - halfWall, DoorConfig::HEIGHT, doorBack), glm::vec3(leftX + halfWall, HEIGHT, doorFront) });
+    colliders.push_back({ glm::vec3(leftX - halfWall, 0.0f, -halfDepth), glm::vec3(leftX + halfWall, HEIGHT, doorBack) });
+    colliders.push_back({ glm::vec3(rightX - halfWall, 0.0f, -halfDepth), glm::vec3(rightX + halfWall, HEIGHT, windowBack) });
+
+    // Hallway back wall, its wall beyond the door, and the railing (as in renderHallway)
+    float hallwayX = leftX - HallwayConfig::WIDTH / 2.0f;
+    float hallwayStartZ = DoorConfig::Z_POSITION;
+    float hallwayEndZ = hallwayStartZ - HallwayConfig::LENGTH;
+    colliders.push_back(centeredBox(
+        glm::vec3(hallwayX, HallwayConfig::HEIGHT / 2.0f, hallwayEndZ),
+        glm::vec3(HallwayConfig::WIDTH, HallwayConfig::HEIGHT, WALL_THICKNESS)));
+    colliders.push_back({
+        glm::vec3(leftX - halfWall, 0.0f, hallwayEndZ),
+        glm::vec3(leftX + halfWall, HallwayConfig::HEIGHT, doorBack) });
+
+    // The rail's four bars are closer together than the capsule is tall: one box
+    float railX = hallwayX - HallwayConfig::WIDTH / 2.0f + WALL_THICKNESS + HallwayConfig::RAIL_POST_WIDTH;
+    float railStartZ = hallwayStartZ - 0.5f;
+    float railLength = (HallwayConfig::LENGTH - 1.0f) * 3.0f + 2.5f;
+    float railCenterZ = railStartZ - (HallwayConfig::LENGTH - 1.0f) / 2.0f;
+    colliders.push_back(centeredBox(
+        glm::vec3(railX, 4.5f / 2.0f, railCenterZ),
+        glm::vec3(HallwayConfig::RAIL_POST_WIDTH, 4.5f + HallwayConfig::RAIL_POST_WIDTH, railLength)));
+    for (int i = 0; i <= 3; i++)
+    {
+        colliders.push_back(centeredBox(
+            glm::vec3(railX, HallwayConfig::HEIGHT / 2.0f, railStartZ - 25.0f + i * 25.0f),
+            glm::vec3(0.2f, HallwayConfig::HEIGHT, 0.5f)));
+    }
+}
+
+void ClassroomObjects::buildColliders(std::vector<AABB>& colliders)
+{
+    buildWallColliders(colliders);
+
+    // Desks and benches, as solid blocks
+    for (int row = 0; row < DeskLayout::NUM_ROWS; row++)
+    {
+        for (int col = 0; col < DeskLayout::NUM_COLS; col++)
+        {
+            glm::vec3 bench = benchPosition(row, col);
+            colliders.push_back({
+                bench - glm::vec3(benchWidth() / 2.0f, 0.0f, BenchDimensions::DEPTH / 2.0f),
+                bench + glm::vec3(benchWidth() / 2.0f, BenchDimensions::HEIGHT + 0.05f, BenchDimensions::DEPTH / 2.0f) });
+
+            for (int i = 0; i < DeskLayout::NUM_DESKS_PER_GROUP; i++)
+            {
+                glm::vec3 desk = deskPosition(row, col, i);
+                colliders.push_back({
+                    desk - glm::vec3(DeskDimensions::MAIN_WIDTH / 2.0f, 0.0f, DeskDimensions::MAIN_DEPTH / 2.0f),
+                    desk + glm::vec3(DeskDimensions::MAIN_WIDTH / 2.0f, DeskDimensions::HEIGHT, DeskDimensions::MAIN_DEPTH / 2.0f) });
+            }
+        }
+    }
+
+    glm::vec3 teacherDesk = teacherDeskPosition();
+    colliders.push_back({
+        teacherDesk - glm::vec3(TeacherDeskDimensions::MAIN_WIDTH / 2.0f, 0.0f, TeacherDeskDimensions::MAIN_DEPTH / 2.0f),
+        teacherDesk + glm::vec3(TeacherDeskDimensions::MAIN_WIDTH / 2.0f, TeacherDeskDimensions::HEIGHT, TeacherDeskDimensions::MAIN_DEPTH / 2.0f) });
+}
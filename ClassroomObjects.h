@@ -3,7 +3,15 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <vector>
 #include "shader.h"
+#include "PosterBatch.h"
+#include "TextureArray.h"
+#include "PortalGraph.h"
+#include "SceneConfig.h"
+#include "SceneGraph.h"
+#include "SceneObjects.h"
+#include "EntityWorld.h"
 
 // Panel Style Structure
 struct PanelStyle {
@@ -23,57 +31,63 @@ struct PanelStyle {
     float trayOffset = 0.15f;
 };
 
+// Scene graph nodes of the ceiling fan: the rotor spins, and each blade and
+// its connector hang off a fixed arm under it
+struct CeilingFanNodes {
+    int rotor;
+    int connectors[FanConfig::NUM_BLADES];
+    int blades[FanConfig::NUM_BLADES];
+};
+
+// Scene graph nodes of the door: the hinge swings, the panel is drawn
+struct DoorNodes {
+    int hinge;
+    int panel;
+};
+
+// SceneObjects ids of the objects that react to a click
+struct InteractiveObjects {
+    int door;
+    int fan;
+    int projector;
+};
+
 // Classroom object rendering class
 class ClassroomObjects {
 public:
     // Render the main classroom structure (walls, floor, ceiling, windows)
     static void renderClassroomStructure(
-        GLuint cubeVAO,
-        GLuint planeVAO,
-        GLuint windowVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection
     );
 
-    // Render a single desk
+    // Desk and bench prototype meshes. Call once, before MeshRegistry::init().
+    static void registerPrototypes();
+
+    // Render a single desk: one desk prototype instance
     static void renderDesk(
-        GLuint cubeVAO,
-        GLuint planeVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection,
         glm::vec3 position
     );
 
-    // Render a bench
+    // Render a bench spanning one desk group: one bench prototype instance
     static void renderBench(
-        GLuint cubeVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection,
-        glm::vec3 position,
-        float benchWidth,
-        float benchDepth,
-        float benchHeight,
-        float legWidth,
-        float legHeight
+        glm::vec3 position
     );
 
-    // Render ceiling fan
-    static void renderCeilingFan(
-        GLuint cubeVAO,
-        GLuint cylinderVAO,
-        Shader& shader,
-        glm::mat4& view,
-        glm::mat4& projection,
-        float currentTime,
-        bool fanOn
-    );
+    // Ceiling fan: build its nodes once, then set the rotor angle before
+    // SceneGraph::update(); its entities follow the nodes
+    static CeilingFanNodes buildCeilingFan(SceneGraph& graph);
+    static void animateCeilingFan(SceneGraph& graph, const CeilingFanNodes& nodes, float currentTime, bool fanOn);
 
     // Render ceiling lights
     static void renderCeilingLights(
-        GLuint cubeVAO,
         Shader& lightCubeShader,
         glm::mat4& view,
         glm::mat4& projection,
@@ -83,7 +97,6 @@ public:
 
     // Render framed panel (blackboard, screen, door)
     static void renderFramedPanel(
-        GLuint cubeVAO,
         Shader& shader,
         const glm::mat4& view,
         const glm::mat4& projection,
@@ -94,10 +107,21 @@ public:
         bool isOpen = false
     );
 
+    // Render framed panel placed by an existing transform (the door's scene graph node)
+    static void renderFramedPanel(
+        Shader& shader,
+        const glm::mat4& view,
+        const glm::mat4& projection,
+        const glm::mat4& baseTransform,
+        const PanelStyle& style
+    );
+
+    // Door swinging around its right edge (seen from the panel's front)
+    static DoorNodes buildDoor(SceneGraph& graph, const glm::vec3& position, float width, float rotationDegrees);
+    static void setDoorOpen(SceneGraph& graph, const DoorNodes& nodes, float width, bool isOpen);
+
     // Render projector
     static void renderProjector(
-        GLuint cubeVAO,
-        GLuint cylinderVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection,
@@ -106,7 +130,6 @@ public:
 
     // Render poster (textured plane on wall)
     static void renderPoster(
-        GLuint planeVAO,
         Shader& shader,
         const glm::mat4& view,
         const glm::mat4& projection,
@@ -116,20 +139,59 @@ public:
         float rotationDegrees = 0.0f,
         const glm::vec3& rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f)
     );
+
+    // Place one poster per texture-array layer along the back wall
+    static std::vector<PosterInstance> layoutPosters(const TextureArray& posters);
+
+    // Render every poster in a single instanced draw (texture-array shader)
+    static void renderPosters(
+        Shader& posterShader,
+        const glm::mat4& view,
+        const glm::mat4& projection,
+        const TextureArray& posters,
+        const PosterBatch& batch
+    );
+
     static void renderTeacherDesk(
-        GLuint cubeVAO,
-        GLuint planeVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection,
         glm::vec3 position
     );
     static void renderHallway(
-        GLuint cubeVAO,
         Shader& shader,
         glm::mat4& view,
         glm::mat4& projection
     );
+
+    // Add the PortalCells and the openings between them (door, windows, the
+    // hallway's open end and railing side). Returns the door portal.
+    static int buildPortalGraph(PortalGraph& graph);
+
+    // Register the scene objects and record every static and animated part of
+    // the classroom and hallway into the world, once at load. Posters, the
+    // ceiling lights and the sun use their own shaders and are drawn directly.
+    static InteractiveObjects populateEntities(
+        EntityWorld& world,
+        SceneObjects& objects,
+        const CeilingFanNodes& fanNodes,
+        const DoorNodes& doorNodes,
+        Shader& shader
+    );
+
+    // Desk layout, shared by the entities and the colliders
+    static glm::vec3 deskPosition(int row, int col, int desk);
+    static glm::vec3 benchPosition(int row, int col);
+    static float benchWidth();
+    static glm::vec3 teacherDeskPosition();
+
+    // Static boxes the camera collides with: classroom and hallway walls
+    // (leaving the door and window openings free), the railing, desks and
+    // benches. Floors and ceilings are left out; the camera flies.
+    static void buildColliders(std::vector<AABB>& colliders);
+
+    // The walls and railing alone, which also stop pick rays
+    static void buildWallColliders(std::vector<AABB>& colliders);
 };
 
 
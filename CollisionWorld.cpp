@@ -0,0 +1,192 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// A slide along one face can run into a second and then a third (a corner)
+static const int MAX_SLIDES = 3;
+
+// Distance kept from a face after a hit, so rounding never starts the next
+// sweep inside the box (which would then be ignored)
+static const float SKIN = 0.001f;
+
+// Entry time in [0, 1] of origin + t * motion into the box, and the axis of
+// the face it enters through. A start inside the box is not a hit.
+static bool sweepBox(const AABB& box, const glm::vec3& origin, const glm::vec3& motion,
+    float& entryTime, int& entryAxis)
+{
+    float enter = -std::numeric_limits<float>::max();
+    float exit = std::numeric_limits<float>::max();
+    int axis = -1;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (motion[i] == 0.0f)
+        {
+            if (origin[i] <= box.minCorner[i] || origin[i] >= box.maxCorner[i])
+                return false;
+            continue;
+        }
+
+        float t0 = (box.minCorner[i] - origin[i]) / motion[i];
+        float t1 = (box.maxCorner[i] - origin[i]) / motion[i];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        if (t0 > enter)
+        {
+            enter = t0;
+            axis = i;
+        }
+        exit = std::min(exit, t1);
+    }
+
+    if (axis < 0 || enter >= exit || enter < 0.0f || enter > 1.0f)
+        return false;
+    entryTime = enter;
+    entryAxis = axis;
+    return true;
+}
+
+CollisionWorld::CollisionWorld(float radius, float height, float cellSize)
+    : radius(radius), height(height), cellSize(cellSize), queryStamp(0), lastCandidateCount(0)
+{
+}
+
+void CollisionWorld::build(const std::vector<AABB>& boxes)
+{
+    grownBoxes.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        grownBoxes[i].minCorner = boxes[i].minCorner - glm::vec3(radius);
+        grownBoxes[i].maxCorner = boxes[i].maxCorner + glm::vec3(radius, radius + height, radius);
+    }
+
+    // (cell, box) pairs sorted by cell, so each cell's boxes end up contiguous
+    std::vector<std::pair<uint64_t, uint32_t>> pairs;
+    for (size_t i = 0; i < grownBoxes.size(); i++)
+    {
+        int x0 = (int)std::floor(grownBoxes[i].minCorner.x / cellSize);
+        int x1 = (int)std::floor(grownBoxes[i].maxCorner.x / cellSize);
+        int z0 = (int)std::floor(grownBoxes[i].minCorner.z / cellSize);
+        int z1 = (int)std::floor(grownBoxes[i].maxCorner.z / cellSize);
+        for (int x = x0; x <= x1; x++)
+        {
+            for (int z = z0; z <= z1; z++)
+                pairs.push_back(std::make_pair(cellKey(x, z), (uint32_t)i));
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    cells.clear();
+    cellEntries.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        cellEntries[i] = pairs[i].second;
+        if (i == 0 || pairs[i].first != pairs[i - 1].first)
+            cells[pairs[i].first] = CellRange{ (uint32_t)i, 0 };
+        cells[pairs[i].first].count++;
+    }
+
+    visitStamps.assign(grownBoxes.size(), 0);
+    queryStamp = 0;
+}
+
+glm::vec3 CollisionWorld::moveCapsule(const glm::vec3& eye, const glm::vec3& motion)
+{
+    glm::vec3 position = eye;
+    glm::vec3 remaining = motion;
+    lastCandidateCount = 0;
+
+    for (int slide = 0; slide < MAX_SLIDES; slide++)
+    {
+        if (glm::dot(remaining, remaining) < 1e-12f)
+            break;
+
+        gatherCandidates(position, position + remaining);
+        lastCandidateCount += (int)candidates.size();
+
+        float hitTime = 1.0f;
+        int hitAxis = -1;
+        int hitBox = -1;
+        for (uint32_t index : candidates)
+        {
+            float time;
+            int axis;
+            if (sweepBox(grownBoxes[index], position, remaining, time, axis) && time < hitTime)
+            {
+                hitTime = time;
+                hitAxis = axis;
+                hitBox = (int)index;
+            }
+        }
+
+        if (hitBox < 0)
+        {
+            position += remaining;
+            break;
+        }
+
+        // Stop on the face, then keep only the motion along it
+        const AABB& box = grownBoxes[hitBox];
+        position += remaining * hitTime;
+        position[hitAxis] = remaining[hitAxis] > 0.0f
+            ? box.minCorner[hitAxis] - SKIN
+            : box.maxCorner[hitAxis] + SKIN;
+        remaining *= 1.0f - hitTime;
+        remaining[hitAxis] = 0.0f;
+    }
+    return position;
+}
+
+void CollisionWorld::gatherCandidates(const glm::vec3& from, const glm::vec3& to)
+{
+    candidates.clear();
+    if (++queryStamp == 0)
+    {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        queryStamp = 1;
+    }
+
+    int x0 = (int)std::floor(std::min(from.x, to.x) / cellSize);
+    int x1 = (int)std::floor(std::max(from.x, to.x) / cellSize);
+    int z0 = (int)std::floor(std::min(from.z, to.z) / cellSize);
+    int z1 = (int)std::floor(std::max(from.z, to.z) / cellSize);
+    for (int x = x0; x <= x1; x++)
+    {
+        for (int z = z0; z <= z1; z++)
+        {
+            auto cell = cells.find(cellKey(x, z));
+            if (cell == cells.end())
+                continue;
+
+            for (uint32_t i = 0; i < cell->second.count; i++)
+            {
+                uint32_t index = cellEntries[cell->second.first + i];
+                if (visitStamps[index] == queryStamp)
+                    continue;
+                visitStamps[index] = queryStamp;
+                candidates.push_back(index);
+            }
+        }
+    }
+}
+
+uint64_t CollisionWorld::cellKey(int x, int z) const
+{
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)z;
+}
+
+int CollisionWorld::getBoxCount() const
+{
+    return (int)grownBoxes.size();
+}
+
+int CollisionWorld::getCellCount() const
+{
+    return (int)cells.size();
+}
+
+int CollisionWorld::getLastCandidateCount() const
+{
+    return lastCandidateCount;
+}
@@ -0,0 +1,55 @@
+#ifndef COLLISION_WORLD_H
+#define COLLISION_WORLD_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Frustum.h"
+
+// Static collision boxes (walls, desks, benches) in a uniform grid on x/z,
+// stored as a spatial hash so only occupied cells cost memory. The grid is
+// built once; a move only looks at the boxes in the cells its sweep covers.
+// The mover is a vertical capsule hanging below a point (the camera's eye).
+// Its Minkowski sum with a box is approximated by the box grown by the radius
+// on every side and by the capsule height downwards, which turns the capsule
+// sweep into a ray cast against grown boxes. The rounded edges are treated
+// as square corners, so the camera stops up to (sqrt(2) - 1) * radius early
+// when it meets a box edge-on.
+class CollisionWorld
+{
+public:
+    CollisionWorld(float radius, float height, float cellSize);
+
+    void build(const std::vector<AABB>& boxes);
+
+    // Moves the capsule by motion, sliding along anything it hits. Boxes the
+    // capsule already overlaps are ignored so it can always move out of them.
+    glm::vec3 moveCapsule(const glm::vec3& eye, const glm::vec3& motion);
+
+    int getBoxCount() const;
+    int getCellCount() const;
+    int getLastCandidateCount() const;    // boxes tested by the last move
+
+private:
+    struct CellRange {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    void gatherCandidates(const glm::vec3& from, const glm::vec3& to);
+    uint64_t cellKey(int x, int z) const;
+
+    float radius;
+    float height;
+    float cellSize;
+    std::vector<AABB> grownBoxes;                  // boxes after the capsule expansion
+    std::unordered_map<uint64_t, CellRange> cells;
+    std::vector<uint32_t> cellEntries;             // box indices, grouped by cell
+    std::vector<uint32_t> visitStamps;             // per box: last query that saw it
+    std::vector<uint32_t> candidates;
+    uint32_t queryStamp;
+    int lastCandidateCount;
+};
+
+#endif
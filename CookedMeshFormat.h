@@ -0,0 +1,107 @@
+#ifndef COOKED_MESH_FORMAT_H
+#define COOKED_MESH_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+// Binary model container written by Tools/ModelCooker and memory-mapped by
+// CookedModel. Everything is stored the way the renderer consumes it:
+// vertices already in the VertexFormat.h encoding, 32-bit indices in
+// meshlet order, materials as the ambient/diffuse/specular model. Loading
+// is a header check and two buffer uploads straight from the mapping.
+//
+// Layout, each section 4-byte aligned and in this order:
+//   Header
+//   Material[materialCount]
+//   Submesh[submeshCount]
+//   Meshlet[meshletCount]
+//   vertexCount * vertexSize bytes of vertices
+//   uint32_t[indexCount]
+namespace CookedMeshFormat {
+    const unsigned char MAGIC[4] = { 'C', 'M', 'S', 'H' };
+    const uint32_t VERSION = 2;              // 2: snorm16 positions over positionScale
+
+    struct Header {
+        unsigned char magic[4];
+        uint32_t version;
+        uint32_t vertexSize;         // Must match VertexFormat::VERTEX_SIZE at load
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t materialCount;
+        uint32_t submeshCount;
+        uint32_t meshletCount;
+        float boundsMin[3];          // Object space, whole model
+        float boundsMax[3];
+        float positionScale;         // VertexFormat::positionScale of the bounds
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Header) == 64, "Cooked mesh header must be 64 bytes");
+
+    struct Material {
+        float ambient[3];
+        float diffuse[3];
+        float specular[3];
+        float alpha;
+        float shininess;
+    };
+    static_assert(sizeof(Material) == 44, "Cooked material must be tightly packed");
+
+    // Triangles sharing one material: an index range cut into meshlets
+    struct Submesh {
+        uint32_t material;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t firstMeshlet;
+        uint32_t meshletCount;
+    };
+    static_assert(sizeof(Submesh) == 20, "Cooked submesh must be tightly packed");
+
+    // Mirrors ::Meshlet (MeshletMesh.h) with plain floats; firstIndex is
+    // relative to the whole index section
+    struct Meshlet {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t vertexCount;
+        float sphere[4];             // center, radius
+        float boundsMin[3];
+        float boundsMax[3];
+        float coneApex[3];
+        float coneAxis[3];
+        float coneCutoff;
+    };
+    static_assert(sizeof(Meshlet) == 80, "Cooked meshlet must be tightly packed");
+
+    // Byte offsets of each section, from the header counts
+    struct Layout {
+        uint64_t materials;
+        uint64_t submeshes;
+        uint64_t meshlets;
+        uint64_t vertices;
+        uint64_t indices;
+        uint64_t totalSize;
+    };
+
+    inline uint64_t padToFour(uint64_t size)
+    {
+        return (size + 3u) & ~(uint64_t)3u;
+    }
+
+    inline Layout computeLayout(const Header& header)
+    {
+        Layout layout;
+        layout.materials = sizeof(Header);
+        layout.submeshes = layout.materials + (uint64_t)header.materialCount * sizeof(Material);
+        layout.meshlets = layout.submeshes + (uint64_t)header.submeshCount * sizeof(Submesh);
+        layout.vertices = layout.meshlets + (uint64_t)header.meshletCount * sizeof(Meshlet);
+        layout.indices = padToFour(layout.vertices + (uint64_t)header.vertexCount * header.vertexSize);
+        layout.totalSize = layout.indices + (uint64_t)header.indexCount * sizeof(uint32_t);
+        return layout;
+    }
+
+    inline bool isValidMagic(const Header& header)
+    {
+        return memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0;
+    }
+}
+
+#endif
@@ -0,0 +1,261 @@
+#include "CookedModel.h"
+#include "CookedMeshFormat.h"
+#include "MappedFile.h"
+#include "MeshArena.h"
+#include "VertexFormat.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+    glm::vec3 toVec3(const float* values)
+    {
+        return glm::vec3(values[0], values[1], values[2]);
+    }
+}
+
+CookedModel::CookedModel()
+    : vao(0), vertexBuffer(0), indexBuffer(0),
+      bounds{ glm::vec3(0.0f), glm::vec3(0.0f) }, positionScale(1.0f), lastDrawCount(0), lastVisibleMeshletCount(0)
+{
+}
+
+CookedModel::~CookedModel()
+{
+    release();
+}
+
+bool CookedModel::load(const char* path)
+{
+    release();
+
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+
+    CookedMeshFormat::Header header;
+    if (file.size() < sizeof(header))
+    {
+        std::cout << "Invalid cooked mesh: " << path << std::endl;
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if (!CookedMeshFormat::isValidMagic(header) || header.version != CookedMeshFormat::VERSION ||
+        !(header.positionScale > 0.0f))
+    {
+        std::cout << "Invalid cooked mesh: " << path << std::endl;
+        return false;
+    }
+    if (header.vertexSize != (uint32_t)VertexFormat::VERTEX_SIZE)
+    {
+        std::cout << "Cooked mesh has " << header.vertexSize << "-byte vertices, this build uses "
+            << VertexFormat::VERTEX_SIZE << " (recook it): " << path << std::endl;
+        return false;
+    }
+
+    CookedMeshFormat::Layout layout = CookedMeshFormat::computeLayout(header);
+    if (layout.totalSize > file.size())
+    {
+        std::cout << "Truncated cooked mesh: " << path << std::endl;
+        return false;
+    }
+
+    const unsigned char* data = file.data();
+    std::vector<CookedMeshFormat::Submesh> cookedSubmeshes(header.submeshCount);
+    std::vector<CookedMeshFormat::Meshlet> cookedMeshlets(header.meshletCount);
+    if (header.submeshCount > 0)
+        memcpy(cookedSubmeshes.data(), data + layout.submeshes, header.submeshCount * sizeof(CookedMeshFormat::Submesh));
+    if (header.meshletCount > 0)
+        memcpy(cookedMeshlets.data(), data + layout.meshlets, header.meshletCount * sizeof(CookedMeshFormat::Meshlet));
+
+    for (const CookedMeshFormat::Submesh& cooked : cookedSubmeshes)
+    {
+        if (cooked.material >= header.materialCount ||
+            (uint64_t)cooked.firstMeshlet + cooked.meshletCount > header.meshletCount)
+        {
+            std::cout << "Invalid cooked mesh: " << path << std::endl;
+            return false;
+        }
+    }
+    for (const CookedMeshFormat::Meshlet& cooked : cookedMeshlets)
+    {
+        if ((uint64_t)cooked.firstIndex + cooked.indexCount > header.indexCount)
+        {
+            std::cout << "Invalid cooked mesh: " << path << std::endl;
+            return false;
+        }
+    }
+
+    // Indices go to the GPU as they are; one past the vertex buffer would
+    // read out of bounds there
+    for (uint32_t i = 0; i < header.indexCount; i++)
+    {
+        uint32_t index;
+        memcpy(&index, data + layout.indices + (size_t)i * sizeof(index), sizeof(index));
+        if (index >= header.vertexCount)
+        {
+            std::cout << "Invalid cooked mesh: " << path << std::endl;
+            return false;
+        }
+    }
+
+    // Materials join the shared table; identical ones already there are reused
+    std::vector<MaterialId> materialIds(header.materialCount);
+    for (uint32_t m = 0; m < header.materialCount; m++)
+    {
+        CookedMeshFormat::Material cooked;
+        memcpy(&cooked, data + layout.materials + m * sizeof(cooked), sizeof(cooked));
+
+        MaterialDesc material;
+        material.ambient = toVec3(cooked.ambient);
+        material.diffuse = toVec3(cooked.diffuse);
+        material.specular = toVec3(cooked.specular);
+        material.alpha = cooked.alpha;
+        material.shininess = cooked.shininess;
+        materialIds[m] = MaterialRegistry::intern(material);
+    }
+
+    submeshes.resize(header.submeshCount);
+    std::vector<Meshlet> meshlets;
+    for (uint32_t s = 0; s < header.submeshCount; s++)
+    {
+        const CookedMeshFormat::Submesh& cooked = cookedSubmeshes[s];
+        Submesh& submesh = submeshes[s];
+        submesh.material = materialIds[cooked.material];
+        submesh.transparent = MaterialRegistry::get(submesh.material).alpha < 1.0f;
+
+        meshlets.clear();
+        AABB submeshBounds = { glm::vec3(1e30f), glm::vec3(-1e30f) };
+        for (uint32_t i = cooked.firstMeshlet; i < cooked.firstMeshlet + cooked.meshletCount; i++)
+        {
+            const CookedMeshFormat::Meshlet& source = cookedMeshlets[i];
+            Meshlet meshlet;
+            meshlet.firstIndex = source.firstIndex;
+            meshlet.indexCount = source.indexCount;
+            meshlet.vertexCount = (int)source.vertexCount;
+            meshlet.sphere.center = toVec3(source.sphere);
+            meshlet.sphere.radius = source.sphere[3];
+            meshlet.bounds.minCorner = toVec3(source.boundsMin);
+            meshlet.bounds.maxCorner = toVec3(source.boundsMax);
+            meshlet.coneApex = toVec3(source.coneApex);
+            meshlet.coneAxis = toVec3(source.coneAxis);
+            meshlet.coneCutoff = source.coneCutoff;
+            meshlets.push_back(meshlet);
+
+            submeshBounds.minCorner = glm::min(submeshBounds.minCorner, meshlet.bounds.minCorner);
+            submeshBounds.maxCorner = glm::max(submeshBounds.maxCorner, meshlet.bounds.maxCorner);
+        }
+        submesh.meshlets.setMeshlets(meshlets, submeshBounds);
+    }
+
+    bounds.minCorner = toVec3(header.boundsMin);
+    bounds.maxCorner = toVec3(header.boundsMax);
+    positionScale = header.positionScale;
+
+    // The vertex and index sections are uploaded as they sit in the mapping
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vertexBuffer);
+    glGenBuffers(1, &indexBuffer);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)header.vertexCount * header.vertexSize,
+        data + layout.vertices, GL_STATIC_DRAW);
+    MeshArena::setVertexAttributes();
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)header.indexCount * sizeof(uint32_t),
+        data + layout.indices, GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void CookedModel::release()
+{
+    if (vao)
+    {
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        vao = 0;
+        vertexBuffer = 0;
+        indexBuffer = 0;
+    }
+    submeshes.clear();
+}
+
+bool CookedModel::isLoaded() const
+{
+    return vao != 0;
+}
+
+void CookedModel::draw(Shader& shader, const glm::mat4& model, const Frustum& frustum,
+    const glm::vec3& cameraPosition)
+{
+    lastDrawCount = 0;
+    lastVisibleMeshletCount = 0;
+    if (!vao)
+        return;
+
+    // Culling works in object space; only the shader sees the position scale
+    glm::mat4 drawModel = model;
+    drawModel[0] *= positionScale;
+    drawModel[1] *= positionScale;
+    drawModel[2] *= positionScale;
+
+    shader.use();
+    shader.setMat4("model", drawModel);
+    glBindVertexArray(vao);
+
+    drawSubmeshes(model, frustum, cameraPosition, false);
+
+    glDepthMask(GL_FALSE);
+    drawSubmeshes(model, frustum, cameraPosition, true);
+    glDepthMask(GL_TRUE);
+
+    glBindVertexArray(0);
+}
+
+void CookedModel::drawSubmeshes(const glm::mat4& model, const Frustum& frustum,
+    const glm::vec3& cameraPosition, bool transparent)
+{
+    for (const Submesh& submesh : submeshes)
+    {
+        if (submesh.transparent != transparent)
+            continue;
+
+        submesh.meshlets.cull(frustum, model, cameraPosition, ranges);
+        lastVisibleMeshletCount += submesh.meshlets.getLastVisibleCount();
+        if (ranges.empty())
+            continue;
+
+        MaterialRegistry::setCurrent(submesh.material);
+        for (const MeshletRange& range : ranges)
+        {
+            glDrawElements(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+                (void*)(range.firstIndex * sizeof(GLuint)));
+            lastDrawCount++;
+        }
+    }
+}
+
+const AABB& CookedModel::getBounds() const
+{
+    return bounds;
+}
+
+int CookedModel::getSubmeshCount() const
+{
+    return (int)submeshes.size();
+}
+
+int CookedModel::getLastDrawCount() const
+{
+    return lastDrawCount;
+}
+
+int CookedModel::getLastVisibleMeshletCount() const
+{
+    return lastVisibleMeshletCount;
+}
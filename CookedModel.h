@@ -0,0 +1,63 @@
+#ifndef COOKED_MODEL_H
+#define COOKED_MODEL_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "shader.h"
+#include "Frustum.h"
+#include "MaterialRegistry.h"
+#include "MeshletMesh.h"
+
+// An imported model cooked by Tools/ModelCooker (CookedMeshFormat.h). load()
+// maps the file, checks the header and uploads the vertex and index sections
+// straight from the mapping; nothing is parsed or converted at runtime.
+// Each submesh keeps its material and its meshlets, which draw() culls
+// against the frustum and camera before issuing one draw per visible range.
+class CookedModel
+{
+public:
+    CookedModel();
+    ~CookedModel();
+
+    CookedModel(const CookedModel&) = delete;
+    CookedModel& operator=(const CookedModel&) = delete;
+
+    // False if the file is missing (silently) or invalid (with a message)
+    bool load(const char* path);
+    void release();
+    bool isLoaded() const;
+
+    // shader: the lighting program (model matrix uniform, material ID at
+    // MaterialRegistry::MATERIAL_ATTRIBUTE). Translucent submeshes are
+    // drawn last without depth writes.
+    void draw(Shader& shader, const glm::mat4& model, const Frustum& frustum,
+        const glm::vec3& cameraPosition);
+
+    const AABB& getBounds() const;                   // object space
+    int getSubmeshCount() const;
+    int getLastDrawCount() const;                    // draw calls issued by the last draw()
+    int getLastVisibleMeshletCount() const;
+
+private:
+    struct Submesh {
+        MaterialId material;
+        bool transparent;
+        MeshletMesh meshlets;
+    };
+
+    void drawSubmeshes(const glm::mat4& model, const Frustum& frustum, const glm::vec3& cameraPosition,
+        bool transparent);
+
+    GLuint vao;
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    std::vector<Submesh> submeshes;
+    std::vector<MeshletRange> ranges;
+    AABB bounds;
+    float positionScale;          // stored positions are object space / this
+    int lastDrawCount;
+    int lastVisibleMeshletCount;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include "EntityWorld.h"
+#include "SceneConfig.h"
+#include <algorithm>
+#include <numeric>
+
+static EntityWorld* recordingWorld = nullptr;
+
+// Reorders one component array by a permutation of its indices
+template <typename T>
+static void permute(std::vector<T>& values, const std::vector<int>& order)
+{
+    if (values.empty())
+        return;
+    std::vector<T> sorted;
+    sorted.reserve(order.size());
+    for (int index : order)
+        sorted.push_back(values[index]);
+    values.swap(sorted);
+}
+
+static AABB unionAABB(const AABB& a, const AABB& b)
+{
+    return AABB{ glm::min(a.minCorner, b.minCorner), glm::max(a.maxCorner, b.maxCorner) };
+}
+
+int EntityWorld::Archetype::size() const
+{
+    return (int)meshes.size();
+}
+
+void EntityWorld::Archetype::sortByPlacement()
+{
+    std::vector<int> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        const EntityPlacement& pa = placements[a];
+        const EntityPlacement& pb = placements[b];
+        if (pa.cell != pb.cell)
+            return pa.cell < pb.cell;
+        if (pa.group != pb.group)
+            return pa.group < pb.group;
+        return pa.owner < pb.owner;
+    });
+
+    permute(transforms, order);
+    permute(meshes, order);
+    permute(materials, order);
+    permute(transparent, order);
+    permute(bounds, order);
+    permute(placements, order);
+    permute(nodes, order);
+    permute(offsets, order);
+}
+
+EntityWorld::EntityWorld(const MeshArena& arena)
+    : arena(arena), recordingPlacement{ NONE, NONE, OcclusionGroups::NONE }, recordingNode(NONE),
+      animatePending(false)
+{
+}
+
+void EntityWorld::beginRecording(const EntityPlacement& placement, int node)
+{
+    recordingWorld = this;
+    recordingPlacement = placement;
+    recordingNode = node;
+}
+
+void EntityWorld::endRecording()
+{
+    recordingWorld = nullptr;
+}
+
+EntityWorld* EntityWorld::getRecording()
+{
+    return recordingWorld;
+}
+
+void EntityWorld::record(MeshId mesh, const glm::mat4& model, MaterialId material, bool transparent,
+    const AABB& bounds)
+{
+    Archetype& archetype = archetypes[recordingNode == NONE ? STATIC_ENTITIES : ANIMATED_ENTITIES];
+    archetype.transforms.push_back(model);
+    archetype.meshes.push_back(mesh);
+    archetype.materials.push_back(material);
+    archetype.transparent.push_back(transparent ? 1 : 0);
+    archetype.bounds.push_back(bounds);
+    archetype.placements.push_back(recordingPlacement);
+
+    if (recordingNode != NONE)
+    {
+        // Placed by animate() once the graph has world matrices
+        archetype.nodes.push_back(recordingNode);
+        archetype.offsets.push_back(model);
+    }
+}
+
+void EntityWorld::finalize(SceneObjects& objects)
+{
+    for (Archetype& archetype : archetypes)
+        archetype.sortByPlacement();
+
+    int objectCount = objects.getCount();
+    staticOwnerBounds.assign(objectCount, AABB{ glm::vec3(0.0f), glm::vec3(0.0f) });
+    hasStaticOwnerBounds.assign(objectCount, 0);
+
+    const Archetype& statics = archetypes[STATIC_ENTITIES];
+    for (int i = 0; i < statics.size(); i++)
+    {
+        int owner = statics.placements[i].owner;
+        if (owner == NONE)
+            continue;
+        staticOwnerBounds[owner] = hasStaticOwnerBounds[owner]
+            ? unionAABB(staticOwnerBounds[owner], statics.bounds[i])
+            : statics.bounds[i];
+        hasStaticOwnerBounds[owner] = 1;
+    }
+
+    for (int owner = 0; owner < objectCount; owner++)
+    {
+        if (hasStaticOwnerBounds[owner])
+            objects.setBounds(owner, staticOwnerBounds[owner]);
+    }
+    animatePending = true;
+}
+
+void EntityWorld::animate(const SceneGraph& graph, SceneObjects& objects)
+{
+    // Nothing moved: transforms and bounds from last frame still hold
+    if (!animatePending && graph.getLastUpdatedCount() == 0)
+        return;
+    animatePending = false;
+
+    Archetype& animated = archetypes[ANIMATED_ENTITIES];
+    int count = animated.size();
+    for (int i = 0; i < count; i++)
+    {
+        animated.transforms[i] = graph.getWorld(animated.nodes[i]) * animated.offsets[i];
+        animated.bounds[i] = transformAABB(animated.transforms[i], arena.getBounds(animated.meshes[i]));
+    }
+
+    // Entities of one owner are adjacent after sorting; publish each run's
+    // union, grown by whatever static parts the owner has
+    for (int first = 0; first < count; )
+    {
+        int owner = animated.placements[first].owner;
+        AABB bounds = animated.bounds[first];
+        int last = first + 1;
+        while (last < count && animated.placements[last].owner == owner)
+            bounds = unionAABB(bounds, animated.bounds[last++]);
+
+        if (owner != NONE)
+        {
+            if (hasStaticOwnerBounds[owner])
+                bounds = unionAABB(bounds, staticOwnerBounds[owner]);
+            objects.setBounds(owner, bounds);
+        }
+        first = last;
+    }
+}
+
+void EntityWorld::submit(RenderQueue& queue, const PortalGraph& portals, const SceneObjects& objects) const
+{
+    int currentGroup = OcclusionGroups::NONE;
+    for (const Archetype& archetype : archetypes)
+    {
+        int count = archetype.size();
+        for (int first = 0; first < count; )
+        {
+            // One visibility test per run of entities sharing cell and owner
+            const EntityPlacement& placement = archetype.placements[first];
+            int last = first + 1;
+            while (last < count &&
+                   archetype.placements[last].cell == placement.cell &&
+                   archetype.placements[last].group == placement.group &&
+                   archetype.placements[last].owner == placement.owner)
+                last++;
+
+            bool visible =
+                (placement.cell == NONE || portals.isCellVisible(placement.cell)) &&
+                (placement.owner == NONE || objects.isVisible(placement.owner));
+            if (visible)
+            {
+                if (placement.group != currentGroup)
+                {
+                    queue.setGroup(placement.group);
+                    currentGroup = placement.group;
+                }
+                for (int i = first; i < last; i++)
+                    queue.submit(archetype.meshes[i], archetype.transforms[i], archetype.materials[i],
+                        archetype.transparent[i] != 0);
+            }
+            first = last;
+        }
+    }
+    if (currentGroup != OcclusionGroups::NONE)
+        queue.setGroup(OcclusionGroups::NONE);
+}
+
+int EntityWorld::getEntityCount() const
+{
+    return archetypes[STATIC_ENTITIES].size() + archetypes[ANIMATED_ENTITIES].size();
+}
+
+int EntityWorld::getAnimatedCount() const
+{
+    return archetypes[ANIMATED_ENTITIES].size();
+}
@@ -0,0 +1,92 @@
+#ifndef ENTITY_WORLD_H
+#define ENTITY_WORLD_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Frustum.h"
+#include "MaterialRegistry.h"
+#include "MeshArena.h"
+#include "PortalGraph.h"
+#include "RenderQueue.h"
+#include "SceneGraph.h"
+#include "SceneObjects.h"
+#include "mesh.h"
+
+// Which object, cell and occlusion group an entity belongs to. Owner and
+// cell are optional (EntityWorld::NONE), the group can be OcclusionGroups::NONE.
+struct EntityPlacement {
+    int owner;     // SceneObjects id: culled and picked with that object
+    int cell;      // PortalCells: drawn only while the cell can be seen
+    int group;     // OcclusionGroups
+};
+
+// Renderable entities with their components packed in arrays, one array per
+// component and one set of arrays per archetype (entities with the same
+// components). Static entities have a transform, mesh, material, bounds and
+// placement; animated ones add a SceneGraph node and their offset from it.
+//
+// The world is filled once at load by recording: while recording, every
+// RenderUtils draw becomes an entity instead of reaching the GPU, so the
+// ClassroomObjects layout code runs once rather than every frame. Each frame
+// the systems then walk the arrays: animate() moves attached entities with
+// their nodes, and submit() culls per object and feeds the RenderQueue.
+class EntityWorld
+{
+public:
+    static const int NONE = -1;
+
+    explicit EntityWorld(const MeshArena& arena);
+
+    // Draws until endRecording() get this placement. With a node, draw with
+    // an identity base transform: what is recorded is the offset from the node.
+    void beginRecording(const EntityPlacement& placement, int node = NONE);
+    void endRecording();
+    static EntityWorld* getRecording();
+    void record(MeshId mesh, const glm::mat4& model, MaterialId material, bool transparent,
+        const AABB& bounds);
+
+    // After recording: sort each archetype into per-object runs and publish
+    // every object's bounds
+    void finalize(SceneObjects& objects);
+
+    // Per frame, after SceneGraph::update()
+    void animate(const SceneGraph& graph, SceneObjects& objects);
+    void submit(RenderQueue& queue, const PortalGraph& portals, const SceneObjects& objects) const;
+
+    int getEntityCount() const;
+    int getAnimatedCount() const;
+
+private:
+    enum ArchetypeId {
+        STATIC_ENTITIES,
+        ANIMATED_ENTITIES,
+        ARCHETYPE_COUNT
+    };
+
+    struct Archetype {
+        std::vector<glm::mat4> transforms;
+        std::vector<MeshId> meshes;
+        std::vector<MaterialId> materials;
+        std::vector<uint8_t> transparent;
+        std::vector<AABB> bounds;
+        std::vector<EntityPlacement> placements;
+        std::vector<int> nodes;               // Animated only
+        std::vector<glm::mat4> offsets;       // Animated only
+
+        int size() const;
+        void sortByPlacement();      // Stable: by cell, then group, then owner
+    };
+
+    const MeshArena& arena;
+    Archetype archetypes[ARCHETYPE_COUNT];
+    EntityPlacement recordingPlacement;
+    int recordingNode;
+    bool animatePending;               // Set by finalize(): nothing placed yet
+
+    // Union of each object's static entities, the base its animated ones extend
+    std::vector<AABB> staticOwnerBounds;
+    std::vector<uint8_t> hasStaticOwnerBounds;
+};
+
+#endif
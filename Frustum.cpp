@@ -0,0 +1,105 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FRUSTUM_USE_SSE 1
+#include <xmmintrin.h>
+#endif
+
+AABB transformAABB(const glm::mat4& model, const AABB& local)
+{
+    glm::vec3 center = (local.minCorner + local.maxCorner) * 0.5f;
+    glm::vec3 extent = (local.maxCorner - local.minCorner) * 0.5f;
+
+#ifdef FRUSTUM_USE_SSE
+    // Each column is four contiguous floats; the w lanes are computed and dropped
+    __m128 column0 = _mm_loadu_ps(&model[0][0]);
+    __m128 column1 = _mm_loadu_ps(&model[1][0]);
+    __m128 column2 = _mm_loadu_ps(&model[2][0]);
+    __m128 column3 = _mm_loadu_ps(&model[3][0]);
+
+    // Same summation order as glm's matrix * vector
+    __m128 worldCenter = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(center.x)), _mm_mul_ps(column1, _mm_set1_ps(center.y))),
+        _mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(center.z)), column3));
+
+    __m128 signBits = _mm_set1_ps(-0.0f);
+    __m128 worldExtent = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signBits, column0), _mm_set1_ps(extent.x)),
+                   _mm_mul_ps(_mm_andnot_ps(signBits, column1), _mm_set1_ps(extent.y))),
+        _mm_mul_ps(_mm_andnot_ps(signBits, column2), _mm_set1_ps(extent.z)));
+
+    float minCorner[4];
+    float maxCorner[4];
+    _mm_storeu_ps(minCorner, _mm_sub_ps(worldCenter, worldExtent));
+    _mm_storeu_ps(maxCorner, _mm_add_ps(worldCenter, worldExtent));
+
+    AABB world;
+    world.minCorner = glm::vec3(minCorner[0], minCorner[1], minCorner[2]);
+    world.maxCorner = glm::vec3(maxCorner[0], maxCorner[1], maxCorner[2]);
+    return world;
+#else
+    glm::vec3 worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+    glm::vec3 worldExtent =
+        glm::abs(glm::vec3(model[0])) * extent.x +
+        glm::abs(glm::vec3(model[1])) * extent.y +
+        glm::abs(glm::vec3(model[2])) * extent.z;
+
+    AABB world;
+    world.minCorner = worldCenter - worldExtent;
+    world.maxCorner = worldCenter + worldExtent;
+    return world;
+#endif
+}
+
+// Gribb/Hartmann plane extraction from the rows of the clip matrix
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection)
+{
+    glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+    glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+    glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+    glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;   // left
+    frustum.planes[1] = row3 - row0;   // right
+    frustum.planes[2] = row3 + row1;   // bottom
+    frustum.planes[3] = row3 - row1;   // top
+    frustum.planes[4] = row3 + row2;   // near
+    frustum.planes[5] = row3 - row2;   // far
+
+    for (int i = 0; i < 6; i++)
+        frustum.planes[i] /= glm::length(glm::vec3(frustum.planes[i]));
+    return frustum;
+}
+
+bool Frustum::intersects(const AABB& box) const
+{
+    glm::vec3 center = (box.minCorner + box.maxCorner) * 0.5f;
+    glm::vec3 extent = (box.maxCorner - box.minCorner) * 0.5f;
+
+    for (int i = 0; i < 6; i++)
+    {
+        glm::vec3 normal = glm::vec3(planes[i]);
+        float distance = glm::dot(normal, center) + planes[i].w;
+        float radius = glm::dot(glm::abs(normal), extent);
+        if (distance < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const
+{
+    for (int i = 0; i < 6; i++)
+    {
+        if (glm::dot(glm::vec3(planes[i]), sphere.center) + planes[i].w < -sphere.radius)
+            return false;
+    }
+    return true;
+}
+
+const glm::vec4& Frustum::getPlane(int index) const
+{
+    return planes[index];
+}
@@ -0,0 +1,37 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// Axis-aligned bounding box
+struct AABB {
+    glm::vec3 minCorner;
+    glm::vec3 maxCorner;
+};
+
+struct BoundingSphere {
+    glm::vec3 center;
+    float radius;
+};
+
+// Bounds of a transformed box (Arvo's method: exact for the box's corners).
+// Runs on whole matrix columns with SSE where the compiler targets it.
+AABB transformAABB(const glm::mat4& model, const AABB& local);
+
+// View frustum as six inward-facing planes (xyz = normal, w = distance)
+class Frustum
+{
+public:
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    // False only when the box is entirely outside one plane
+    bool intersects(const AABB& box) const;
+    bool intersects(const BoundingSphere& sphere) const;
+
+    const glm::vec4& getPlane(int index) const;
+
+private:
+    glm::vec4 planes[6];
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "GLCaps.h"
+#include <cstring>
+#include <iostream>
+
+static int majorVersion = 0;
+static int minorVersion = 0;
+static bool s3tcSupported = false;
+static bool multiDrawIndirectSupported = false;
+static bool computeSupported = false;
+static bool conservativeQueriesSupported = false;
+static bool bufferStorageSupported = false;
+
+GLCapsMultiDrawElementsIndirectProc GLCaps::multiDrawElementsIndirect = nullptr;
+GLCapsDispatchComputeProc GLCaps::dispatchCompute = nullptr;
+GLCapsMemoryBarrierProc GLCaps::memoryBarrier = nullptr;
+GLCapsBindImageTextureProc GLCaps::bindImageTexture = nullptr;
+GLCapsBufferStorageProc GLCaps::bufferStorage = nullptr;
+
+void GLCaps::init(GLADloadproc loadProc)
+{
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+    s3tcSupported = hasExtension("GL_EXT_texture_compression_s3tc");
+
+    // The indirect commands carry baseInstance, so base-instance support is required too
+    if (isVersionAtLeast(4, 3) ||
+        (hasExtension("GL_ARB_multi_draw_indirect") && hasExtension("GL_ARB_base_instance")))
+    {
+        multiDrawElementsIndirect = (GLCapsMultiDrawElementsIndirectProc)loadProc("glMultiDrawElementsIndirect");
+    }
+    multiDrawIndirectSupported = multiDrawElementsIndirect != nullptr;
+
+    if (isVersionAtLeast(4, 3))
+    {
+        dispatchCompute = (GLCapsDispatchComputeProc)loadProc("glDispatchCompute");
+        memoryBarrier = (GLCapsMemoryBarrierProc)loadProc("glMemoryBarrier");
+        bindImageTexture = (GLCapsBindImageTextureProc)loadProc("glBindImageTexture");
+    }
+    computeSupported = dispatchCompute && memoryBarrier && bindImageTexture;
+
+    conservativeQueriesSupported = isVersionAtLeast(4, 3) || hasExtension("GL_ARB_ES3_compatibility");
+
+    if (isVersionAtLeast(4, 4) || hasExtension("GL_ARB_buffer_storage"))
+        bufferStorage = (GLCapsBufferStorageProc)loadProc("glBufferStorage");
+    bufferStorageSupported = bufferStorage != nullptr;
+
+    std::cout << "OpenGL " << majorVersion << "." << minorVersion
+        << " (S3TC: " << (s3tcSupported ? "yes" : "no")
+        << ", multi-draw indirect: " << (multiDrawIndirectSupported ? "yes" : "no")
+        << ", compute: " << (computeSupported ? "yes" : "no")
+        << ", conservative queries: " << (conservativeQueriesSupported ? "yes" : "no")
+        << ", buffer storage: " << (bufferStorageSupported ? "yes" : "no") << ")" << std::endl;
+}
+
+int GLCaps::getMajorVersion()
+{
+    return majorVersion;
+}
+
+int GLCaps::getMinorVersion()
+{
+    return minorVersion;
+}
+
+bool GLCaps::isVersionAtLeast(int major, int minor)
+{
+    return majorVersion > major || (majorVersion == major && minorVersion >= minor);
+}
+
+bool GLCaps::hasExtension(const char* name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+    {
+        const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (ext && strcmp(ext, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool GLCaps::hasS3TC()
+{
+    return s3tcSupported;
+}
+
+bool GLCaps::hasMultiDrawIndirect()
+{
+    return multiDrawIndirectSupported;
+}
+
+bool GLCaps::hasComputeShaders()
+{
+    return computeSupported;
+}
+
+bool GLCaps::hasConservativeOcclusionQueries()
+{
+    return conservativeQueriesSupported;
+}
+
+bool GLCaps::hasBufferStorage()
+{
+    return bufferStorageSupported;
+}
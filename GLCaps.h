@@ -0,0 +1,75 @@
+#ifndef GL_CAPS_H
+#define GL_CAPS_H
+
+#include <glad/glad.h>
+
+// The bundled glad loader only covers core GL 3.3, so enums for the
+// extensions we opt into are declared here.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER                   0x91B9
+#define GL_SHADER_STORAGE_BUFFER            0x90D2
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT  0x00000001
+#define GL_TEXTURE_FETCH_BARRIER_BIT        0x00000008
+#define GL_SHADER_IMAGE_ACCESS_BARRIER_BIT  0x00000020
+#define GL_COMMAND_BARRIER_BIT              0x00000040
+#define GL_SHADER_STORAGE_BARRIER_BIT       0x00002000
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT  0x0040
+#define GL_MAP_COHERENT_BIT    0x0080
+#endif
+
+#ifndef GL_ANY_SAMPLES_PASSED_CONSERVATIVE
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#endif
+
+// Entry points above GL 3.3 that the renderer uses when present
+typedef void (APIENTRYP GLCapsMultiDrawElementsIndirectProc)(GLenum mode, GLenum type,
+    const void* indirect, GLsizei drawcount, GLsizei stride);
+typedef void (APIENTRYP GLCapsDispatchComputeProc)(GLuint groupsX, GLuint groupsY, GLuint groupsZ);
+typedef void (APIENTRYP GLCapsMemoryBarrierProc)(GLbitfield barriers);
+typedef void (APIENTRYP GLCapsBindImageTextureProc)(GLuint unit, GLuint texture, GLint level,
+    GLboolean layered, GLint layer, GLenum access, GLenum format);
+typedef void (APIENTRYP GLCapsBufferStorageProc)(GLenum target, GLsizeiptr size, const void* data,
+    GLbitfield flags);
+
+// Runtime OpenGL capability queries. Call GLCaps::init() once after gladLoadGL(),
+// passing the window system's proc-address function for the optional entry points.
+class GLCaps
+{
+public:
+    static void init(GLADloadproc loadProc);
+
+    static int getMajorVersion();
+    static int getMinorVersion();
+    static bool isVersionAtLeast(int major, int minor);
+    static bool hasExtension(const char* name);
+
+    // Convenience flags resolved by init()
+    static bool hasS3TC();
+    static bool hasMultiDrawIndirect();   // GL 4.3 or ARB_multi_draw_indirect + ARB_base_instance
+    static bool hasComputeShaders();      // GL 4.3: compute, SSBOs and image load/store
+    static bool hasConservativeOcclusionQueries();   // GL 4.3 or ARB_ES3_compatibility
+    static bool hasBufferStorage();       // GL 4.4 or ARB_buffer_storage: persistent mapping
+
+    // Null when the matching has*() flag is false
+    static GLCapsMultiDrawElementsIndirectProc multiDrawElementsIndirect;
+    static GLCapsDispatchComputeProc dispatchCompute;
+    static GLCapsMemoryBarrierProc memoryBarrier;
+    static GLCapsBindImageTextureProc bindImageTexture;
+    static GLCapsBufferStorageProc bufferStorage;
+};
+
+#endif
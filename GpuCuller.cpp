@@ -0,0 +1,174 @@
+#include "GpuCuller.h"
+#include "GLCaps.h"
+#include "Frustum.h"
+#include "config_culling.h"
+#include <algorithm>
+#include <string>
+
+bool GpuCuller::isSupported()
+{
+    return GLCaps::hasComputeShaders() && GLCaps::hasMultiDrawIndirect();
+}
+
+GpuCuller::GpuCuller()
+    : cullShader(cullComputeShaderSource),
+      hiZCopyShader(hiZCopyComputeShaderSource),
+      hiZReduceShader(hiZReduceComputeShaderSource),
+      depthTexture(0), hiZTexture(0), width(0), height(0), levels(0),
+      hiZValid(false), occlusionEnabled(true), hiZViewProjection(1.0f)
+{
+}
+
+GpuCuller::~GpuCuller()
+{
+    release();
+}
+
+void GpuCuller::cull(
+    GLuint sourceInstances,
+    GLuint visibleInstances,
+    GLuint commands,
+    GLuint bounds,
+    int instanceCount,
+    const glm::mat4& viewProjection
+) {
+    if (instanceCount == 0)
+        return;
+
+    Frustum frustum = Frustum::fromMatrix(viewProjection);
+
+    cullShader.use();
+    cullShader.setUInt("instanceCount", (unsigned int)instanceCount);
+    for (int i = 0; i < 6; i++)
+        cullShader.setVec4("frustumPlanes[" + std::to_string(i) + "]", frustum.getPlane(i));
+
+    bool useHiZ = occlusionEnabled && hiZValid;
+    cullShader.setBool("useHiZ", useHiZ);
+    if (useHiZ)
+    {
+        cullShader.setMat4("hiZViewProjection", hiZViewProjection);
+        cullShader.setVec2("hiZSize", glm::vec2((float)width, (float)height));
+        cullShader.setInt("hiZLevels", levels);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, hiZTexture);
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, sourceInstances);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visibleInstances);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, commands);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, bounds);
+
+    GLCaps::dispatchCompute((GLuint)(instanceCount + 63) / 64, 1, 1);
+
+    // Indirect counts and instance attributes are consumed by the next draws
+    GLCaps::memoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GpuCuller::buildHiZ(const glm::mat4& viewProjection)
+{
+    if (!occlusionEnabled)
+        return;
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (viewport[2] <= 0 || viewport[3] <= 0)
+        return;
+    if (viewport[2] != width || viewport[3] != height)
+        resizeHiZ(viewport[2], viewport[3]);
+
+    // Level 0: depth buffer -> depth texture -> R32F
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, viewport[0], viewport[1], width, height);
+
+    hiZCopyShader.use();
+    GLCaps::bindImageTexture(0, hiZTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    GLCaps::dispatchCompute((GLuint)(width + 7) / 8, (GLuint)(height + 7) / 8, 1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Remaining levels: max reduction
+    hiZReduceShader.use();
+    int levelWidth = width;
+    int levelHeight = height;
+    for (int level = 1; level < levels; level++)
+    {
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+
+        GLCaps::memoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        GLCaps::bindImageTexture(0, hiZTexture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        GLCaps::bindImageTexture(1, hiZTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        GLCaps::dispatchCompute((GLuint)(levelWidth + 7) / 8, (GLuint)(levelHeight + 7) / 8, 1);
+    }
+
+    GLCaps::memoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    hiZViewProjection = viewProjection;
+    hiZValid = true;
+}
+
+void GpuCuller::setOcclusionEnabled(bool enabled)
+{
+    occlusionEnabled = enabled;
+    hiZValid = false;
+}
+
+void GpuCuller::resizeHiZ(int newWidth, int newHeight)
+{
+    if (depthTexture)
+    {
+        glDeleteTextures(1, &depthTexture);
+        glDeleteTextures(1, &hiZTexture);
+    }
+
+    width = newWidth;
+    height = newHeight;
+    levels = 1;
+    while ((width >> levels) > 0 || (height >> levels) > 0)
+        levels++;
+
+    glGenTextures(1, &depthTexture);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+    glGenTextures(1, &hiZTexture);
+    glBindTexture(GL_TEXTURE_2D, hiZTexture);
+    int levelWidth = width;
+    int levelHeight = height;
+    for (int level = 0; level < levels; level++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_R32F, levelWidth, levelHeight, 0, GL_RED, GL_FLOAT, NULL);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    hiZValid = false;
+}
+
+void GpuCuller::release()
+{
+    if (depthTexture)
+    {
+        glDeleteTextures(1, &depthTexture);
+        glDeleteTextures(1, &hiZTexture);
+        depthTexture = 0;
+        hiZTexture = 0;
+    }
+    width = 0;
+    height = 0;
+    hiZValid = false;
+    cullShader.deleteProgram();
+    hiZCopyShader.deleteProgram();
+    hiZReduceShader.deleteProgram();
+}
@@ -0,0 +1,59 @@
+#ifndef GPU_CULLER_H
+#define GPU_CULLER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "shader.h"
+
+// GL 4.3 compute path for RenderQueue culling. Opaque instances are tested
+// against the frustum and against a Hi-Z pyramid built from the previous
+// frame's depth buffer. Survivors are compacted straight into the indirect
+// command buffer, so the CPU never sees per-instance visibility.
+// Check isSupported() before constructing.
+class GpuCuller
+{
+public:
+    static bool isSupported();
+
+    GpuCuller();
+    ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    // Cull sourceInstances[0, instanceCount) into visibleInstances. The
+    // commands' instanceCount fields must be zero; bounds holds one object
+    // space box (two vec4) per command.
+    void cull(
+        GLuint sourceInstances,
+        GLuint visibleInstances,
+        GLuint commands,
+        GLuint bounds,
+        int instanceCount,
+        const glm::mat4& viewProjection
+    );
+
+    // Capture the current depth buffer as next frame's occlusion pyramid
+    void buildHiZ(const glm::mat4& viewProjection);
+
+    void setOcclusionEnabled(bool enabled);
+    void release();
+
+private:
+    void resizeHiZ(int newWidth, int newHeight);
+
+    Shader cullShader;
+    Shader hiZCopyShader;
+    Shader hiZReduceShader;
+
+    GLuint depthTexture;
+    GLuint hiZTexture;
+    int width;
+    int height;
+    int levels;
+    bool hiZValid;
+    bool occlusionEnabled;
+    glm::mat4 hiZViewProjection;
+};
+
+#endif
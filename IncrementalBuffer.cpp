@@ -0,0 +1,125 @@
+#include "IncrementalBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+IncrementalBuffer::IncrementalBuffer()
+    : buffer(0), capacity(0), needsAllocation(true)
+{
+}
+
+void IncrementalBuffer::setBuffer(GLuint newBuffer)
+{
+    buffer = newBuffer;
+    capacity = 0;
+    needsAllocation = true;
+}
+
+GLuint IncrementalBuffer::getBuffer() const
+{
+    return buffer;
+}
+
+void IncrementalBuffer::resize(size_t bytes)
+{
+    size_t oldSize = contents.size();
+    contents.resize(bytes);
+    if (bytes > capacity)
+    {
+        capacity = std::max(bytes, capacity * 2);
+        needsAllocation = true;
+    }
+    else if (bytes > oldSize)
+    {
+        // The GL buffer holds stale bytes there, whatever the copy says
+        markDirty(oldSize, bytes);
+    }
+}
+
+void IncrementalBuffer::write(size_t offset, const void* data, size_t bytes)
+{
+    const uint8_t* source = (const uint8_t*)data;
+    uint8_t* target = contents.data() + offset;
+
+    size_t first = 0;
+    while (first < bytes && source[first] == target[first])
+        first++;
+    if (first == bytes)
+        return;
+
+    size_t last = bytes;
+    while (source[last - 1] == target[last - 1])
+        last--;
+
+    std::memcpy(target + first, source + first, last - first);
+    markDirty(offset + first, offset + last);
+}
+
+void IncrementalBuffer::markDirty(size_t first, size_t last)
+{
+    // Writes arrive in increasing order, so only the last span can merge
+    if (!dirtySpans.empty() && first <= dirtySpans.back().last && last >= dirtySpans.back().first)
+    {
+        dirtySpans.back().first = std::min(dirtySpans.back().first, first);
+        dirtySpans.back().last = std::max(dirtySpans.back().last, last);
+        return;
+    }
+    dirtySpans.push_back(Span{ first, last });
+}
+
+size_t IncrementalBuffer::upload(StreamBuffer* stream)
+{
+    if (!buffer || contents.empty())
+    {
+        dirtySpans.clear();
+        return 0;
+    }
+
+    size_t sent = 0;
+    if (needsAllocation)
+    {
+        capacity = std::max(capacity, contents.size());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity, NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        send(stream, 0, contents.size());
+        sent = contents.size();
+        needsAllocation = false;
+    }
+    else
+    {
+        for (const Span& span : dirtySpans)
+        {
+            size_t last = std::min(span.last, contents.size());
+            if (span.first >= last)
+                continue;
+            send(stream, span.first, last - span.first);
+            sent += last - span.first;
+        }
+    }
+
+    dirtySpans.clear();
+    return sent;
+}
+
+void IncrementalBuffer::send(StreamBuffer* stream, size_t offset, size_t bytes)
+{
+    GLintptr staged = stream ? stream->allocate(contents.data() + offset, bytes) : -1;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (staged >= 0)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, stream->getBuffer());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, staged, offset, bytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    else
+    {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, bytes, contents.data() + offset);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+size_t IncrementalBuffer::getSize() const
+{
+    return contents.size();
+}
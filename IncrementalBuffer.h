@@ -0,0 +1,54 @@
+#ifndef INCREMENTAL_BUFFER_H
+#define INCREMENTAL_BUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "StreamBuffer.h"
+
+// CPU copy of a GL buffer's contents that tracks which bytes changed since
+// the last upload. Writers hand over a whole section (a render batch's
+// instances, one light) every frame; only the span of that section that
+// actually differs is marked dirty, and upload() sends just the dirty spans.
+// A toggle that changes one light or one object re-uploads those bytes,
+// not the whole buffer. Spans are staged in a StreamBuffer and copied into
+// place on the GPU, so an upload never waits for draws reading the buffer.
+// The GL buffer itself is owned by the caller.
+class IncrementalBuffer
+{
+public:
+    IncrementalBuffer();
+
+    // Attach a GL buffer. Its previous contents are not known, so everything
+    // is sent with the next upload.
+    void setBuffer(GLuint buffer);
+    GLuint getBuffer() const;
+
+    // Storage grows when needed (reallocation resends everything) and never shrinks
+    void resize(size_t bytes);
+    void write(size_t offset, const void* data, size_t bytes);
+
+    // Returns the number of bytes sent. Without a stream (or once its region
+    // is full) spans go through glBufferSubData instead.
+    size_t upload(StreamBuffer* stream);
+
+    size_t getSize() const;
+
+private:
+    void markDirty(size_t first, size_t last);
+    void send(StreamBuffer* stream, size_t offset, size_t bytes);
+
+    struct Span {
+        size_t first;
+        size_t last;      // One past the end
+    };
+
+    GLuint buffer;
+    std::vector<uint8_t> contents;
+    std::vector<Span> dirtySpans;
+    size_t capacity;              // Allocated size of the GL buffer
+    bool needsAllocation;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef KTX_FORMAT_H
+#define KTX_FORMAT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// KTX 1.1 container layout, shared by the runtime loaders (Texture::LoadKTX,
+// AsyncTextureLoader, TextureArray) and the offline cooker in Tools/TextureCooker. Kept free of GL headers so
+// the tool builds without a GL loader; the format values below are the GL
+// enum values stored in the file.
+namespace KtxFormat {
+    const unsigned char IDENTIFIER[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+    const uint32_t ENDIANNESS = 0x04030201;
+
+    // GL enum values written into / read from the header
+    const uint32_t TYPE_UNSIGNED_BYTE = 0x1401;
+    const uint32_t FORMAT_RGB = 0x1907;
+    const uint32_t FORMAT_RGBA = 0x1908;
+    const uint32_t INTERNAL_RGBA8 = 0x8058;
+    const uint32_t INTERNAL_BC1_RGB = 0x83F0;    // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    const uint32_t INTERNAL_BC3_RGBA = 0x83F3;   // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+
+    // Key/value entry the cooker writes with the source image's size as
+    // "<width>x<height>", since --size may have resampled the levels
+    const char* const SOURCE_SIZE_KEY = "SourceSize";
+
+    struct Header {
+        unsigned char identifier[12];
+        uint32_t endianness;
+        uint32_t glType;                 // 0 for compressed formats
+        uint32_t glTypeSize;
+        uint32_t glFormat;               // 0 for compressed formats
+        uint32_t glInternalFormat;
+        uint32_t glBaseInternalFormat;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t numberOfArrayElements;
+        uint32_t numberOfFaces;
+        uint32_t numberOfMipmapLevels;
+        uint32_t bytesOfKeyValueData;
+    };
+    static_assert(sizeof(Header) == 64, "KTX header must be 64 bytes");
+
+    inline bool isValidIdentifier(const Header& header)
+    {
+        return memcmp(header.identifier, IDENTIFIER, sizeof(IDENTIFIER)) == 0;
+    }
+
+    // Each mip level's data is followed by padding to a 4-byte boundary
+    inline uint32_t padToFour(uint32_t size)
+    {
+        return (size + 3u) & ~3u;
+    }
+
+    // Where the cooked version of a source image lives: "Images/floor.jpg"
+    // -> "Images/floor.jpg.ktx". The source extension stays so that
+    // floor.png and floor.jpg never cook to the same file.
+    inline std::string cookedPath(const std::string& sourcePath)
+    {
+        return sourcePath + ".ktx";
+    }
+
+    // Bytes per 4x4 block of the S3TC formats, 0 for anything else
+    inline uint32_t blockBytes(uint32_t internalFormat)
+    {
+        switch (internalFormat)
+        {
+        case 0x83F0: case 0x83F1: return 8;      // DXT1
+        case 0x83F2: case 0x83F3: return 16;     // DXT3, DXT5
+        default:                  return 0;
+        }
+    }
+
+    // One mip level inside a file's data; pixels points into that data
+    struct Level {
+        const unsigned char* pixels;
+        uint32_t imageSize;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    enum ParseResult {
+        PARSE_OK,
+        PARSE_INVALID,           // not a KTX 1.1 file of this endianness
+        PARSE_UNSUPPORTED,       // 3D, array or cube map
+        PARSE_TRUNCATED          // ends before the last declared level
+    };
+
+    // Validate the header and locate every mip level. All levels up to
+    // numberOfMipmapLevels must be present; a texture missing some would be
+    // incomplete and sample black.
+    inline ParseResult parse(const unsigned char* data, size_t size, Header& header, std::vector<Level>& levels)
+    {
+        levels.clear();
+        if (size < sizeof(Header))
+            return PARSE_INVALID;
+        memcpy(&header, data, sizeof(header));
+        if (!isValidIdentifier(header) || header.endianness != ENDIANNESS)
+            return PARSE_INVALID;
+        if (header.pixelDepth > 1 || header.numberOfArrayElements > 0 || header.numberOfFaces != 1)
+            return PARSE_UNSUPPORTED;
+
+        uint32_t levelCount = header.numberOfMipmapLevels > 0 ? header.numberOfMipmapLevels : 1;
+        uint64_t offset = (uint64_t)sizeof(header) + header.bytesOfKeyValueData;
+        uint32_t width = header.pixelWidth;
+        uint32_t height = header.pixelHeight;
+        for (uint32_t level = 0; level < levelCount; level++)
+        {
+            if (offset + sizeof(uint32_t) > size)
+                return PARSE_TRUNCATED;
+            uint32_t imageSize;
+            memcpy(&imageSize, data + offset, sizeof(imageSize));
+            offset += sizeof(imageSize);
+            if (offset + imageSize > size)
+                return PARSE_TRUNCATED;
+
+            levels.push_back({ data + offset, imageSize, width, height });
+            offset += padToFour(imageSize);
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        return PARSE_OK;
+    }
+
+    // SOURCE_SIZE_KEY from the key/value data; false if absent or malformed
+    inline bool findSourceSize(const unsigned char* data, size_t size, const Header& header,
+        int& width, int& height)
+    {
+        uint64_t offset = sizeof(Header);
+        uint64_t end = offset + header.bytesOfKeyValueData;
+        if (end > size)
+            return false;
+        while (offset + sizeof(uint32_t) <= end)
+        {
+            uint32_t entrySize;
+            memcpy(&entrySize, data + offset, sizeof(entrySize));
+            offset += sizeof(entrySize);
+            if (offset + entrySize > end)
+                return false;
+
+            std::string entry((const char*)data + offset, entrySize);
+            size_t keyEnd = entry.find('\0');
+            if (keyEnd != std::string::npos && entry.compare(0, keyEnd, SOURCE_SIZE_KEY) == 0)
+                return sscanf(entry.c_str() + keyEnd + 1, "%dx%d", &width, &height) == 2 && width > 0 && height > 0;
+            offset += padToFour(entrySize);
+        }
+        return false;
+    }
+}
+
+#endif
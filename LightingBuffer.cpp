@@ -0,0 +1,144 @@
+#include "LightingBuffer.h"
+#include <cstddef>
+#include <iostream>
+
+namespace {
+    // std140 layouts of the shader's DirLight, PointLight and SpotLight:
+    // every vec3 starts on a 16-byte boundary and structs round up to 16
+    struct GpuDirLight {
+        glm::vec3 direction;
+        float padding0;
+        glm::vec3 ambient;
+        float padding1;
+        glm::vec3 diffuse;
+        float padding2;
+        glm::vec3 specular;
+        float padding3;
+    };
+
+    struct GpuPointLight {
+        glm::vec3 position;
+        float constant;
+        float linear;
+        float quadratic;
+        float padding0[2];
+        glm::vec3 ambient;
+        float padding1;
+        glm::vec3 diffuse;
+        float padding2;
+        glm::vec3 specular;
+        float padding3;
+    };
+
+    struct GpuSpotLight {
+        glm::vec3 position;
+        float padding0;
+        glm::vec3 direction;
+        float cutOff;
+        float outerCutOff;
+        float constant;
+        float linear;
+        float quadratic;
+        glm::vec3 ambient;
+        float padding1;
+        glm::vec3 diffuse;
+        float padding2;
+        glm::vec3 specular;
+        float padding3;
+    };
+
+    // The whole block, one section per light
+    struct GpuLighting {
+        GpuDirLight sun;
+        GpuPointLight pointLights[LightingBuffer::NUM_POINT_LIGHTS];
+        GpuSpotLight spotLight;
+    };
+
+    static_assert(sizeof(GpuDirLight) == 64, "DirLight must match std140");
+    static_assert(sizeof(GpuPointLight) == 80, "PointLight must match std140");
+    static_assert(sizeof(GpuSpotLight) == 96, "SpotLight must match std140");
+}
+
+LightingBuffer::LightingBuffer()
+    : ubo(0), lastUploadBytes(0)
+{
+    glGenBuffers(1, &ubo);
+    contents.setBuffer(ubo);
+    contents.resize(sizeof(GpuLighting));
+}
+
+LightingBuffer::~LightingBuffer()
+{
+    release();
+}
+
+void LightingBuffer::bindShader(const Shader& shader)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(shader.ID, "Lighting");
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        std::cout << "ERROR::LIGHTING_BUFFER::NO_LIGHTING_BLOCK" << std::endl;
+        return;
+    }
+    glUniformBlockBinding(shader.ID, blockIndex, BINDING_POINT);
+}
+
+void LightingBuffer::setSun(const DirLightDesc& light)
+{
+    GpuDirLight section = {};
+    section.direction = light.direction;
+    section.ambient = light.ambient;
+    section.diffuse = light.diffuse;
+    section.specular = light.specular;
+    contents.write(offsetof(GpuLighting, sun), &section, sizeof(section));
+}
+
+void LightingBuffer::setPointLight(int index, const PointLightDesc& light)
+{
+    GpuPointLight section = {};
+    section.position = light.position;
+    section.constant = light.constant;
+    section.linear = light.linear;
+    section.quadratic = light.quadratic;
+    section.ambient = light.ambient;
+    section.diffuse = light.diffuse;
+    section.specular = light.specular;
+    contents.write(offsetof(GpuLighting, pointLights) + index * sizeof(GpuPointLight), &section, sizeof(section));
+}
+
+void LightingBuffer::setSpotLight(const SpotLightDesc& light)
+{
+    GpuSpotLight section = {};
+    section.position = light.position;
+    section.direction = light.direction;
+    section.cutOff = light.cutOff;
+    section.outerCutOff = light.outerCutOff;
+    section.constant = light.constant;
+    section.linear = light.linear;
+    section.quadratic = light.quadratic;
+    section.ambient = light.ambient;
+    section.diffuse = light.diffuse;
+    section.specular = light.specular;
+    contents.write(offsetof(GpuLighting, spotLight), &section, sizeof(section));
+}
+
+void LightingBuffer::upload(StreamBuffer* stream)
+{
+    lastUploadBytes = contents.upload(stream);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, ubo);
+}
+
+void LightingBuffer::release()
+{
+    if (ubo)
+    {
+        glDeleteBuffers(1, &ubo);
+        contents.setBuffer(0);
+        ubo = 0;
+    }
+}
+
+size_t LightingBuffer::getLastUploadBytes() const
+{
+    return lastUploadBytes;
+}
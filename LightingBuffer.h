@@ -0,0 +1,79 @@
+#ifndef LIGHTING_BUFFER_H
+#define LIGHTING_BUFFER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "IncrementalBuffer.h"
+#include "StreamBuffer.h"
+#include "shader.h"
+
+struct DirLightDesc {
+    glm::vec3 direction;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+};
+
+struct PointLightDesc {
+    glm::vec3 position;
+    float constant;
+    float linear;
+    float quadratic;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+};
+
+struct SpotLightDesc {
+    glm::vec3 position;
+    glm::vec3 direction;
+    float cutOff;          // Cosines of the inner and outer cone angles
+    float outerCutOff;
+    float constant;
+    float linear;
+    float quadratic;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+};
+
+// The scene's lights in one std140 uniform block ("Lighting") instead of
+// per-shader uniforms, in sections: the sun, each ceiling light and the
+// projector's spotlight. Every section is rewritten each frame, but only the
+// ones whose values changed are uploaded, so switching the ceiling lights
+// re-sends their sections alone, and an idle projector costs nothing.
+class LightingBuffer
+{
+public:
+    // Keep in sync with NR_POINT_LIGHTS in the lighting shaders
+    static const int NUM_POINT_LIGHTS = 4;
+    static const GLuint BINDING_POINT = 1;    // MaterialRegistry uses 0
+
+    LightingBuffer();
+    ~LightingBuffer();
+
+    LightingBuffer(const LightingBuffer&) = delete;
+    LightingBuffer& operator=(const LightingBuffer&) = delete;
+
+    // Attach a program's "Lighting" block to the buffer's binding point
+    static void bindShader(const Shader& shader);
+
+    void setSun(const DirLightDesc& light);
+    void setPointLight(int index, const PointLightDesc& light);
+    void setSpotLight(const SpotLightDesc& light);
+
+    // Send the changed sections, staged in the stream if given; once per
+    // frame, before drawing
+    void upload(StreamBuffer* stream);
+
+    void release();
+
+    size_t getLastUploadBytes() const;
+
+private:
+    GLuint ubo;
+    IncrementalBuffer contents;
+    size_t lastUploadBytes;
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include "MaterialRegistry.h"
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // std140 layout of one table entry
+    struct GpuMaterial {
+        glm::vec4 ambient;             // rgb, unused
+        glm::vec4 diffuseAlpha;        // rgb, alpha
+        glm::vec4 specularShininess;   // rgb, shininess
+    };
+
+    struct MaterialHash {
+        size_t operator()(const MaterialDesc& m) const
+        {
+            const float* values = &m.ambient.x;
+            size_t hash = 0;
+            for (size_t i = 0; i < sizeof(MaterialDesc) / sizeof(float); i++)
+            {
+                uint32_t bits;
+                memcpy(&bits, &values[i], sizeof(bits));
+                hash ^= std::hash<uint32_t>()(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    struct MaterialEqual {
+        bool operator()(const MaterialDesc& a, const MaterialDesc& b) const
+        {
+            return memcmp(&a, &b, sizeof(MaterialDesc)) == 0;
+        }
+    };
+
+    GLuint tableUBO = 0;
+    std::vector<MaterialDesc> materials;
+    std::unordered_map<MaterialDesc, MaterialId, MaterialHash, MaterialEqual> lookup;
+}
+
+static const float DEFAULT_SHININESS = 32.0f;
+
+void MaterialRegistry::init()
+{
+    if (tableUBO)
+        return;
+
+    glGenBuffers(1, &tableUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, tableUBO);
+    glBufferData(GL_UNIFORM_BUFFER, MAX_MATERIALS * sizeof(GpuMaterial), NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, tableUBO);
+
+    // Entry 0 is a neutral grey fallback
+    materials.clear();
+    lookup.clear();
+    intern(glm::vec3(0.2f), glm::vec3(0.5f), glm::vec3(0.2f));
+}
+
+void MaterialRegistry::release()
+{
+    if (tableUBO)
+    {
+        glDeleteBuffers(1, &tableUBO);
+        tableUBO = 0;
+    }
+    materials.clear();
+    lookup.clear();
+}
+
+MaterialId MaterialRegistry::intern(const MaterialDesc& material)
+{
+    auto found = lookup.find(material);
+    if (found != lookup.end())
+        return found->second;
+
+    if ((int)materials.size() >= MAX_MATERIALS)
+    {
+        std::cout << "ERROR::MATERIAL_REGISTRY::TABLE_FULL (" << MAX_MATERIALS << " materials)" << std::endl;
+        return 0;
+    }
+
+    MaterialId id = (MaterialId)materials.size();
+    materials.push_back(material);
+    lookup[material] = id;
+
+    GpuMaterial entry;
+    entry.ambient = glm::vec4(material.ambient, 0.0f);
+    entry.diffuseAlpha = glm::vec4(material.diffuse, material.alpha);
+    entry.specularShininess = glm::vec4(material.specular, material.shininess);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, tableUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, id * sizeof(GpuMaterial), sizeof(GpuMaterial), &entry);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    return id;
+}
+
+MaterialId MaterialRegistry::intern(
+    const glm::vec3& ambient,
+    const glm::vec3& diffuse,
+    const glm::vec3& specular,
+    float alpha
+) {
+    MaterialDesc material;
+    material.ambient = ambient;
+    material.diffuse = diffuse;
+    material.specular = specular;
+    material.alpha = alpha;
+    material.shininess = DEFAULT_SHININESS;
+    return intern(material);
+}
+
+void MaterialRegistry::bindShader(const Shader& shader)
+{
+    GLuint blockIndex = glGetUniformBlockIndex(shader.ID, "Materials");
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        std::cout << "ERROR::MATERIAL_REGISTRY::NO_MATERIALS_BLOCK" << std::endl;
+        return;
+    }
+    glUniformBlockBinding(shader.ID, blockIndex, BINDING_POINT);
+}
+
+void MaterialRegistry::setCurrent(MaterialId id)
+{
+    // With the attribute array disabled every vertex reads this current value
+    glVertexAttribI4ui(MATERIAL_ATTRIBUTE, id, 0, 0, 0);
+}
+
+const MaterialDesc& MaterialRegistry::get(MaterialId id)
+{
+    return materials[id];
+}
+
+int MaterialRegistry::getMaterialCount()
+{
+    return (int)materials.size();
+}
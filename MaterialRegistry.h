@@ -0,0 +1,56 @@
+#ifndef MATERIAL_REGISTRY_H
+#define MATERIAL_REGISTRY_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include "shader.h"
+
+typedef uint16_t MaterialId;
+
+struct MaterialDesc {
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+    float alpha;
+    float shininess;
+};
+
+// Interns unique materials into a GPU-side table (std140 uniform block
+// "Materials"). Draws select an entry by a 16-bit ID passed through vertex
+// attribute MATERIAL_ATTRIBUTE, either as a constant per draw or as an
+// instanced attribute, so switching materials never touches uniforms.
+class MaterialRegistry
+{
+public:
+    // Keep in sync with MAX_MATERIALS in the lighting shader; 256 entries of
+    // 48 bytes fit the 16 KB minimum uniform block size.
+    static const int MAX_MATERIALS = 256;
+    static const GLuint BINDING_POINT = 0;
+    static const GLuint MATERIAL_ATTRIBUTE = 3;
+
+    // Create the table buffer. Call once after GLCaps::init().
+    static void init();
+    static void release();
+
+    // Return the ID of an identical existing material or add a new one.
+    // New entries are written to the GPU table immediately.
+    static MaterialId intern(const MaterialDesc& material);
+    static MaterialId intern(
+        const glm::vec3& ambient,
+        const glm::vec3& diffuse,
+        const glm::vec3& specular,
+        float alpha = 1.0f
+    );
+
+    // Attach a program's "Materials" block to the table's binding point
+    static void bindShader(const Shader& shader);
+
+    // Select the material for subsequent non-instanced draws
+    static void setCurrent(MaterialId id);
+
+    static const MaterialDesc& get(MaterialId id);
+    static int getMaterialCount();
+};
+
+#endif
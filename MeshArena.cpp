@@ -0,0 +1,265 @@
+#include "MeshArena.h"
+#include "MeshOptimizer.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const int FLOATS_PER_VERTEX = 8;
+
+    const char* const MESH_NAMES[Mesh::TYPE_COUNT] = {
+        "CUBE", "PLANE", "SPHERE", "TETRAHEDRON", "PENTAHEDRON", "WINDOW", "CYLINDER", "PARABOLOID"
+    };
+
+    // An arena vertex in its final encoding; welding compares these, so
+    // vertices that only differed below the packed precision merge too
+    struct VertexKey {
+        unsigned char bytes[VertexFormat::VERTEX_SIZE];
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const
+        {
+            size_t hash = 0;
+            for (int i = 0; i < VertexFormat::VERTEX_SIZE; i += sizeof(uint16_t))
+            {
+                uint16_t bits;
+                memcpy(&bits, &key.bytes[i], sizeof(bits));
+                hash ^= std::hash<uint16_t>()(bits) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            }
+            return hash;
+        }
+    };
+
+    struct VertexKeyEqual {
+        bool operator()(const VertexKey& a, const VertexKey& b) const
+        {
+            return memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+        }
+    };
+}
+
+MeshArena::MeshArena()
+    : vertexBuffer(0), indexBuffer(0), vertexCount(0), indexCount(0)
+{
+}
+
+MeshArena::~MeshArena()
+{
+    release();
+}
+
+MeshId MeshArena::addPrototype(const char* name, const std::vector<Mesh::PrototypePart>& parts)
+{
+    prototypeNames.push_back(name);
+    prototypeVertices.emplace_back();
+    Mesh::BuildPrototype(parts, prototypeVertices.back());
+    return Mesh::TYPE_COUNT + (MeshId)prototypeVertices.size() - 1;
+}
+
+void MeshArena::build()
+{
+    release();
+
+    std::vector<unsigned char> vertices;
+    std::vector<GLuint> indices;
+
+    int meshCount = getMeshCount();
+    ranges.assign(meshCount, MeshRange());
+    positionScales.assign(meshCount, 1.0f);
+    bounds.resize(meshCount);
+
+    for (int t = 0; t < meshCount; t++)
+    {
+        const float* source;
+        int sourceCount;
+        const char* name;
+        if (t < Mesh::TYPE_COUNT)
+        {
+            source = Mesh::GetVertices((Mesh::Type)t);
+            sourceCount = Mesh::GetVertexCount((Mesh::Type)t);
+            bounds[t] = Mesh::GetBounds((Mesh::Type)t);
+            name = MESH_NAMES[t];
+        }
+        else
+        {
+            const std::vector<float>& prototype = prototypeVertices[t - Mesh::TYPE_COUNT];
+            source = prototype.data();
+            sourceCount = (int)prototype.size() / FLOATS_PER_VERTEX;
+            bounds[t].minCorner = glm::vec3(sourceCount > 0 ? 1e30f : 0.0f);
+            bounds[t].maxCorner = glm::vec3(sourceCount > 0 ? -1e30f : 0.0f);
+            for (int v = 0; v < sourceCount; v++)
+            {
+                glm::vec3 position(source[v * FLOATS_PER_VERTEX], source[v * FLOATS_PER_VERTEX + 1],
+                    source[v * FLOATS_PER_VERTEX + 2]);
+                bounds[t].minCorner = glm::min(bounds[t].minCorner, position);
+                bounds[t].maxCorner = glm::max(bounds[t].maxCorner, position);
+            }
+            name = prototypeNames[t - Mesh::TYPE_COUNT].c_str();
+        }
+
+        glm::vec3 maxAbs = glm::max(glm::abs(bounds[t].minCorner), glm::abs(bounds[t].maxCorner));
+        positionScales[t] = VertexFormat::positionScale(glm::max(maxAbs.x, glm::max(maxAbs.y, maxAbs.z)));
+
+        MeshRange& range = ranges[t];
+        range.firstIndex = (GLuint)indices.size();
+        range.baseVertex = (GLint)(vertices.size() / VERTEX_SIZE);
+
+        // Weld within the mesh; indices are relative to baseVertex
+        std::unordered_map<VertexKey, GLuint, VertexKeyHash, VertexKeyEqual> welded;
+        welded.reserve(sourceCount);
+        std::vector<VertexKey> meshVertices;
+        std::vector<glm::vec3> meshPositions;
+        std::vector<GLuint> meshIndices;
+        meshIndices.reserve(sourceCount);
+
+        for (int v = 0; v < sourceCount; v++)
+        {
+            const float* sourceVertex = &source[v * FLOATS_PER_VERTEX];
+            VertexKey key;
+            VertexFormat::encode(sourceVertex, positionScales[t], key.bytes);
+            glm::vec3 position(sourceVertex[0], sourceVertex[1], sourceVertex[2]);
+
+            auto found = welded.find(key);
+            if (found != welded.end())
+            {
+                meshIndices.push_back(found->second);
+                continue;
+            }
+
+            GLuint localIndex = (GLuint)meshVertices.size();
+            welded[key] = localIndex;
+            meshIndices.push_back(localIndex);
+            meshVertices.push_back(key);
+            meshPositions.push_back(position);
+        }
+
+        // The generators emit scanline order; reorder for the vertex cache,
+        // then for overdraw, then lay the vertices out in first-use order
+        int localCount = (int)meshVertices.size();
+        VertexCacheStats before = MeshOptimizer::analyzeVertexCache(meshIndices, localCount);
+        MeshOptimizer::optimizeVertexCache(meshIndices, localCount);
+        MeshOptimizer::optimizeOverdraw(meshIndices, meshPositions);
+        std::vector<GLuint> remap = MeshOptimizer::optimizeVertexFetch(meshIndices, localCount);
+        VertexCacheStats after = MeshOptimizer::analyzeVertexCache(meshIndices, (int)remap.size());
+
+        std::cout << "MeshArena: " << name << " " << localCount << " vertices, ACMR "
+                  << before.acmr << " -> " << after.acmr << ", ATVR "
+                  << before.atvr << " -> " << after.atvr << std::endl;
+
+        for (GLuint oldIndex : remap)
+            vertices.insert(vertices.end(), meshVertices[oldIndex].bytes, meshVertices[oldIndex].bytes + VERTEX_SIZE);
+        indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+        range.indexCount = (GLuint)indices.size() - range.firstIndex;
+    }
+
+    vertexCount = (int)(vertices.size() / VERTEX_SIZE);
+    indexCount = (int)indices.size();
+
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Bound to a VAO later; GL_ARRAY_BUFFER avoids disturbing the current VAO's element binding
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MeshArena::release()
+{
+    if (vertexBuffer)
+    {
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        vertexBuffer = 0;
+        indexBuffer = 0;
+    }
+    vertexCount = 0;
+    indexCount = 0;
+}
+
+void MeshArena::bindVertexAttributes() const
+{
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    setVertexAttributes();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+}
+
+void MeshArena::setVertexAttributes()
+{
+#if PACKED_VERTICES
+    // Position arrives divided by the mesh's scale (getDrawModel() undoes it);
+    // normal arrives as (octX, octY, 0) and the shaders' decodeNormal() unfolds it
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, VERTEX_SIZE, (void*)offsetof(PackedVertex, position));
+    glVertexAttribPointer(1, 2, GL_BYTE, GL_TRUE, VERTEX_SIZE, (void*)offsetof(PackedVertex, normal));
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)offsetof(PackedVertex, texCoords));
+#else
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)(6 * sizeof(float)));
+#endif
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+}
+
+const MeshRange& MeshArena::getRange(MeshId mesh) const
+{
+    return ranges[mesh];
+}
+
+const AABB& MeshArena::getBounds(MeshId mesh) const
+{
+    // The float bounds: the snorm16 rounding is far below anything culling
+    // or picking would notice
+    return bounds[mesh];
+}
+
+float MeshArena::getPositionScale(MeshId mesh) const
+{
+    return positionScales[mesh];
+}
+
+glm::mat4 MeshArena::getDrawModel(MeshId mesh, const glm::mat4& model) const
+{
+    float scale = positionScales[mesh];
+    if (scale == 1.0f)
+        return model;
+    glm::mat4 drawModel = model;
+    drawModel[0] *= scale;
+    drawModel[1] *= scale;
+    drawModel[2] *= scale;
+    return drawModel;
+}
+
+int MeshArena::getMeshCount() const
+{
+    return Mesh::TYPE_COUNT + (int)prototypeVertices.size();
+}
+
+GLuint MeshArena::getVertexBuffer() const
+{
+    return vertexBuffer;
+}
+
+GLuint MeshArena::getIndexBuffer() const
+{
+    return indexBuffer;
+}
+
+int MeshArena::getVertexCount() const
+{
+    return vertexCount;
+}
+
+int MeshArena::getIndexCount() const
+{
+    return indexCount;
+}
@@ -0,0 +1,83 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "Frustum.h"
+#include "VertexFormat.h"
+
+// A mesh in the arena: a Mesh::Type, or a prototype from addPrototype()
+typedef int MeshId;
+
+// Location of one mesh inside the shared buffers
+struct MeshRange {
+    GLuint firstIndex;
+    GLuint indexCount;
+    GLint baseVertex;
+};
+
+// Packs every Mesh::Type, followed by the prototypes added before build(),
+// into one vertex buffer and one index buffer.
+// Duplicate vertices of the non-indexed Mesh data are welded, and each mesh
+// is addressed by its index range plus a base vertex, which is exactly
+// what indexed/indirect draws need. Vertices are stored in the layout
+// chosen by VertexFormat.h.
+//
+// Packed positions are stored divided by a per-mesh scale (see
+// VertexFormat::positionScale), so the matrix handed to the shader must be
+// getDrawModel(mesh, model). Meshes within [-1, 1] have a scale of 1, which
+// is why the fixed cube/plane/sphere draws can pass their model as is.
+class MeshArena
+{
+public:
+    static const int VERTEX_SIZE = VertexFormat::VERTEX_SIZE;
+
+    MeshArena();
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // Bake the parts into one mesh (Mesh::BuildPrototype) that build() will
+    // pack after the Mesh::Types. The name is only for the build log.
+    MeshId addPrototype(const char* name, const std::vector<Mesh::PrototypePart>& parts);
+
+    void build();
+    void release();
+
+    // Points attributes 0-2 (position, normal, UV) of the bound VAO at the
+    // vertex buffer and binds the index buffer to it
+    void bindVertexAttributes() const;
+
+    // The same attribute layout over whatever GL_ARRAY_BUFFER is bound, for
+    // other buffers holding VertexFormat vertices (CookedModel)
+    static void setVertexAttributes();
+
+    const MeshRange& getRange(MeshId mesh) const;
+    const AABB& getBounds(MeshId mesh) const;   // object space
+    float getPositionScale(MeshId mesh) const;
+
+    // model with the mesh's position scale folded in; culling and picking
+    // keep using model and getBounds()
+    glm::mat4 getDrawModel(MeshId mesh, const glm::mat4& model) const;
+    int getMeshCount() const;        // Mesh::Types and prototypes
+    GLuint getVertexBuffer() const;
+    GLuint getIndexBuffer() const;
+    int getVertexCount() const;      // after welding, all meshes
+    int getIndexCount() const;
+
+private:
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    int vertexCount;
+    int indexCount;
+    std::vector<MeshRange> ranges;
+    std::vector<float> positionScales;
+    std::vector<AABB> bounds;
+    std::vector<std::string> prototypeNames;
+    std::vector<std::vector<float>> prototypeVertices;
+};
+
+#endif
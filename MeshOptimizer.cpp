@@ -0,0 +1,277 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Forsyth's scoring constants, from "Linear-Speed Vertex Cache Optimisation"
+    const int SCORE_CACHE_SIZE = 32;
+    const float CACHE_DECAY_POWER = 1.5f;
+    const float LAST_TRIANGLE_SCORE = 0.75f;
+    const float VALENCE_BOOST_SCALE = 2.0f;
+    const float VALENCE_BOOST_POWER = 0.5f;
+
+    float vertexScore(int cachePosition, int remainingTriangles)
+    {
+        if (remainingTriangles == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // The last triangle's vertices get a fixed score so the next
+            // triangle does not simply reuse its edge every time
+            if (cachePosition < 3)
+                score = LAST_TRIANGLE_SCORE;
+            else
+                score = std::pow(1.0f - (float)(cachePosition - 3) / (SCORE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+
+        // Favour vertices with few triangles left so they are finished and
+        // leave the cache for good
+        return score + VALENCE_BOOST_SCALE * std::pow((float)remainingTriangles, -VALENCE_BOOST_POWER);
+    }
+
+    // FIFO cache simulation with per-vertex timestamps: a vertex is cached
+    // while fewer than CACHE_SIZE misses happened since it was loaded
+    struct FifoCache {
+        std::vector<int> timestamps;
+        int misses;
+
+        explicit FifoCache(int vertexCount)
+            : timestamps(vertexCount, -MeshOptimizer::CACHE_SIZE - 1), misses(0)
+        {
+        }
+
+        bool access(GLuint vertex)
+        {
+            if (misses - timestamps[vertex] < MeshOptimizer::CACHE_SIZE)
+                return true;
+            timestamps[vertex] = ++misses;
+            return false;
+        }
+    };
+
+    struct Cluster {
+        int firstTriangle;
+        int triangleCount;
+        float sortKey;
+    };
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<GLuint>& indices, int vertexCount)
+{
+    int triangleCount = (int)indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Triangles of each vertex, as ranges into one array
+    std::vector<int> remaining(vertexCount, 0);
+    for (GLuint index : indices)
+        remaining[index]++;
+
+    std::vector<int> adjacencyOffsets(vertexCount + 1, 0);
+    for (int v = 0; v < vertexCount; v++)
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remaining[v];
+
+    std::vector<int> adjacency(indices.size());
+    std::vector<int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (int t = 0; t < triangleCount; t++)
+    {
+        for (int corner = 0; corner < 3; corner++)
+            adjacency[fill[indices[t * 3 + corner]]++] = t;
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (int v = 0; v < vertexCount; v++)
+        vertexScores[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    for (int t = 0; t < triangleCount; t++)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+            vertexScores[indices[t * 3 + 2]];
+    }
+
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+
+    std::vector<GLuint> cache;
+    std::vector<GLuint> newCache;
+    cache.reserve(SCORE_CACHE_SIZE + 3);
+    newCache.reserve(SCORE_CACHE_SIZE + 3);
+
+    int bestTriangle = 0;
+    int scanCursor = 0;
+    for (int emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+    {
+        if (bestTriangle < 0)
+        {
+            // Nothing in the cache touches an unemitted triangle: take the next one in input order
+            while (emitted[scanCursor])
+                scanCursor++;
+            bestTriangle = scanCursor;
+        }
+
+        const GLuint* triangle = &indices[bestTriangle * 3];
+        result.insert(result.end(), triangle, triangle + 3);
+        emitted[bestTriangle] = 1;
+
+        // The triangle's vertices go to the front of the cache, the rest shift back
+        newCache.assign(triangle, triangle + 3);
+        for (GLuint vertex : cache)
+        {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                newCache.push_back(vertex);
+        }
+
+        for (int corner = 0; corner < 3; corner++)
+        {
+            GLuint vertex = triangle[corner];
+            int first = adjacencyOffsets[vertex];
+            int last = first + remaining[vertex];
+            for (int i = first; i < last; i++)
+            {
+                if (adjacency[i] == bestTriangle)
+                {
+                    std::swap(adjacency[i], adjacency[last - 1]);
+                    break;
+                }
+            }
+            remaining[vertex]--;
+        }
+
+        // Rescore everything that was or is cached, and pick the best
+        // triangle among the ones they touch
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            GLuint vertex = newCache[i];
+            cachePositions[vertex] = i < SCORE_CACHE_SIZE ? (int)i : -1;
+        }
+
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (GLuint vertex : newCache)
+        {
+            float score = vertexScore(cachePositions[vertex], remaining[vertex]);
+            float delta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+
+            int first = adjacencyOffsets[vertex];
+            for (int i = first; i < first + remaining[vertex]; i++)
+            {
+                int t = adjacency[i];
+                triangleScores[t] += delta;
+                if (triangleScores[t] > bestScore)
+                {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        if (newCache.size() > SCORE_CACHE_SIZE)
+            newCache.resize(SCORE_CACHE_SIZE);
+        cache.swap(newCache);
+    }
+
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<GLuint>& indices, const std::vector<glm::vec3>& positions)
+{
+    int triangleCount = (int)indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Cut where a triangle misses the cache on all three vertices: the cache
+    // order has started over there, so reordering clusters costs no locality
+    std::vector<Cluster> clusters;
+    FifoCache cache((int)positions.size());
+    for (int t = 0; t < triangleCount; t++)
+    {
+        int hits = 0;
+        for (int corner = 0; corner < 3; corner++)
+            hits += cache.access(indices[t * 3 + corner]) ? 1 : 0;
+        if (hits == 0 || clusters.empty())
+            clusters.push_back(Cluster{ t, 0, 0.0f });
+        clusters.back().triangleCount++;
+    }
+    if (clusters.size() < 2)
+        return;
+
+    glm::vec3 meshCentroid(0.0f);
+    for (GLuint index : indices)
+        meshCentroid += positions[index];
+    meshCentroid /= (float)indices.size();
+
+    // Clusters facing away from the mesh centre are the ones that occlude the rest
+    for (Cluster& cluster : clusters)
+    {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (int t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount; t++)
+        {
+            const glm::vec3& a = positions[indices[t * 3]];
+            const glm::vec3& b = positions[indices[t * 3 + 1]];
+            const glm::vec3& c = positions[indices[t * 3 + 2]];
+            glm::vec3 weighted = glm::cross(b - a, c - a);
+            float triangleArea = glm::length(weighted);
+            centroid += (a + b + c) * (triangleArea / 3.0f);
+            normal += weighted;
+            area += triangleArea;
+        }
+        float normalLength = glm::length(normal);
+        if (area > 0.0f && normalLength > 0.0f)
+            cluster.sortKey = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters)
+    {
+        result.insert(result.end(), indices.begin() + cluster.firstTriangle * 3,
+            indices.begin() + (cluster.firstTriangle + cluster.triangleCount) * 3);
+    }
+    indices.swap(result);
+}
+
+std::vector<GLuint> MeshOptimizer::optimizeVertexFetch(std::vector<GLuint>& indices, int vertexCount)
+{
+    const GLuint UNUSED = ~0u;
+    std::vector<GLuint> newIndex(vertexCount, UNUSED);
+    std::vector<GLuint> remap;
+    remap.reserve(vertexCount);
+
+    for (GLuint& index : indices)
+    {
+        if (newIndex[index] == UNUSED)
+        {
+            newIndex[index] = (GLuint)remap.size();
+            remap.push_back(index);
+        }
+        index = newIndex[index];
+    }
+    return remap;
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const std::vector<GLuint>& indices, int vertexCount)
+{
+    VertexCacheStats stats = { 0.0f, 0.0f };
+    if (indices.empty() || vertexCount == 0)
+        return stats;
+
+    FifoCache cache(vertexCount);
+    for (GLuint index : indices)
+        cache.access(index);
+
+    stats.acmr = (float)cache.misses / (indices.size() / 3);
+    stats.atvr = (float)cache.misses / vertexCount;
+    return stats;
+}
@@ -0,0 +1,40 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Post-transform vertex cache efficiency of an index list, from a FIFO
+// simulation. ACMR is cache misses per triangle (0.5 is the ideal for a
+// regular grid, 3 the worst); ATVR is misses per unique vertex (1 is ideal).
+struct VertexCacheStats {
+    float acmr;
+    float atvr;
+};
+
+// Reorders indexed triangle lists for the GPU, in the order the passes are
+// meant to run:
+//   1. optimizeVertexCache: Forsyth's greedy ordering, emitting next the
+//      triangle whose vertices score highest (recently used, few remaining
+//      triangles), so shared vertices are still cached when reused.
+//   2. optimizeOverdraw: cuts the result into clusters where the cache
+//      starts over and sorts the clusters so outward-facing ones come first,
+//      letting the depth test reject more of what is drawn after them.
+//   3. optimizeVertexFetch: renumbers vertices in first-use order so vertex
+//      reads walk the buffer forwards.
+class MeshOptimizer
+{
+public:
+    static const int CACHE_SIZE = 16;      // FIFO size for analyzeVertexCache
+
+    static void optimizeVertexCache(std::vector<GLuint>& indices, int vertexCount);
+    static void optimizeOverdraw(std::vector<GLuint>& indices, const std::vector<glm::vec3>& positions);
+
+    // Rewrites the indices and returns the remap: new vertex i is old vertex remap[i]
+    static std::vector<GLuint> optimizeVertexFetch(std::vector<GLuint>& indices, int vertexCount);
+
+    static VertexCacheStats analyzeVertexCache(const std::vector<GLuint>& indices, int vertexCount);
+};
+
+#endif
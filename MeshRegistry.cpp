@@ -0,0 +1,58 @@
+#include "MeshRegistry.h"
+
+namespace {
+    MeshArena* arena = nullptr;
+    GLuint vao = 0;
+}
+
+MeshId MeshRegistry::addPrototype(const char* name, const std::vector<Mesh::PrototypePart>& parts)
+{
+    if (!arena)
+        arena = new MeshArena();
+    return arena->addPrototype(name, parts);
+}
+
+void MeshRegistry::init()
+{
+    if (vao)
+        return;
+
+    if (!arena)
+        arena = new MeshArena();
+    arena->build();
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    arena->bindVertexAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MeshRegistry::release()
+{
+    if (!arena)
+        return;
+
+    glDeleteVertexArrays(1, &vao);
+    vao = 0;
+    delete arena;
+    arena = nullptr;
+}
+
+const MeshArena& MeshRegistry::getArena()
+{
+    return *arena;
+}
+
+GLuint MeshRegistry::getVAO()
+{
+    return vao;
+}
+
+void MeshRegistry::draw(MeshId mesh)
+{
+    const MeshRange& range = arena->getRange(mesh);
+    glBindVertexArray(vao);
+    glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+        (void*)(range.firstIndex * sizeof(GLuint)), range.baseVertex);
+}
@@ -0,0 +1,34 @@
+#ifndef MESH_REGISTRY_H
+#define MESH_REGISTRY_H
+
+#include <glad/glad.h>
+#include "mesh.h"
+#include "MeshArena.h"
+
+// Every Mesh::Type uploaded once into the shared MeshArena buffers, behind a
+// single VAO with the arena vertex layout. Draws address a mesh by its
+// index range and base vertex, so going from cubes to cylinders to planes
+// never changes the bound VAO or buffers. Meshes are taken from the enum: a
+// new Mesh::Type is registered by adding it before Mesh::TYPE_COUNT and
+// returning its vertices from Mesh::GetVertices. Objects built from several
+// primitives are added with addPrototype() before init().
+class MeshRegistry
+{
+public:
+    // Queue a prototype mesh for the arena (MeshArena::addPrototype). Only
+    // before init(); the returned ID is valid once init() has run.
+    static MeshId addPrototype(const char* name, const std::vector<Mesh::PrototypePart>& parts);
+
+    // Build the arena and the VAO. Call once after gladLoadGL().
+    static void init();
+    static void release();
+
+    static const MeshArena& getArena();
+    static GLuint getVAO();
+
+    // Draw one mesh with the current shader and its "model" uniform already
+    // set. Binds the shared VAO, which is the same for every mesh.
+    static void draw(MeshId mesh);
+};
+
+#endif
@@ -0,0 +1,237 @@
+#include "MeshletMesh.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int FLOATS_PER_VERTEX = 8;
+
+    // Below this the normals spread over more than ~84 degrees and the cone
+    // would almost never reject anything
+    const float MIN_CONE_SPREAD = 0.1f;
+}
+
+MeshletMesh::MeshletMesh()
+    : bounds{ glm::vec3(0.0f), glm::vec3(0.0f) }, lastVisibleCount(0), lastConeCulledCount(0)
+{
+}
+
+void MeshletMesh::build(const std::vector<float>& vertices, const std::vector<GLuint>& sourceIndices)
+{
+    meshlets.clear();
+    indices = sourceIndices;
+
+    int vertexCount = (int)vertices.size() / FLOATS_PER_VERTEX;
+    std::vector<glm::vec3> positions(vertexCount);
+    for (int v = 0; v < vertexCount; v++)
+    {
+        const float* vertex = &vertices[v * FLOATS_PER_VERTEX];
+        positions[v] = glm::vec3(vertex[0], vertex[1], vertex[2]);
+    }
+
+    bounds.minCorner = glm::vec3(vertexCount > 0 ? 1e30f : 0.0f);
+    bounds.maxCorner = glm::vec3(vertexCount > 0 ? -1e30f : 0.0f);
+    for (const glm::vec3& position : positions)
+    {
+        bounds.minCorner = glm::min(bounds.minCorner, position);
+        bounds.maxCorner = glm::max(bounds.maxCorner, position);
+    }
+
+    // Cache order keeps consecutive triangles close, which is what makes
+    // the greedy cut below produce compact meshlets
+    MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+
+    // lastMeshlet[v] == meshlets.size() while v is already in the open meshlet
+    std::vector<int> lastMeshlet(vertexCount, -1);
+    Meshlet current = {};
+    int triangleCount = (int)indices.size() / 3;
+    for (int t = 0; t < triangleCount; t++)
+    {
+        const GLuint* triangle = &indices[t * 3];
+        int currentId = (int)meshlets.size();
+        int newVertices = 0;
+        for (int corner = 0; corner < 3; corner++)
+            newVertices += lastMeshlet[triangle[corner]] == currentId ? 0 : 1;
+
+        if (current.vertexCount + newVertices > MAX_VERTICES ||
+            (int)current.indexCount / 3 + 1 > MAX_TRIANGLES)
+        {
+            finishMeshlet(current, positions);
+            current = Meshlet();
+            current.firstIndex = (GLuint)(t * 3);
+            currentId = (int)meshlets.size();
+        }
+
+        for (int corner = 0; corner < 3; corner++)
+        {
+            if (lastMeshlet[triangle[corner]] != currentId)
+            {
+                lastMeshlet[triangle[corner]] = currentId;
+                current.vertexCount++;
+            }
+        }
+        current.indexCount += 3;
+    }
+    if (current.indexCount > 0)
+        finishMeshlet(current, positions);
+}
+
+void MeshletMesh::setMeshlets(const std::vector<Meshlet>& cookedMeshlets, const AABB& meshBounds)
+{
+    meshlets = cookedMeshlets;
+    indices.clear();
+    bounds = meshBounds;
+}
+
+void MeshletMesh::finishMeshlet(Meshlet& meshlet, const std::vector<glm::vec3>& positions)
+{
+    GLuint end = meshlet.firstIndex + meshlet.indexCount;
+
+    meshlet.bounds.minCorner = glm::vec3(1e30f);
+    meshlet.bounds.maxCorner = glm::vec3(-1e30f);
+    for (GLuint i = meshlet.firstIndex; i < end; i++)
+    {
+        meshlet.bounds.minCorner = glm::min(meshlet.bounds.minCorner, positions[indices[i]]);
+        meshlet.bounds.maxCorner = glm::max(meshlet.bounds.maxCorner, positions[indices[i]]);
+    }
+
+    glm::vec3 center = (meshlet.bounds.minCorner + meshlet.bounds.maxCorner) * 0.5f;
+    float radiusSquared = 0.0f;
+    for (GLuint i = meshlet.firstIndex; i < end; i++)
+    {
+        glm::vec3 offset = positions[indices[i]] - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    meshlet.sphere.center = center;
+    meshlet.sphere.radius = std::sqrt(radiusSquared);
+
+    // Normal cone: the axis averages the face normals and the spread is the
+    // least aligned of them. Degenerate triangles face nowhere and are skipped.
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.indexCount / 3);
+    glm::vec3 axis(0.0f);
+    for (GLuint i = meshlet.firstIndex; i < end; i += 3)
+    {
+        const glm::vec3& a = positions[indices[i]];
+        glm::vec3 normal = glm::cross(positions[indices[i + 1]] - a, positions[indices[i + 2]] - a);
+        float length = glm::length(normal);
+        if (length > 0.0f)
+        {
+            normals.push_back(normal / length);
+            axis += normal / length;
+        }
+        else
+        {
+            normals.push_back(glm::vec3(0.0f));
+        }
+    }
+
+    meshlet.coneApex = center;
+    meshlet.coneAxis = glm::vec3(0.0f, 1.0f, 0.0f);
+    meshlet.coneCutoff = 1.0f;
+
+    float axisLength = glm::length(axis);
+    if (axisLength == 0.0f)
+    {
+        meshlets.push_back(meshlet);
+        return;
+    }
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals)
+    {
+        if (normal != glm::vec3(0.0f))
+            minDot = std::min(minDot, glm::dot(axis, normal));
+    }
+
+    if (minDot > MIN_CONE_SPREAD)
+    {
+        // Move the apex back along the axis until every triangle's plane is
+        // in front of it; from behind all of them, every one is back-facing
+        float maxT = 0.0f;
+        for (GLuint i = meshlet.firstIndex, n = 0; i < end; i += 3, n++)
+        {
+            if (normals[n] == glm::vec3(0.0f))
+                continue;
+            float t = glm::dot(center - positions[indices[i]], normals[n]) / glm::dot(axis, normals[n]);
+            maxT = std::max(maxT, t);
+        }
+        meshlet.coneApex = center - axis * maxT;
+        meshlet.coneAxis = axis;
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+    meshlets.push_back(meshlet);
+}
+
+void MeshletMesh::cull(const Frustum& frustum, const glm::mat4& model, const glm::vec3& cameraPosition,
+    std::vector<MeshletRange>& ranges) const
+{
+    ranges.clear();
+    lastVisibleCount = 0;
+    lastConeCulledCount = 0;
+
+    float scaleX = glm::length(glm::vec3(model[0]));
+    float scaleY = glm::length(glm::vec3(model[1]));
+    float scaleZ = glm::length(glm::vec3(model[2]));
+    float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
+
+    // Cones survive rotation and uniform scale only; a squashed mesh keeps
+    // its spheres but skips the cone test
+    float minScale = std::min(scaleX, std::min(scaleY, scaleZ));
+    bool conesValid = maxScale - minScale <= maxScale * 1e-3f;
+    glm::mat3 rotation = glm::mat3(model) / (maxScale > 0.0f ? maxScale : 1.0f);
+
+    for (const Meshlet& meshlet : meshlets)
+    {
+        BoundingSphere world;
+        world.center = glm::vec3(model * glm::vec4(meshlet.sphere.center, 1.0f));
+        world.radius = meshlet.sphere.radius * maxScale;
+        if (!frustum.intersects(world))
+            continue;
+
+        if (conesValid && meshlet.coneCutoff < 1.0f)
+        {
+            glm::vec3 apex = glm::vec3(model * glm::vec4(meshlet.coneApex, 1.0f));
+            glm::vec3 axis = rotation * meshlet.coneAxis;
+            glm::vec3 toApex = apex - cameraPosition;
+            float distance = glm::length(toApex);
+            if (distance > 0.0f && glm::dot(toApex / distance, axis) >= meshlet.coneCutoff)
+            {
+                lastConeCulledCount++;
+                continue;
+            }
+        }
+
+        lastVisibleCount++;
+        if (!ranges.empty() && ranges.back().firstIndex + ranges.back().indexCount == meshlet.firstIndex)
+            ranges.back().indexCount += meshlet.indexCount;
+        else
+            ranges.push_back(MeshletRange{ meshlet.firstIndex, meshlet.indexCount });
+    }
+}
+
+const std::vector<Meshlet>& MeshletMesh::getMeshlets() const
+{
+    return meshlets;
+}
+
+const std::vector<GLuint>& MeshletMesh::getIndices() const
+{
+    return indices;
+}
+
+const AABB& MeshletMesh::getBounds() const
+{
+    return bounds;
+}
+
+int MeshletMesh::getLastVisibleCount() const
+{
+    return lastVisibleCount;
+}
+
+int MeshletMesh::getLastConeCulledCount() const
+{
+    return lastConeCulledCount;
+}
@@ -0,0 +1,71 @@
+#ifndef MESHLET_MESH_H
+#define MESHLET_MESH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "Frustum.h"
+
+// One cluster of at most MAX_VERTICES vertices and MAX_TRIANGLES triangles,
+// stored as a contiguous index range of the mesh
+struct Meshlet {
+    GLuint firstIndex;
+    GLuint indexCount;
+    int vertexCount;            // distinct vertices the triangles use
+    BoundingSphere sphere;      // object space
+    AABB bounds;
+    glm::vec3 coneApex;         // A camera in the cone opening from the apex
+    glm::vec3 coneAxis;         // along -coneAxis sees only back faces
+    float coneCutoff;           // Cosine of that cone's half-angle; 1: never culled
+};
+
+// Contiguous run of visible meshlets: one draw call
+struct MeshletRange {
+    GLuint firstIndex;
+    GLuint indexCount;
+};
+
+// A large indexed triangle mesh split into meshlets for CPU culling. The
+// triangles are put in vertex-cache order and then cut greedily whenever the
+// next triangle would break a meshlet limit, so a meshlet is a compact patch
+// of surface. cull() tests each meshlet's sphere against the frustum and its
+// normal cone against the camera position, and merges neighbouring
+// survivors into ranges, so a mostly visible mesh is still a few draws.
+class MeshletMesh
+{
+public:
+    static const int MAX_VERTICES = 64;
+    static const int MAX_TRIANGLES = 124;
+
+    MeshletMesh();
+
+    // vertices: 8 floats each (position, normal, UV), as Mesh uses.
+    // Reorders the triangles; read the result back with getIndices().
+    void build(const std::vector<float>& vertices, const std::vector<GLuint>& indices);
+
+    // Meshlets built offline (CookedModel). Their index ranges point into an
+    // index buffer the caller owns, so getIndices() stays empty.
+    void setMeshlets(const std::vector<Meshlet>& cookedMeshlets, const AABB& meshBounds);
+
+    // Object-space meshlets against a world-space frustum and camera
+    void cull(const Frustum& frustum, const glm::mat4& model, const glm::vec3& cameraPosition,
+        std::vector<MeshletRange>& ranges) const;
+
+    const std::vector<Meshlet>& getMeshlets() const;
+    const std::vector<GLuint>& getIndices() const;   // meshlet order
+    const AABB& getBounds() const;
+
+    int getLastVisibleCount() const;                  // meshlets kept by the last cull()
+    int getLastConeCulledCount() const;               // of those rejected, by their cone
+
+private:
+    void finishMeshlet(Meshlet& meshlet, const std::vector<glm::vec3>& positions);
+
+    std::vector<Meshlet> meshlets;
+    std::vector<GLuint> indices;
+    AABB bounds;
+    mutable int lastVisibleCount;
+    mutable int lastConeCulledCount;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "OcclusionQueries.h"
+#include "GLCaps.h"
+#include "config_culling.h"
+#include <algorithm>
+
+// Boxes grow slightly so they never sit exactly on the geometry they enclose
+static const float BOX_MARGIN = 0.05f;
+
+// Boxes this close to the eye may be clipped by the near plane and report
+// hidden, so those groups are drawn unconditionally instead
+static const float NEAR_MARGIN = 0.5f;
+
+static const float unitCubeVertices[] = {
+    0.0f, 0.0f, 0.0f,   1.0f, 0.0f, 0.0f,   1.0f, 1.0f, 0.0f,   0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 1.0f,   1.0f, 0.0f, 1.0f,   1.0f, 1.0f, 1.0f,   0.0f, 1.0f, 1.0f
+};
+
+static const GLubyte unitCubeIndices[] = {
+    0, 1, 2,  2, 3, 0,     // back
+    4, 6, 5,  6, 4, 7,     // front
+    0, 3, 7,  7, 4, 0,     // left
+    1, 5, 6,  6, 2, 1,     // right
+    0, 4, 5,  5, 1, 0,     // bottom
+    3, 2, 6,  6, 7, 3      // top
+};
+
+OcclusionQueries::OcclusionQueries(int groupCount)
+    : boxShader(occlusionBoxVertexShaderSource, occlusionBoxFragmentShaderSource),
+      boxVAO(0), boxVBO(0), boxEBO(0),
+      queryTarget(GLCaps::hasConservativeOcclusionQueries() ? GL_ANY_SAMPLES_PASSED_CONSERVATIVE : GL_ANY_SAMPLES_PASSED),
+      groups(std::max(groupCount, 1))
+{
+    for (Group& group : groups)
+    {
+        glGenQueries(1, &group.query);
+        group.hasBounds = false;
+        group.issued = false;
+        group.conditional = false;
+    }
+
+    glGenVertexArrays(1, &boxVAO);
+    glGenBuffers(1, &boxVBO);
+    glGenBuffers(1, &boxEBO);
+
+    glBindVertexArray(boxVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, boxVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(unitCubeVertices), unitCubeVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, boxEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unitCubeIndices), unitCubeIndices, GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+OcclusionQueries::~OcclusionQueries()
+{
+    release();
+}
+
+void OcclusionQueries::beginFrame()
+{
+    for (Group& group : groups)
+        group.hasBounds = false;
+}
+
+void OcclusionQueries::addBounds(int group, const AABB& worldBounds)
+{
+    if (group <= NO_GROUP || group >= (int)groups.size())
+        return;
+
+    Group& target = groups[group];
+    if (!target.hasBounds)
+    {
+        target.bounds = worldBounds;
+        target.hasBounds = true;
+        return;
+    }
+    target.bounds.minCorner = glm::min(target.bounds.minCorner, worldBounds.minCorner);
+    target.bounds.maxCorner = glm::max(target.bounds.maxCorner, worldBounds.maxCorner);
+}
+
+void OcclusionQueries::beginConditional(int group)
+{
+    if (group <= NO_GROUP || group >= (int)groups.size() || !groups[group].issued)
+        return;
+
+    glBeginConditionalRender(groups[group].query, GL_QUERY_NO_WAIT);
+    groups[group].conditional = true;
+}
+
+void OcclusionQueries::endConditional(int group)
+{
+    if (group <= NO_GROUP || group >= (int)groups.size() || !groups[group].conditional)
+        return;
+
+    glEndConditionalRender();
+    groups[group].conditional = false;
+}
+
+void OcclusionQueries::issue(const glm::mat4& viewProjection, const glm::vec3& viewPos)
+{
+    boxShader.use();
+    boxShader.setMat4("viewProjection", viewProjection);
+    glBindVertexArray(boxVAO);
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+
+    for (size_t i = 1; i < groups.size(); i++)
+    {
+        Group& group = groups[i];
+        group.issued = false;
+        if (!group.hasBounds)
+            continue;
+
+        glm::vec3 boxMin = group.bounds.minCorner - glm::vec3(BOX_MARGIN);
+        glm::vec3 boxMax = group.bounds.maxCorner + glm::vec3(BOX_MARGIN);
+        if (glm::all(glm::greaterThan(viewPos, boxMin - glm::vec3(NEAR_MARGIN))) &&
+            glm::all(glm::lessThan(viewPos, boxMax + glm::vec3(NEAR_MARGIN))))
+            continue;
+
+        boxShader.setVec3("boxMin", boxMin);
+        boxShader.setVec3("boxMax", boxMax);
+        glBeginQuery(queryTarget, group.query);
+        glDrawElements(GL_TRIANGLES, sizeof(unitCubeIndices), GL_UNSIGNED_BYTE, (void*)0);
+        glEndQuery(queryTarget);
+        group.issued = true;
+    }
+
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glBindVertexArray(0);
+}
+
+int OcclusionQueries::getGroupCount() const
+{
+    return (int)groups.size();
+}
+
+void OcclusionQueries::release()
+{
+    if (boxVAO)
+    {
+        for (Group& group : groups)
+        {
+            glDeleteQueries(1, &group.query);
+            group.query = 0;
+            group.issued = false;
+        }
+        glDeleteVertexArrays(1, &boxVAO);
+        glDeleteBuffers(1, &boxVBO);
+        glDeleteBuffers(1, &boxEBO);
+        boxVAO = 0;
+        boxVBO = 0;
+        boxEBO = 0;
+    }
+    boxShader.deleteProgram();
+}
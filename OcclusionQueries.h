@@ -0,0 +1,60 @@
+#ifndef OCCLUSION_QUERIES_H
+#define OCCLUSION_QUERIES_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "Frustum.h"
+#include "shader.h"
+
+// Hardware occlusion queries for whole object groups (a desk row, the room's
+// fixtures). After the scene is drawn, each group's bounding box is
+// rasterised against the depth buffer inside a query, with color and depth
+// writes off. Next frame the group is drawn under glBeginConditionalRender
+// with GL_QUERY_NO_WAIT: the GPU skips it if the box was hidden, and the CPU
+// never waits for a result (an unfinished query simply draws the group).
+// Group 0 is never tested.
+class OcclusionQueries
+{
+public:
+    static const int NO_GROUP = 0;
+
+    // Valid groups are 1 .. groupCount - 1
+    explicit OcclusionQueries(int groupCount);
+    ~OcclusionQueries();
+
+    OcclusionQueries(const OcclusionQueries&) = delete;
+    OcclusionQueries& operator=(const OcclusionQueries&) = delete;
+
+    // Group bounds are rebuilt every frame from what was submitted
+    void beginFrame();
+    void addBounds(int group, const AABB& worldBounds);
+
+    // Wrap a group's draws; no-ops when the group has no usable result
+    void beginConditional(int group);
+    void endConditional(int group);
+
+    // Query every non-empty group against the current depth buffer
+    void issue(const glm::mat4& viewProjection, const glm::vec3& viewPos);
+
+    int getGroupCount() const;
+    void release();
+
+private:
+    struct Group {
+        GLuint query;
+        AABB bounds;
+        bool hasBounds;
+        bool issued;        // query holds a result for the last frame
+        bool conditional;   // inside beginConditional()
+    };
+
+    Shader boxShader;
+    GLuint boxVAO;
+    GLuint boxVBO;
+    GLuint boxEBO;
+    GLenum queryTarget;
+    std::vector<Group> groups;
+};
+
+#endif
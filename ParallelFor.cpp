@@ -0,0 +1,29 @@
+#include "ParallelFor.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+void parallelFor(int count, int minChunk, const std::function<void(int, int)>& body)
+{
+    if (count <= 0)
+        return;
+
+    int hardwareThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    int threadCount = std::min(hardwareThreads, count / std::max(1, minChunk));
+    if (threadCount <= 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // The caller takes the first chunk instead of waiting idle
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    int chunk = (count + threadCount - 1) / threadCount;
+    for (int begin = chunk; begin < count; begin += chunk)
+        workers.emplace_back(body, begin, std::min(count, begin + chunk));
+    body(0, std::min(count, chunk));
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
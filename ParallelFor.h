@@ -0,0 +1,12 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <functional>
+
+// Runs body(begin, end) over contiguous chunks of [0, count), one chunk per
+// hardware thread, and returns once all of them are done. Ranges too small
+// to give every thread at least minChunk items use fewer threads, down to
+// running inline on the caller, so small inputs pay no thread start-up.
+void parallelFor(int count, int minChunk, const std::function<void(int, int)>& body);
+
+#endif
@@ -0,0 +1,207 @@
+#include "PortalGraph.h"
+#include <algorithm>
+
+// Long enough for any chain of rooms in this scene; stops runaway walks
+static const int MAX_DEPTH = 8;
+
+// A camera this close to an opening may have it clipped away by the near
+// plane, so the opening is treated as covering the whole view
+static const float PORTAL_MARGIN = 0.5f;
+
+static bool containsPoint(const AABB& box, const glm::vec3& point)
+{
+    return glm::all(glm::greaterThanEqual(point, box.minCorner)) &&
+           glm::all(glm::lessThanEqual(point, box.maxCorner));
+}
+
+PortalGraph::PortalGraph()
+    : exteriorCell(NO_CELL), cameraCell(NO_CELL), viewProjection(1.0f), viewPos(0.0f)
+{
+}
+
+int PortalGraph::addCell(const AABB& bounds)
+{
+    Cell cell;
+    cell.bounds = bounds;
+    cell.visible = true;
+    cell.rect.minCorner = glm::vec2(-1.0f);
+    cell.rect.maxCorner = glm::vec2(1.0f);
+    cells.push_back(cell);
+    onPath.push_back(false);
+    return (int)cells.size() - 1;
+}
+
+void PortalGraph::setExteriorCell(int cell)
+{
+    exteriorCell = cell;
+}
+
+int PortalGraph::addPortal(int cellA, int cellB, const glm::vec3& c0, const glm::vec3& c1,
+    const glm::vec3& c2, const glm::vec3& c3)
+{
+    Portal portal;
+    portal.cells[0] = cellA;
+    portal.cells[1] = cellB;
+    portal.corners[0] = c0;
+    portal.corners[1] = c1;
+    portal.corners[2] = c2;
+    portal.corners[3] = c3;
+    portal.open = true;
+    portals.push_back(portal);
+
+    int index = (int)portals.size() - 1;
+    cells[cellA].portals.push_back(index);
+    cells[cellB].portals.push_back(index);
+    return index;
+}
+
+void PortalGraph::setPortalOpen(int portal, bool open)
+{
+    portals[portal].open = open;
+}
+
+void PortalGraph::update(const glm::mat4& newViewProjection, const glm::vec3& newViewPos)
+{
+    viewProjection = newViewProjection;
+    viewPos = newViewPos;
+    cameraCell = findCell(viewPos);
+
+    PortalRect screen;
+    screen.minCorner = glm::vec2(-1.0f);
+    screen.maxCorner = glm::vec2(1.0f);
+
+    // Outside every cell and no exterior: nothing to reason about, draw it all
+    bool everything = cameraCell == NO_CELL;
+    for (Cell& cell : cells)
+    {
+        cell.visible = everything;
+        cell.rect = screen;
+    }
+    if (!everything)
+        visit(cameraCell, screen, 0);
+}
+
+bool PortalGraph::isCellVisible(int cell) const
+{
+    return cells[cell].visible;
+}
+
+const PortalRect& PortalGraph::getCellRect(int cell) const
+{
+    return cells[cell].rect;
+}
+
+int PortalGraph::getCameraCell() const
+{
+    return cameraCell;
+}
+
+int PortalGraph::getCellCount() const
+{
+    return (int)cells.size();
+}
+
+int PortalGraph::findCell(const glm::vec3& position) const
+{
+    for (int i = 0; i < (int)cells.size(); i++)
+    {
+        if (i != exteriorCell && containsPoint(cells[i].bounds, position))
+            return i;
+    }
+    return exteriorCell;
+}
+
+void PortalGraph::visit(int cellIndex, const PortalRect& rect, int depth)
+{
+    Cell& cell = cells[cellIndex];
+    if (!cell.visible)
+    {
+        cell.visible = true;
+        cell.rect = rect;
+    }
+    else
+    {
+        cell.rect.minCorner = glm::min(cell.rect.minCorner, rect.minCorner);
+        cell.rect.maxCorner = glm::max(cell.rect.maxCorner, rect.maxCorner);
+    }
+
+    if (depth >= MAX_DEPTH)
+        return;
+
+    onPath[cellIndex] = true;
+    for (int portalIndex : cell.portals)
+    {
+        const Portal& portal = portals[portalIndex];
+        if (!portal.open)
+            continue;
+
+        int next = portal.cells[0] == cellIndex ? portal.cells[1] : portal.cells[0];
+        if (onPath[next])
+            continue;
+
+        PortalRect portalRect = rect;
+        if (!isCameraInPortal(portal))
+        {
+            if (!projectPortal(portal, portalRect))
+                continue;
+            portalRect.minCorner = glm::max(portalRect.minCorner, rect.minCorner);
+            portalRect.maxCorner = glm::min(portalRect.maxCorner, rect.maxCorner);
+            if (portalRect.minCorner.x >= portalRect.maxCorner.x ||
+                portalRect.minCorner.y >= portalRect.maxCorner.y)
+                continue;
+        }
+
+        visit(next, portalRect, depth + 1);
+    }
+    onPath[cellIndex] = false;
+}
+
+// Screen bounds of the portal polygon after clipping it to the near plane
+bool PortalGraph::projectPortal(const Portal& portal, PortalRect& rect) const
+{
+    glm::vec4 clip[4];
+    for (int i = 0; i < 4; i++)
+        clip[i] = viewProjection * glm::vec4(portal.corners[i], 1.0f);
+
+    // Sutherland-Hodgman against z >= -w; a quad gains at most one vertex
+    glm::vec4 clipped[5];
+    int count = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        const glm::vec4& a = clip[i];
+        const glm::vec4& b = clip[(i + 1) % 4];
+        float da = a.z + a.w;
+        float db = b.z + b.w;
+
+        if (da >= 0.0f)
+            clipped[count++] = a;
+        if ((da >= 0.0f) != (db >= 0.0f))
+            clipped[count++] = a + (b - a) * (da / (da - db));
+    }
+    if (count == 0)
+        return false;
+
+    rect.minCorner = glm::vec2(1e30f);
+    rect.maxCorner = glm::vec2(-1e30f);
+    for (int i = 0; i < count; i++)
+    {
+        glm::vec2 ndc = glm::vec2(clipped[i]) / std::max(clipped[i].w, 1e-6f);
+        rect.minCorner = glm::min(rect.minCorner, ndc);
+        rect.maxCorner = glm::max(rect.maxCorner, ndc);
+    }
+    return true;
+}
+
+bool PortalGraph::isCameraInPortal(const Portal& portal) const
+{
+    AABB box;
+    box.minCorner = box.maxCorner = portal.corners[0];
+    for (int i = 1; i < 4; i++)
+    {
+        box.minCorner = glm::min(box.minCorner, portal.corners[i]);
+        box.maxCorner = glm::max(box.maxCorner, portal.corners[i]);
+    }
+    box.minCorner -= glm::vec3(PORTAL_MARGIN);
+    box.maxCorner += glm::vec3(PORTAL_MARGIN);
+    return containsPoint(box, viewPos);
+}
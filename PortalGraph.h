@@ -0,0 +1,71 @@
+#ifndef PORTAL_GRAPH_H
+#define PORTAL_GRAPH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include "Frustum.h"
+
+// Screen-space bounds in NDC ([-1, 1] on both axes is the whole viewport)
+struct PortalRect {
+    glm::vec2 minCorner;
+    glm::vec2 maxCorner;
+};
+
+// Cells (rooms) connected by portals (openings). Every frame update() finds
+// the cell holding the camera and walks the graph from it: each portal is
+// projected, clipped against the screen rectangle it was seen through, and
+// the cell behind it is visited with that narrower rectangle. Cells the walk
+// never reaches cannot be seen and their contents can be skipped.
+// One cell may be marked as the exterior: it has no bounds and holds the
+// camera whenever no other cell does.
+class PortalGraph
+{
+public:
+    static const int NO_CELL = -1;
+
+    PortalGraph();
+
+    int addCell(const AABB& bounds);
+    void setExteriorCell(int cell);
+
+    // Corners in order around the opening; portals are two-sided
+    int addPortal(int cellA, int cellB, const glm::vec3& c0, const glm::vec3& c1,
+        const glm::vec3& c2, const glm::vec3& c3);
+    void setPortalOpen(int portal, bool open);
+
+    void update(const glm::mat4& viewProjection, const glm::vec3& viewPos);
+
+    bool isCellVisible(int cell) const;
+    const PortalRect& getCellRect(int cell) const;   // union of all views into it
+    int getCameraCell() const;
+    int getCellCount() const;
+
+private:
+    struct Cell {
+        AABB bounds;
+        std::vector<int> portals;
+        bool visible;
+        PortalRect rect;
+    };
+
+    struct Portal {
+        int cells[2];
+        glm::vec3 corners[4];
+        bool open;
+    };
+
+    int findCell(const glm::vec3& position) const;
+    void visit(int cell, const PortalRect& rect, int depth);
+    bool projectPortal(const Portal& portal, PortalRect& rect) const;
+    bool isCameraInPortal(const Portal& portal) const;
+
+    std::vector<Cell> cells;
+    std::vector<Portal> portals;
+    std::vector<bool> onPath;     // cells on the current walk, to stop cycles
+    int exteriorCell;
+    int cameraCell;
+    glm::mat4 viewProjection;
+    glm::vec3 viewPos;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "PosterBatch.h"
+#include <cstddef>
+
+PosterBatch::PosterBatch(const MeshArena& arena)
+    : vao(0), instanceVBO(0), plane(arena.getRange(Mesh::PLANE)), instanceCount(0)
+{
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &instanceVBO);
+    glBindVertexArray(vao);
+
+    // Per-vertex data from the arena
+    arena.bindVertexAttributes();
+
+    // Per-instance model matrix (one vec4 column per location) and layer
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (int column = 0; column < 4; column++)
+    {
+        GLuint location = 3 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(PosterInstance),
+            (void*)(offsetof(PosterInstance, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    glVertexAttribPointer(7, 1, GL_FLOAT, GL_FALSE, sizeof(PosterInstance), (void*)offsetof(PosterInstance, layer));
+    glEnableVertexAttribArray(7);
+    glVertexAttribDivisor(7, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+PosterBatch::~PosterBatch()
+{
+    release();
+}
+
+void PosterBatch::setInstances(const std::vector<PosterInstance>& instances)
+{
+    instanceCount = (int)instances.size();
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(PosterInstance), instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void PosterBatch::draw() const
+{
+    if (instanceCount == 0)
+        return;
+
+    glBindVertexArray(vao);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, plane.indexCount, GL_UNSIGNED_INT,
+        (void*)(plane.firstIndex * sizeof(GLuint)), instanceCount, plane.baseVertex);
+}
+
+void PosterBatch::release()
+{
+    if (vao)
+    {
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &instanceVBO);
+        vao = 0;
+        instanceVBO = 0;
+    }
+}
+
+int PosterBatch::getInstanceCount() const
+{
+    return instanceCount;
+}
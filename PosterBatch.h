@@ -0,0 +1,40 @@
+#ifndef POSTER_BATCH_H
+#define POSTER_BATCH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "MeshArena.h"
+
+// One poster: its plane transform and the texture-array layer it shows
+struct PosterInstance {
+    glm::mat4 model;
+    float layer;
+};
+
+// Instanced plane geometry for posters. Reads the plane from the shared
+// MeshArena buffers and adds a per-instance buffer (model matrix at locations
+// 3-6, layer at location 7) so every poster is drawn by one instanced call.
+class PosterBatch
+{
+public:
+    explicit PosterBatch(const MeshArena& arena);
+    ~PosterBatch();
+
+    PosterBatch(const PosterBatch&) = delete;
+    PosterBatch& operator=(const PosterBatch&) = delete;
+
+    void setInstances(const std::vector<PosterInstance>& instances);
+    void draw() const;
+    void release();
+
+    int getInstanceCount() const;
+
+private:
+    GLuint vao;
+    GLuint instanceVBO;
+    MeshRange plane;
+    int instanceCount;
+};
+
+#endif
@@ -0,0 +1,418 @@
+#include "RenderQueue.h"
+#include "GLCaps.h"
+#include <algorithm>
+#include <cstddef>
+
+static RenderQueue* activeQueue = nullptr;
+
+RenderQueue::RenderQueue(const MeshArena& arena)
+    : arena(arena), vao(0), instanceBuffer(0), indirectBuffer(0),
+      gpuCuller(nullptr), sourceInstanceBuffer(0), boundsBuffer(0), streamBuffer(nullptr), indirectCapacity(0),
+      occlusionQueries(nullptr), currentGroup(OcclusionQueries::NO_GROUP),
+      opaqueCommandCount(0), opaqueInstanceCount(0), lastApiDrawCalls(0), lastCpuCulledCount(0),
+      lastUploadBytes(0)
+{
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &instanceBuffer);
+    instanceUploads.setBuffer(instanceBuffer);
+    if (GLCaps::hasMultiDrawIndirect())
+        glGenBuffers(1, &indirectBuffer);
+
+    glBindVertexArray(vao);
+
+    // Per-vertex data from the arena
+    arena.bindVertexAttributes();
+
+    // Per-instance material ID and model matrix
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    bindInstanceAttributes(0);
+    glEnableVertexAttribArray(MaterialRegistry::MATERIAL_ATTRIBUTE);
+    glVertexAttribDivisor(MaterialRegistry::MATERIAL_ATTRIBUTE, 1);
+    for (int column = 0; column < 4; column++)
+    {
+        glEnableVertexAttribArray(4 + column);
+        glVertexAttribDivisor(4 + column, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+RenderQueue::~RenderQueue()
+{
+    release();
+}
+
+void RenderQueue::setActive(RenderQueue* queue)
+{
+    activeQueue = queue;
+}
+
+RenderQueue* RenderQueue::getActive()
+{
+    return activeQueue;
+}
+
+void RenderQueue::setGpuCuller(GpuCuller* culler)
+{
+    // The culler writes instance counts into the indirect buffer
+    gpuCuller = indirectBuffer ? culler : nullptr;
+    if (gpuCuller && !sourceInstanceBuffer)
+    {
+        glGenBuffers(1, &sourceInstanceBuffer);
+        glGenBuffers(1, &boundsBuffer);
+        boundsUploads.setBuffer(boundsBuffer);
+    }
+
+    // CPU culling draws straight from the uploaded instances; GPU culling
+    // uploads them to the culler's source buffer instead
+    instanceUploads.setBuffer(gpuCuller ? sourceInstanceBuffer : instanceBuffer);
+}
+
+void RenderQueue::setStreamBuffer(StreamBuffer* stream)
+{
+    streamBuffer = stream;
+}
+
+void RenderQueue::setOcclusionQueries(OcclusionQueries* queries)
+{
+    occlusionQueries = queries;
+}
+
+void RenderQueue::begin()
+{
+    opaqueItems.clear();
+    transparentItems.clear();
+    currentGroup = OcclusionQueries::NO_GROUP;
+    if (occlusionQueries)
+        occlusionQueries->beginFrame();
+}
+
+void RenderQueue::submit(MeshId mesh, const glm::mat4& model, MaterialId material, bool transparent)
+{
+    DrawItem item;
+    item.mesh = mesh;
+    item.material = material;
+    item.group = currentGroup;
+    item.model = model;
+    (transparent ? transparentItems : opaqueItems).push_back(item);
+
+    if (occlusionQueries && currentGroup != OcclusionQueries::NO_GROUP)
+        occlusionQueries->addBounds(currentGroup, transformAABB(model, arena.getBounds(mesh)));
+}
+
+void RenderQueue::setGroup(int group)
+{
+    currentGroup = occlusionQueries ? group : OcclusionQueries::NO_GROUP;
+}
+
+void RenderQueue::flush(Shader& shader, const glm::mat4& viewProjection, const glm::vec3& viewPos)
+{
+    instances.clear();
+    commands.clear();
+    commandGroups.clear();
+    lastApiDrawCalls = 0;
+    lastCpuCulledCount = 0;
+    lastUploadBytes = 0;
+
+    Frustum frustum = Frustum::fromMatrix(viewProjection);
+    if (!gpuCuller)
+        cullItems(opaqueItems, frustum);
+    cullItems(transparentItems, frustum);
+
+    // Opaque: one instanced command per mesh type within each occlusion group
+    std::stable_sort(opaqueItems.begin(), opaqueItems.end(),
+        [](const DrawItem& a, const DrawItem& b) {
+            return a.group != b.group ? a.group < b.group : a.mesh < b.mesh;
+        });
+    appendCommands(opaqueItems);
+    opaqueCommandCount = (int)commands.size();
+    opaqueInstanceCount = (int)instances.size();
+
+    // Transparent: back to front. Neighbours sharing a mesh still merge, since
+    // instances within one draw are rasterised in order.
+    std::stable_sort(transparentItems.begin(), transparentItems.end(),
+        [&viewPos](const DrawItem& a, const DrawItem& b) {
+            glm::vec3 da = glm::vec3(a.model[3]) - viewPos;
+            glm::vec3 db = glm::vec3(b.model[3]) - viewPos;
+            return glm::dot(da, da) > glm::dot(db, db);
+        });
+    appendCommands(transparentItems);
+
+    if (commands.empty())
+        return;
+
+    uploadFrame();
+    if (gpuCuller)
+    {
+        gpuCuller->cull(sourceInstanceBuffer, instanceBuffer, indirectBuffer, boundsBuffer,
+            opaqueInstanceCount, viewProjection);
+    }
+
+    shader.use();
+    glBindVertexArray(vao);
+
+    submitCommands(0, opaqueCommandCount);
+
+    int transparentCommandCount = (int)commands.size() - opaqueCommandCount;
+    if (transparentCommandCount > 0)
+    {
+        glDepthMask(GL_FALSE);
+        submitCommands(opaqueCommandCount, transparentCommandCount);
+        glDepthMask(GL_TRUE);
+    }
+
+    glBindVertexArray(0);
+
+    // Everything opaque this frame is in the depth buffer by now
+    if (gpuCuller)
+        gpuCuller->buildHiZ(viewProjection);
+    if (occlusionQueries)
+        occlusionQueries->issue(viewProjection, viewPos);
+}
+
+void RenderQueue::cullItems(std::vector<DrawItem>& items, const Frustum& frustum)
+{
+    size_t before = items.size();
+    items.erase(std::remove_if(items.begin(), items.end(),
+        [this, &frustum](const DrawItem& item) {
+            return !frustum.intersects(transformAABB(item.model, arena.getBounds(item.mesh)));
+        }), items.end());
+    lastCpuCulledCount += (int)(before - items.size());
+}
+
+void RenderQueue::appendCommands(const std::vector<DrawItem>& items)
+{
+    size_t passStart = commands.size();
+    MeshId currentMesh = Mesh::CUBE;
+    int commandGroup = OcclusionQueries::NO_GROUP;
+
+    for (const DrawItem& item : items)
+    {
+        if (commands.size() == passStart || item.mesh != currentMesh || item.group != commandGroup)
+        {
+            const MeshRange& range = arena.getRange(item.mesh);
+            DrawElementsIndirectCommand command;
+            command.count = range.indexCount;
+            command.instanceCount = 0;
+            command.firstIndex = range.firstIndex;
+            command.baseVertex = range.baseVertex;
+            command.baseInstance = (GLuint)instances.size();
+            commands.push_back(command);
+            commandGroups.push_back(item.group);
+            currentMesh = item.mesh;
+            commandGroup = item.group;
+        }
+
+        commands.back().instanceCount++;
+        InstanceData instance;
+        instance.model = arena.getDrawModel(item.mesh, item.model);
+        instance.materialId = item.material;
+        instance.commandIndex = (uint32_t)commands.size() - 1;
+        instance.padding[0] = 0;
+        instance.padding[1] = 0;
+        instances.push_back(instance);
+    }
+}
+
+void RenderQueue::uploadFrame()
+{
+    GLsizeiptr instanceBytes = instances.size() * sizeof(InstanceData);
+    GLsizeiptr commandBytes = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+    // Written one batch (command) at a time; only what changed since last frame is sent
+    instanceUploads.resize(instanceBytes);
+    for (const DrawElementsIndirectCommand& command : commands)
+    {
+        instanceUploads.write(command.baseInstance * sizeof(InstanceData),
+            &instances[command.baseInstance], command.instanceCount * sizeof(InstanceData));
+    }
+
+    if (!gpuCuller)
+    {
+        lastUploadBytes += instanceUploads.upload(streamBuffer);
+    }
+    else
+    {
+        lastUploadBytes += instanceUploads.upload(streamBuffer);
+
+        // The culler compacts opaque instances; transparent ones are copied as-is.
+        // Orphan the output; the previous frame's draws may still read it.
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, instanceBytes, NULL, GL_STREAM_DRAW);
+        GLsizeiptr opaqueBytes = opaqueInstanceCount * sizeof(InstanceData);
+        if (instanceBytes > opaqueBytes)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, sourceInstanceBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, opaqueBytes, opaqueBytes, instanceBytes - opaqueBytes);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+
+        // Object-space box per opaque command (std430 vec4 pairs), in the
+        // stored position units the instance matrices expect
+        boundsUploads.resize(opaqueCommandCount * 2 * sizeof(glm::vec4));
+        for (int i = 0; i < opaqueCommandCount; i++)
+        {
+            MeshId mesh = opaqueItems[commands[i].baseInstance].mesh;
+            const AABB& box = arena.getBounds(mesh);
+            float scale = arena.getPositionScale(mesh);
+            glm::vec4 packedBounds[2] = { glm::vec4(box.minCorner / scale, 0.0f), glm::vec4(box.maxCorner / scale, 0.0f) };
+            boundsUploads.write(i * sizeof(packedBounds), packedBounds, sizeof(packedBounds));
+        }
+        lastUploadBytes += boundsUploads.upload(streamBuffer);
+    }
+
+    if (indirectBuffer)
+    {
+        // With GPU culling the opaque counts start at zero and the culler fills
+        // them in, so the GPU copy never matches last frame's: always resent
+        const DrawElementsIndirectCommand* commandData = commands.data();
+        std::vector<DrawElementsIndirectCommand> pendingCommands;
+        if (gpuCuller)
+        {
+            pendingCommands = commands;
+            for (int i = 0; i < opaqueCommandCount; i++)
+                pendingCommands[i].instanceCount = 0;
+            commandData = pendingCommands.data();
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        if (commandBytes > indirectCapacity)
+        {
+            indirectCapacity = std::max(commandBytes, indirectCapacity * 2);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, indirectCapacity, NULL, GL_DYNAMIC_DRAW);
+        }
+
+        // Staged in the stream and copied on the GPU, after last frame's draws
+        GLintptr staged = streamBuffer ? streamBuffer->allocate(commandData, commandBytes) : -1;
+        if (staged >= 0)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, streamBuffer->getBuffer());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_DRAW_INDIRECT_BUFFER, staged, 0, commandBytes);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        else
+        {
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commandBytes, commandData);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        lastUploadBytes += commandBytes;
+    }
+}
+
+void RenderQueue::submitCommands(int firstCommand, int commandCount)
+{
+    if (!occlusionQueries)
+    {
+        submitRange(firstCommand, commandCount);
+        return;
+    }
+
+    // One range per run of commands sharing a group
+    int end = firstCommand + commandCount;
+    int runStart = firstCommand;
+    while (runStart < end)
+    {
+        int group = commandGroups[runStart];
+        int runEnd = runStart + 1;
+        while (runEnd < end && commandGroups[runEnd] == group)
+            runEnd++;
+
+        occlusionQueries->beginConditional(group);
+        submitRange(runStart, runEnd - runStart);
+        occlusionQueries->endConditional(group);
+        runStart = runEnd;
+    }
+}
+
+void RenderQueue::submitRange(int firstCommand, int commandCount)
+{
+    if (commandCount == 0)
+        return;
+
+    if (indirectBuffer)
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        GLCaps::multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+            (void*)(firstCommand * sizeof(DrawElementsIndirectCommand)), commandCount, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        lastApiDrawCalls++;
+        return;
+    }
+
+    // GL 3.3 fallback: no baseInstance, so re-point the instance attributes per command
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (int i = firstCommand; i < firstCommand + commandCount; i++)
+    {
+        const DrawElementsIndirectCommand& command = commands[i];
+        bindInstanceAttributes(command.baseInstance);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+            (void*)(command.firstIndex * sizeof(GLuint)), command.instanceCount, command.baseVertex);
+        lastApiDrawCalls++;
+    }
+    bindInstanceAttributes(0);
+}
+
+void RenderQueue::bindInstanceAttributes(GLuint baseInstance)
+{
+    size_t base = baseInstance * sizeof(InstanceData);
+    glVertexAttribIPointer(MaterialRegistry::MATERIAL_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(InstanceData),
+        (void*)(base + offsetof(InstanceData, materialId)));
+    for (int column = 0; column < 4; column++)
+    {
+        glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+    }
+}
+
+void RenderQueue::release()
+{
+    if (vao)
+    {
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &instanceBuffer);
+        if (indirectBuffer)
+            glDeleteBuffers(1, &indirectBuffer);
+        if (sourceInstanceBuffer)
+        {
+            glDeleteBuffers(1, &sourceInstanceBuffer);
+            glDeleteBuffers(1, &boundsBuffer);
+        }
+        vao = 0;
+        instanceBuffer = 0;
+        indirectBuffer = 0;
+        indirectCapacity = 0;
+        sourceInstanceBuffer = 0;
+        boundsBuffer = 0;
+        instanceUploads.setBuffer(0);
+        boundsUploads.setBuffer(0);
+        gpuCuller = nullptr;
+        occlusionQueries = nullptr;
+        streamBuffer = nullptr;
+    }
+}
+
+int RenderQueue::getItemCount() const
+{
+    return (int)(opaqueItems.size() + transparentItems.size());
+}
+
+int RenderQueue::getLastCommandCount() const
+{
+    return (int)commands.size();
+}
+
+int RenderQueue::getLastApiDrawCalls() const
+{
+    return lastApiDrawCalls;
+}
+
+int RenderQueue::getLastCpuCulledCount() const
+{
+    return lastCpuCulledCount;
+}
+
+size_t RenderQueue::getLastUploadBytes() const
+{
+    return lastUploadBytes;
+}
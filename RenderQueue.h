@@ -0,0 +1,131 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "mesh.h"
+#include "MeshArena.h"
+#include "MaterialRegistry.h"
+#include "GpuCuller.h"
+#include "IncrementalBuffer.h"
+#include "StreamBuffer.h"
+#include "OcclusionQueries.h"
+#include "shader.h"
+
+// Layout matches DrawElementsIndirectCommand in the GL spec
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// Per-instance vertex data (locations 3-7 of vertexShaderSource_instanced).
+// Padded to the std430 layout the GPU culler reads it with.
+struct InstanceData {
+    glm::mat4 model;
+    uint32_t materialId;
+    uint32_t commandIndex;
+    uint32_t padding[2];
+};
+
+// Collects the frame's static-scene draws and submits them from shared
+// MeshArena buffers. While a queue is active, RenderUtils records into it
+// instead of drawing. flush() frustum-culls the draws, groups opaque ones per
+// mesh into instanced commands and submits them with one
+// glMultiDrawElementsIndirect call. Transparent draws follow back to front
+// in a second call. Without multi-draw indirect, each command is issued on
+// its own. Instance data is only re-sent where it differs from last frame's.
+// With a GpuCuller attached, opaque culling moves to the GPU.
+// With OcclusionQueries attached, draws submitted under a group are kept
+// together and rendered conditionally on that group's last query.
+class RenderQueue
+{
+public:
+    explicit RenderQueue(const MeshArena& arena);
+    ~RenderQueue();
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    static void setActive(RenderQueue* queue);
+    static RenderQueue* getActive();
+
+    // Optional; requires multi-draw indirect. Pass nullptr for CPU culling.
+    void setGpuCuller(GpuCuller* culler);
+
+    // Optional; stages every upload so it never waits on draws in flight.
+    // Pass nullptr to upload with glBufferSubData.
+    void setStreamBuffer(StreamBuffer* stream);
+
+    // Optional; pass nullptr to draw every group unconditionally
+    void setOcclusionQueries(OcclusionQueries* queries);
+
+    void begin();
+    void submit(MeshId mesh, const glm::mat4& model, MaterialId material, bool transparent);
+
+    // Occlusion group for the following submits (OcclusionQueries::NO_GROUP to end)
+    void setGroup(int group);
+
+    // Shader must already have view/projection/lighting set
+    void flush(Shader& shader, const glm::mat4& viewProjection, const glm::vec3& viewPos);
+
+    void release();
+
+    int getItemCount() const;
+    int getLastCommandCount() const;
+    int getLastApiDrawCalls() const;
+    int getLastCpuCulledCount() const;   // GPU-culled draws are not counted
+    size_t getLastUploadBytes() const;   // Instance, bounds and command bytes sent by the last flush()
+
+private:
+    struct DrawItem {
+        MeshId mesh;
+        MaterialId material;
+        int group;
+        glm::mat4 model;
+    };
+
+    void cullItems(std::vector<DrawItem>& items, const Frustum& frustum);
+    void appendCommands(const std::vector<DrawItem>& items);
+    void uploadFrame();
+    void submitCommands(int firstCommand, int commandCount);
+    void submitRange(int firstCommand, int commandCount);
+    void bindInstanceAttributes(GLuint baseInstance);
+
+    const MeshArena& arena;
+    GLuint vao;
+    GLuint instanceBuffer;
+    GLuint indirectBuffer;
+
+    // GPU culling: full instance list in, compacted list out (instanceBuffer)
+    GpuCuller* gpuCuller;
+    GLuint sourceInstanceBuffer;
+    GLuint boundsBuffer;
+
+    StreamBuffer* streamBuffer;
+    GLsizeiptr indirectCapacity;
+
+    OcclusionQueries* occlusionQueries;
+    int currentGroup;
+
+    std::vector<DrawItem> opaqueItems;
+    std::vector<DrawItem> transparentItems;
+    std::vector<InstanceData> instances;
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<int> commandGroups;      // parallel to commands
+    int opaqueCommandCount;
+    int opaqueInstanceCount;
+    int lastApiDrawCalls;
+    int lastCpuCulledCount;
+
+    // Instances and culling bounds persist between frames; only changed batches are re-sent
+    IncrementalBuffer instanceUploads;
+    IncrementalBuffer boundsUploads;
+    size_t lastUploadBytes;
+};
+
+#endif
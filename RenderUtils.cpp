@@ -1,9 +1,44 @@
 #include "RenderUtils.h"
 #include "mesh.h"
+#include "MaterialRegistry.h"
+#include "MeshRegistry.h"
+#include "RenderQueue.h"
+#include "EntityWorld.h"
 #include <glm/gtc/matrix_transform.hpp>
 
-void RenderUtils::renderCube(
-    GLuint cubeVAO,
+// Record into the EntityWorld being filled or the active RenderQueue, or draw
+// immediately from the shared mesh arena. Returns the mesh's world bounds.
+static AABB drawMesh(
+    Shader& shader,
+    MeshId mesh,
+    const glm::mat4& model,
+    const glm::vec3& ambient,
+    const glm::vec3& diffuse,
+    const glm::vec3& specular,
+    float alpha
+) {
+    MaterialId material = MaterialRegistry::intern(ambient, diffuse, specular, alpha);
+    AABB bounds = transformAABB(model, MeshRegistry::getArena().getBounds(mesh));
+
+    EntityWorld* world = EntityWorld::getRecording();
+    if (world) {
+        world->record(mesh, model, material, alpha < 1.0f, bounds);
+        return bounds;
+    }
+
+    RenderQueue* queue = RenderQueue::getActive();
+    if (queue) {
+        queue->submit(mesh, model, material, alpha < 1.0f);
+        return bounds;
+    }
+
+    MaterialRegistry::setCurrent(material);
+    shader.setMat4("model", MeshRegistry::getArena().getDrawModel(mesh, model));
+    MeshRegistry::draw(mesh);
+    return bounds;
+}
+
+AABB RenderUtils::renderCube(
     Shader& shader,
     const glm::vec3& position,
     const glm::vec3& scale,
@@ -14,24 +49,16 @@ void RenderUtils::renderCube(
     float rotationDegrees,
     const glm::vec3& rotationAxis
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(cubeVAO);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     if (rotationDegrees != 0.0f) {
         model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
     }
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::CUBE));
+    return drawMesh(shader, Mesh::CUBE, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderCubeWithMatrix(
-    GLuint cubeVAO,
+AABB RenderUtils::renderCubeWithMatrix(
     Shader& shader,
     const glm::mat4& transformMatrix,
     const glm::vec3& scale,
@@ -40,20 +67,12 @@ void RenderUtils::renderCubeWithMatrix(
     const glm::vec3& specular,
     float alpha
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(cubeVAO);
     glm::mat4 model = transformMatrix;
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::CUBE));
+    return drawMesh(shader, Mesh::CUBE, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderPlane(
-    GLuint planeVAO,
+AABB RenderUtils::renderPlane(
     Shader& shader,
     const glm::vec3& position,
     const glm::vec3& scale,
@@ -64,24 +83,16 @@ void RenderUtils::renderPlane(
     float rotationDegrees,
     const glm::vec3& rotationAxis
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(planeVAO);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     if (rotationDegrees != 0.0f) {
         model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
     }
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::PLANE));
+    return drawMesh(shader, Mesh::PLANE, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderCylinder(
-    GLuint cylinderVAO,
+AABB RenderUtils::renderCylinder(
     Shader& shader,
     const glm::vec3& position,
     const glm::vec3& scale,
@@ -92,24 +103,16 @@ void RenderUtils::renderCylinder(
     float rotationDegrees,
     const glm::vec3& rotationAxis
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(cylinderVAO);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     if (rotationDegrees != 0.0f) {
         model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
     }
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::CYLINDER));
+    return drawMesh(shader, Mesh::CYLINDER, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderCylinderWithMatrix(
-    GLuint cylinderVAO,
+AABB RenderUtils::renderCylinderWithMatrix(
     Shader& shader,
     const glm::mat4& transformMatrix,
     const glm::vec3& scale,
@@ -118,20 +121,12 @@ void RenderUtils::renderCylinderWithMatrix(
     const glm::vec3& specular,
     float alpha
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(cylinderVAO);
     glm::mat4 model = transformMatrix;
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::CYLINDER));
+    return drawMesh(shader, Mesh::CYLINDER, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderWindow(
-    GLuint windowVAO,
+AABB RenderUtils::renderWindow(
     Shader& shader,
     const glm::vec3& position,
     const glm::vec3& scale,
@@ -142,24 +137,35 @@ void RenderUtils::renderWindow(
     float rotationDegrees,
     const glm::vec3& rotationAxis
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(windowVAO);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     if (rotationDegrees != 0.0f) {
         model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
     }
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::WINDOW));
+    return drawMesh(shader, Mesh::WINDOW, model, ambient, diffuse, specular, alpha);
+}
+
+AABB RenderUtils::renderPrototype(
+    Shader& shader,
+    MeshId prototype,
+    const glm::vec3& position,
+    const glm::vec3& ambient,
+    const glm::vec3& diffuse,
+    const glm::vec3& specular,
+    float alpha,
+    float rotationDegrees,
+    const glm::vec3& rotationAxis
+) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    if (rotationDegrees != 0.0f) {
+        model = glm::rotate(model, glm::radians(rotationDegrees), rotationAxis);
+    }
+    return drawMesh(shader, prototype, model, ambient, diffuse, specular, alpha);
 }
 
-void RenderUtils::renderSphere(
-    GLuint sphereVAO,
+AABB RenderUtils::renderSphere(
     Shader& shader,
     const glm::vec3& position,
     const glm::vec3& scale,
@@ -168,15 +174,8 @@ void RenderUtils::renderSphere(
     const glm::vec3& specular,
     float alpha
 ) {
-    shader.setVec3("material.ambient", ambient);
-    shader.setVec3("material.diffuse", diffuse);
-    shader.setVec3("material.specular", specular);
-    shader.setFloat("material.alpha", alpha);
-
-    glBindVertexArray(sphereVAO);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, position);
     model = glm::scale(model, scale);
-    shader.setMat4("model", model);
-    glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::SPHERE));
+    return drawMesh(shader, Mesh::SPHERE, model, ambient, diffuse, specular, alpha);
 }
\ No newline at end of file
@@ -4,13 +4,16 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include "shader.h"
+#include "Frustum.h"
+#include "mesh.h"
+#include "MeshArena.h"
 
-// Rendering utility functions for basic shapes
+// Rendering utility functions for basic shapes. Each returns the world
+// bounds of what it drew, from the mesh's precomputed bounds.
 class RenderUtils {
 public:
     // Render cube with position, scale, and material properties
-    static void renderCube(
-        GLuint cubeVAO,
+    static AABB renderCube(
         Shader& shader,
         const glm::vec3& position,
         const glm::vec3& scale,
@@ -23,8 +26,7 @@ public:
     );
 
     // Render cube with pre-built transformation matrix
-    static void renderCubeWithMatrix(
-        GLuint cubeVAO,
+    static AABB renderCubeWithMatrix(
         Shader& shader,
         const glm::mat4& transformMatrix,
         const glm::vec3& scale,
@@ -35,8 +37,7 @@ public:
     );
 
     // Render plane
-    static void renderPlane(
-        GLuint planeVAO,
+    static AABB renderPlane(
         Shader& shader,
         const glm::vec3& position,
         const glm::vec3& scale,
@@ -49,8 +50,7 @@ public:
     );
 
     // Render cylinder
-    static void renderCylinder(
-        GLuint cylinderVAO,
+    static AABB renderCylinder(
         Shader& shader,
         const glm::vec3& position,
         const glm::vec3& scale,
@@ -63,8 +63,7 @@ public:
     );
 
     // Render cylinder with pre-built transformation matrix
-    static void renderCylinderWithMatrix(
-        GLuint cylinderVAO,
+    static AABB renderCylinderWithMatrix(
         Shader& shader,
         const glm::mat4& transformMatrix,
         const glm::vec3& scale,
@@ -75,8 +74,7 @@ public:
     );
 
     // Render window
-    static void renderWindow(
-        GLuint windowVAO,
+    static AABB renderWindow(
         Shader& shader,
         const glm::vec3& position,
         const glm::vec3& scale,
@@ -88,9 +86,21 @@ public:
         const glm::vec3& rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f)
     );
 
+    // Render a prototype (MeshRegistry::addPrototype): every part in one draw or instance
+    static AABB renderPrototype(
+        Shader& shader,
+        MeshId prototype,
+        const glm::vec3& position,
+        const glm::vec3& ambient,
+        const glm::vec3& diffuse,
+        const glm::vec3& specular,
+        float alpha = 1.0f,
+        float rotationDegrees = 0.0f,
+        const glm::vec3& rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f)
+    );
+
     // Render sphere
-    static void renderSphere(
-        GLuint sphereVAO,
+    static AABB renderSphere(
         Shader& shader,
         const glm::vec3& position,
         const glm::vec3& scale,
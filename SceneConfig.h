@@ -43,6 +43,34 @@ namespace DeskLayout {
     const float START_Z = -15.0f;
 }
 
+// Occlusion query groups (RenderQueue::setGroup); group 0 is never culled
+namespace OcclusionGroups {
+    const int NONE = 0;
+    const int ROOM_FIXTURES = 1;           // Boards, projector, fan, teacher desk
+    const int FIRST_DESK_ROW = 2;          // One group per desk row
+    const int COUNT = FIRST_DESK_ROW + DeskLayout::NUM_ROWS;
+}
+
+// Portal graph cells (ClassroomObjects::buildPortalGraph adds them in this order)
+namespace PortalCells {
+    const int OUTDOORS = 0;                // Exterior: wherever no other cell is
+    const int CLASSROOM = 1;
+    const int HALLWAY = 2;
+}
+
+// Camera collision (CollisionWorld): the camera is a vertical capsule hanging
+// below the eye, so it is stopped by desks and benches as well as walls
+namespace CollisionConfig {
+    const float CAPSULE_RADIUS = 0.4f;
+    const float CAPSULE_HEIGHT = 3.5f;     // Eye to the bottom sphere's center
+    const float CELL_SIZE = 4.0f;          // Spatial hash cell, in world units on x/z
+}
+
+// Mouse picking (SceneObjects::raycast from the crosshair)
+namespace PickConfig {
+    const float MAX_DISTANCE = 60.0f;      // About the room's diagonal
+}
+
 // Desk Dimensions
 namespace DeskDimensions {
     const float MAIN_WIDTH = 5.0f;
@@ -63,6 +91,7 @@ namespace BenchDimensions {
     const float DEPTH = 1.5f;
     const float HEIGHT = 1.5f;
     const float LEG_WIDTH = 0.1f;
+    const float SEAT_THICKNESS = 0.1f;
 }
 
 // Teacher Desk Dimensions (larger desk with drawer)
@@ -105,6 +134,25 @@ namespace ProjectorConfig {
     const float MOUNT_LENGTH = 2.5f;
 }
 
+// Poster Configuration (back wall, drawn from one texture array)
+namespace PosterConfig {
+    const float WIDTH = 6.0f;
+    const float SPACING = 4.0f;            // Gap between neighbouring posters
+    const float Y_POSITION = 8.0f;
+    const float WALL_OFFSET = 0.15f;       // Distance in front of the back wall
+    const int LAYER_WIDTH = 512;
+    const int LAYER_HEIGHT = 512;
+    const glm::vec3 SPECULAR(0.1f, 0.1f, 0.1f);
+}
+
+// Imported model (OBJ/glTF cooked by Tools/ModelCooker); skipped when the file is absent
+namespace ImportedModelConfig {
+    const char* const PATH = "Models/model.mesh";
+    const glm::vec3 POSITION(20.0f, 0.0f, 20.0f);   // Back right corner of the classroom floor
+    const float SCALE = 1.0f;
+    const float ROTATION_Y = 0.0f;                  // Degrees
+}
+
 // Material Colors
 namespace Colors {
     // Wood
@@ -0,0 +1,75 @@
+#include "SceneGraph.h"
+#include <algorithm>
+#include <cstring>
+
+SceneGraph::SceneGraph()
+    : firstDirty(0), lastUpdatedCount(0)
+{
+}
+
+int SceneGraph::addNode(int parent, const glm::mat4& local)
+{
+    int index = (int)parents.size();
+    parents.push_back(parent);
+    locals.push_back(local);
+    worlds.push_back(local);
+    dirty.push_back(1);
+    firstDirty = std::min(firstDirty, index);
+    return index;
+}
+
+void SceneGraph::setLocal(int node, const glm::mat4& local)
+{
+    if (std::memcmp(&locals[node], &local, sizeof(glm::mat4)) == 0)
+        return;
+    locals[node] = local;
+    dirty[node] = 1;
+    firstDirty = std::min(firstDirty, node);
+}
+
+void SceneGraph::update()
+{
+    int count = (int)parents.size();
+    lastUpdatedCount = 0;
+
+    // dirty[] doubles as "recomputed in this pass", which is what children test
+    for (int i = firstDirty; i < count; i++)
+    {
+        int parent = parents[i];
+        if (!dirty[i] && (parent == NO_PARENT || !dirty[parent]))
+            continue;
+
+        worlds[i] = parent == NO_PARENT ? locals[i] : worlds[parent] * locals[i];
+        dirty[i] = 1;
+        lastUpdatedCount++;
+    }
+
+    for (int i = firstDirty; i < count; i++)
+        dirty[i] = 0;
+    firstDirty = count;
+}
+
+const glm::mat4& SceneGraph::getWorld(int node) const
+{
+    return worlds[node];
+}
+
+const glm::mat4& SceneGraph::getLocal(int node) const
+{
+    return locals[node];
+}
+
+int SceneGraph::getParent(int node) const
+{
+    return parents[node];
+}
+
+int SceneGraph::getNodeCount() const
+{
+    return (int)parents.size();
+}
+
+int SceneGraph::getLastUpdatedCount() const
+{
+    return lastUpdatedCount;
+}
@@ -0,0 +1,43 @@
+#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Transform hierarchy in flat arrays (parent index, local and world matrix,
+// dirty flag per node). A parent is always added before its children, so
+// index order is a valid update order and update() is one forward pass with
+// no recursion. A node's world matrix is only recomputed when its local
+// matrix changed or its parent was recomputed in the same pass; a spinning
+// fan rotor costs its own subtree, not the rest of the scene.
+class SceneGraph
+{
+public:
+    static const int NO_PARENT = -1;
+
+    SceneGraph();
+
+    int addNode(int parent, const glm::mat4& local);
+
+    // Marks the node dirty only if the matrix actually changed
+    void setLocal(int node, const glm::mat4& local);
+
+    void update();
+
+    const glm::mat4& getWorld(int node) const;
+    const glm::mat4& getLocal(int node) const;
+    int getParent(int node) const;
+    int getNodeCount() const;
+    int getLastUpdatedCount() const;   // world matrices recomputed by the last update()
+
+private:
+    std::vector<int> parents;
+    std::vector<glm::mat4> locals;
+    std::vector<glm::mat4> worlds;
+    std::vector<uint8_t> dirty;        // local changed, or recomputed in this pass
+    int firstDirty;                    // nodes before this one cannot change
+    int lastUpdatedCount;
+};
+
+#endif
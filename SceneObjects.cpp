@@ -0,0 +1,131 @@
+#include "SceneObjects.h"
+
+SceneObjects::SceneObjects()
+    : needsBuild(false), needsRefit(false), lastVisibleCount(0)
+{
+}
+
+int SceneObjects::add(const std::string& name, bool dynamic)
+{
+    Object object;
+    object.name = name;
+    object.dynamic = dynamic;
+    object.hasBounds = false;
+    object.visible = true;
+    object.treeIndex = -1;
+    objects.push_back(object);
+
+    AABB empty = { glm::vec3(0.0f), glm::vec3(0.0f) };
+    bounds.push_back(empty);
+    return (int)objects.size() - 1;
+}
+
+void SceneObjects::update(const Frustum& frustum)
+{
+    if (needsBuild)
+    {
+        treeBounds.clear();
+        treeObjects.clear();
+        for (int i = 0; i < (int)objects.size(); i++)
+        {
+            objects[i].treeIndex = -1;
+            if (!objects[i].hasBounds)
+                continue;
+            objects[i].treeIndex = (int)treeBounds.size();
+            treeBounds.push_back(bounds[i]);
+            treeObjects.push_back(i);
+        }
+        bvh.build(treeBounds);
+        needsBuild = false;
+        needsRefit = false;
+    }
+    else if (needsRefit)
+    {
+        for (int i = 0; i < (int)objects.size(); i++)
+        {
+            if (objects[i].dynamic && objects[i].treeIndex >= 0)
+                treeBounds[objects[i].treeIndex] = bounds[i];
+        }
+        bvh.refit(treeBounds);
+        needsRefit = false;
+    }
+
+    // Objects without bounds yet cannot be culled
+    for (Object& object : objects)
+        object.visible = !object.hasBounds;
+
+    queryResults.clear();
+    bvh.queryFrustum(frustum, queryResults);
+    for (int treeObject : queryResults)
+        objects[treeObjects[treeObject]].visible = true;
+
+    lastVisibleCount = 0;
+    for (const Object& object : objects)
+        lastVisibleCount += object.visible ? 1 : 0;
+}
+
+void SceneObjects::setBounds(int object, const AABB& newBounds)
+{
+    Object& entry = objects[object];
+    if (!entry.hasBounds)
+    {
+        entry.hasBounds = true;
+        needsBuild = true;
+    }
+    else if (newBounds.minCorner != bounds[object].minCorner ||
+             newBounds.maxCorner != bounds[object].maxCorner)
+    {
+        needsRefit = true;
+    }
+    bounds[object] = newBounds;
+}
+
+bool SceneObjects::isVisible(int object) const
+{
+    return objects[object].visible;
+}
+
+bool SceneObjects::hasBounds(int object) const
+{
+    return objects[object].hasBounds;
+}
+
+const AABB& SceneObjects::getBounds(int object) const
+{
+    return bounds[object];
+}
+
+const std::string& SceneObjects::getName(int object) const
+{
+    return objects[object].name;
+}
+
+int SceneObjects::getCount() const
+{
+    return (int)objects.size();
+}
+
+int SceneObjects::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+    float& hitDistance) const
+{
+    int treeObject = bvh.raycast(origin, direction, maxDistance, hitDistance);
+    return treeObject >= 0 ? treeObjects[treeObject] : -1;
+}
+
+void SceneObjects::queryOverlap(const AABB& box, std::vector<int>& results) const
+{
+    size_t first = results.size();
+    bvh.queryOverlap(box, results);
+    for (size_t i = first; i < results.size(); i++)
+        results[i] = treeObjects[results[i]];
+}
+
+int SceneObjects::getLastVisibleCount() const
+{
+    return lastVisibleCount;
+}
+
+const BVH& SceneObjects::getBVH() const
+{
+    return bvh;
+}
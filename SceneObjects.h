@@ -0,0 +1,63 @@
+#ifndef SCENE_OBJECTS_H
+#define SCENE_OBJECTS_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include "BVH.h"
+#include "Frustum.h"
+
+// Named scene objects (a desk, the fan, the door) and a BVH over their world
+// bounds, for per-object culling and ray/overlap queries. Bounds are not
+// written by hand: EntityWorld publishes the union of each object's entities.
+// Static objects get theirs once at load. Dynamic ones are republished every
+// frame, and the tree is refit rather than rebuilt when they move.
+class SceneObjects
+{
+public:
+    SceneObjects();
+
+    int add(const std::string& name, bool dynamic);
+
+    // Once per frame before drawing: bring the BVH up to date with the bounds
+    // published since the last call, then cull against the frustum
+    void update(const Frustum& frustum);
+
+    // A first call adds the object to the tree; later ones only refit it
+    void setBounds(int object, const AABB& bounds);
+
+    bool isVisible(int object) const;
+    bool hasBounds(int object) const;
+    const AABB& getBounds(int object) const;
+    const std::string& getName(int object) const;
+    int getCount() const;
+
+    // Nearest object whose box the ray hits, or -1 (see BVH::raycast)
+    int raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+        float& hitDistance) const;
+    void queryOverlap(const AABB& box, std::vector<int>& objects) const;
+
+    int getLastVisibleCount() const;
+    const BVH& getBVH() const;
+
+private:
+    struct Object {
+        std::string name;
+        bool dynamic;
+        bool hasBounds;
+        bool visible;
+        int treeIndex;     // slot in treeBounds, -1 until bounds are set
+    };
+
+    std::vector<Object> objects;
+    std::vector<AABB> bounds;
+    std::vector<AABB> treeBounds;      // BVH input: objects with bounds only
+    std::vector<int> treeObjects;      // BVH object -> scene object
+    std::vector<int> queryResults;
+    BVH bvh;
+    bool needsBuild;
+    bool needsRefit;
+    int lastVisibleCount;
+};
+
+#endif
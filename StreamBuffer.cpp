@@ -0,0 +1,143 @@
+#include "StreamBuffer.h"
+#include "GLCaps.h"
+#include <cstring>
+#include <iostream>
+
+// One second; a fence that takes longer means the GPU has hung
+static const GLuint64 FENCE_TIMEOUT_NS = 1000000000;
+
+StreamBuffer::StreamBuffer(GLsizeiptr bytesPerFrame)
+    : buffer(0), mapped(nullptr), regionSize(bytesPerFrame), region(0), head(0),
+      lastFrameBytes(0), lastBeginWaited(false)
+{
+    for (int i = 0; i < FRAME_COUNT; i++)
+        fences[i] = 0;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    if (GLCaps::hasBufferStorage())
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLCaps::bufferStorage(GL_COPY_READ_BUFFER, regionSize * FRAME_COUNT, NULL, flags);
+        mapped = (uint8_t*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, regionSize * FRAME_COUNT, flags);
+        if (!mapped)
+        {
+            // Immutable storage cannot be respecified; start over with a plain buffer
+            std::cout << "ERROR::STREAM_BUFFER::PERSISTENT_MAP_FAILED" << std::endl;
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        }
+    }
+    if (!mapped)
+        glBufferData(GL_COPY_READ_BUFFER, regionSize, NULL, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    release();
+}
+
+void StreamBuffer::beginFrame()
+{
+    head = 0;
+    lastBeginWaited = false;
+
+    if (!mapped)
+    {
+        // Fresh storage; the driver keeps the old one alive for pending draws
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glBufferData(GL_COPY_READ_BUFFER, regionSize, NULL, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return;
+    }
+
+    region = (region + 1) % FRAME_COUNT;
+    GLsync fence = fences[region];
+    if (!fence)
+        return;
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        lastBeginWaited = true;
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    }
+    if (result == GL_WAIT_FAILED || result == GL_TIMEOUT_EXPIRED)
+        std::cout << "ERROR::STREAM_BUFFER::FENCE_WAIT_FAILED" << std::endl;
+    glDeleteSync(fence);
+    fences[region] = 0;
+}
+
+GLintptr StreamBuffer::allocate(const void* data, GLsizeiptr bytes)
+{
+    GLsizeiptr offset = (head + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (!buffer || offset + bytes > regionSize)
+        return -1;
+    head = offset + bytes;
+
+    GLintptr bufferOffset = region * regionSize + offset;
+    if (mapped)
+    {
+        std::memcpy(mapped + bufferOffset, data, bytes);
+    }
+    else
+    {
+        // Orphaned this frame, so nothing in flight reads this range
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glBufferSubData(GL_COPY_READ_BUFFER, bufferOffset, bytes, data);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    return bufferOffset;
+}
+
+void StreamBuffer::endFrame()
+{
+    lastFrameBytes = head;
+    if (mapped)
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::release()
+{
+    if (!buffer)
+        return;
+
+    for (int i = 0; i < FRAME_COUNT; i++)
+    {
+        if (fences[i])
+            glDeleteSync(fences[i]);
+        fences[i] = 0;
+    }
+    if (mapped)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        mapped = nullptr;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+GLuint StreamBuffer::getBuffer() const
+{
+    return buffer;
+}
+
+bool StreamBuffer::isPersistent() const
+{
+    return mapped != nullptr;
+}
+
+GLsizeiptr StreamBuffer::getLastFrameBytes() const
+{
+    return lastFrameBytes;
+}
+
+bool StreamBuffer::getLastBeginWaited() const
+{
+    return lastBeginWaited;
+}
@@ -0,0 +1,59 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// Ring allocator for data written by the CPU every frame. The buffer is split
+// into FRAME_COUNT regions; each frame allocates from the next one, and a
+// fence placed at the end of the frame guards the region until the GPU has
+// finished reading it, so writes never wait on draws still in flight. With
+// buffer storage the ring is mapped once, persistently and coherently, and
+// allocations are plain memcpys. On GL 3.3 there is a single region that is
+// orphaned at the start of each frame instead.
+//
+// Data is read from the ring either directly (bind getBuffer() at the
+// returned offset) or copied into a long-lived buffer on the GPU timeline
+// with glCopyBufferSubData, which is how IncrementalBuffer uses it.
+class StreamBuffer
+{
+public:
+    static const int FRAME_COUNT = 3;
+    static const GLsizeiptr ALIGNMENT = 256;   // Covers uniform buffer offset alignment
+
+    explicit StreamBuffer(GLsizeiptr bytesPerFrame);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Start writing into the next region; waits only if the GPU is still
+    // FRAME_COUNT frames behind
+    void beginFrame();
+
+    // Copy data into this frame's region. Returns its offset in getBuffer(),
+    // or -1 when the region is full (the caller then uploads directly).
+    GLintptr allocate(const void* data, GLsizeiptr bytes);
+
+    // After the frame's last command that reads the region
+    void endFrame();
+
+    void release();
+
+    GLuint getBuffer() const;
+    bool isPersistent() const;
+    GLsizeiptr getLastFrameBytes() const;     // Allocated during the last frame
+    bool getLastBeginWaited() const;          // beginFrame() found its region still in use
+
+private:
+    GLuint buffer;
+    uint8_t* mapped;                  // Persistent mapping, null when orphaning
+    GLsizeiptr regionSize;
+    int region;
+    GLsizeiptr head;                  // Next free byte in the current region
+    GLsync fences[FRAME_COUNT];
+    GLsizeiptr lastFrameBytes;
+    bool lastBeginWaited;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include "TextureArray.h"
+#include "AsyncTextureLoader.h"
+#include "GLCaps.h"
+#include "KtxFormat.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+
+// The cooked format every layer shares, or GL_RGBA8 (decode on the loader's
+// workers) unless all of them have a cooked KTX of exactly the layer size
+// and mip count in one format the driver can sample
+static GLenum chooseLayerFormat(const std::vector<std::string>& paths, int layerWidth, int layerHeight,
+    int levelCount)
+{
+    GLenum common = 0;
+    for (const std::string& path : paths)
+    {
+        MappedFile file;
+        KtxFormat::Header header;
+        std::vector<KtxFormat::Level> levels;
+        if (!file.open(KtxFormat::cookedPath(path).c_str()) ||
+            KtxFormat::parse(file.data(), file.size(), header, levels) != KtxFormat::PARSE_OK)
+            return GL_RGBA8;
+
+        bool compressed = header.glType == 0;
+        bool usable = compressed
+            ? KtxFormat::blockBytes(header.glInternalFormat) != 0 && GLCaps::hasS3TC()
+            : header.glInternalFormat == GL_RGBA8 && header.glFormat == GL_RGBA && header.glType == GL_UNSIGNED_BYTE;
+        if (!usable || (int)header.pixelWidth != layerWidth || (int)header.pixelHeight != layerHeight ||
+            (int)levels.size() != levelCount || (common != 0 && header.glInternalFormat != common))
+            return GL_RGBA8;
+        common = header.glInternalFormat;
+    }
+    return common;
+}
+
+// One 4x4 block of flat mid grey: BC1 with both endpoints 0x8410, BC3 with
+// an opaque alpha block in front
+static void greyBlock(GLenum format, unsigned char* block)
+{
+    const unsigned char color[8] = { 0x10, 0x84, 0x10, 0x84, 0, 0, 0, 0 };
+    const unsigned char alpha[8] = { 0xFF, 0xFF, 0, 0, 0, 0, 0, 0 };
+    if (KtxFormat::blockBytes(format) == 16)
+    {
+        memcpy(block, alpha, sizeof(alpha));
+        memcpy(block + 8, color, sizeof(color));
+    }
+    else
+    {
+        memcpy(block, color, sizeof(color));
+    }
+}
+
+TextureArray::TextureArray()
+    : loader(nullptr), textureID(0), aspectsChanged(false)
+{
+}
+
+TextureArray::~TextureArray()
+{
+    release();
+}
+
+int TextureArray::addImage(const char* path)
+{
+    paths.push_back(path);
+    aspects.push_back(1.0f);
+    return (int)paths.size() - 1;
+}
+
+bool TextureArray::build(AsyncTextureLoader& layerLoader, int layerWidth, int layerHeight)
+{
+    if (paths.empty())
+        return false;
+
+    release();
+    loader = &layerLoader;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+
+    int levelCount = 1;
+    for (int w = layerWidth, h = layerHeight; w > 1 || h > 1; w = std::max(1, w / 2), h = std::max(1, h / 2))
+        levelCount++;
+    GLenum format = chooseLayerFormat(paths, layerWidth, layerHeight, levelCount);
+    uint32_t blockBytes = KtxFormat::blockBytes(format);
+
+    // Storage for every level up front; the loader fills each layer's chain
+    std::vector<unsigned char> grey;
+    if (blockBytes)
+    {
+        size_t blocks = (size_t)((layerWidth + 3) / 4) * ((layerHeight + 3) / 4) * paths.size();
+        grey.resize(blocks * blockBytes);
+        for (size_t i = 0; i < blocks; i++)
+            greyBlock(format, &grey[i * blockBytes]);
+    }
+    else
+    {
+        grey.assign((size_t)layerWidth * layerHeight * 4 * paths.size(), (unsigned char)128);
+    }
+
+    for (int level = 0, w = layerWidth, h = layerHeight; level < levelCount;
+        level++, w = std::max(1, w / 2), h = std::max(1, h / 2))
+    {
+        if (blockBytes)
+        {
+            GLsizei size = (GLsizei)((size_t)((w + 3) / 4) * ((h + 3) / 4) * paths.size() * blockBytes);
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, format, w, h, (GLsizei)paths.size(),
+                0, size, grey.data());
+        }
+        else
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, w, h, (GLsizei)paths.size(),
+                0, GL_RGBA, GL_UNSIGNED_BYTE, grey.data());
+        }
+    }
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        aspects[i] = 1.0f;
+        loader->LoadLayerAsync(paths[i].c_str(), textureID, (int)i, layerWidth, layerHeight, format,
+            [this](int layer, bool success, int sourceWidth, int sourceHeight) {
+                if (!success || sourceHeight == 0)
+                    return;
+                aspects[layer] = (float)sourceWidth / (float)sourceHeight;
+                aspectsChanged = true;
+            });
+    }
+    return true;
+}
+
+bool TextureArray::takeAspectChanges()
+{
+    bool changed = aspectsChanged;
+    aspectsChanged = false;
+    return changed;
+}
+
+void TextureArray::bind(GLenum textureUnit) const
+{
+    glActiveTexture(textureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+}
+
+void TextureArray::release()
+{
+    if (textureID)
+    {
+        // Queued layers hold the ID and callbacks capturing this
+        loader->cancel(textureID);
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+}
+
+GLuint TextureArray::getID() const
+{
+    return textureID;
+}
+
+int TextureArray::getLayerCount() const
+{
+    return (int)paths.size();
+}
+
+float TextureArray::getAspect(int layer) const
+{
+    return aspects[layer];
+}
@@ -0,0 +1,54 @@
+#ifndef TEXTURE_ARRAY_H
+#define TEXTURE_ARRAY_H
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+
+class AsyncTextureLoader;
+
+// Packs several images into one GL_TEXTURE_2D_ARRAY so that everything
+// sampling them can be drawn with a single bound texture. Every image is
+// resampled to the common layer size; its original aspect ratio is kept so
+// geometry can be sized to match.
+class TextureArray
+{
+public:
+    TextureArray();
+    ~TextureArray();
+
+    TextureArray(const TextureArray&) = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+
+    // Queue an image; returns the layer it will occupy
+    int addImage(const char* path);
+
+    // Allocate the array with a full mip chain, fill every layer with a
+    // neutral grey and stream the queued images in through the loader
+    // (decode, resample and mips on its workers, PBO uploads per layer).
+    // When every image has a cooked KTX of the layer size in one format
+    // (TextureCooker --size), the array takes that format and the layers
+    // upload straight from the mapped files. Layers that fail to load stay
+    // grey so indices stay stable. The loader must outlive the array;
+    // rebuilding or releasing cancels any layers it has not finished.
+    bool build(AsyncTextureLoader& loader, int layerWidth, int layerHeight);
+
+    // True once after any layer arrived with a new aspect ratio
+    bool takeAspectChanges();
+
+    void bind(GLenum textureUnit) const;
+    void release();
+
+    GLuint getID() const;
+    int getLayerCount() const;
+    float getAspect(int layer) const;   // source width / height, 1 until loaded
+
+private:
+    AsyncTextureLoader* loader;   // streaming the layers, set by build()
+    GLuint textureID;
+    std::vector<std::string> paths;
+    std::vector<float> aspects;
+    bool aspectsChanged;
+};
+
+#endif
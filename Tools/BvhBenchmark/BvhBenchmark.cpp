@@ -0,0 +1,124 @@
+// BVH benchmark
+//
+// Times build, refit, frustum and ray queries of the scene BVH on a large
+// synthetic scene: random boxes spread over a square "campus", viewed from
+// ground level. The classroom only has a few dozen objects, so this is how
+// the tree is checked to scale before more content goes in.
+//
+// Usage:
+//   BvhBenchmark [object-count] [seed]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../../BVH.h"
+#include "../../Frustum.h"
+
+using Clock = std::chrono::high_resolution_clock;
+
+static const float WORLD_SIZE = 2000.0f;
+static const int QUERY_COUNT = 1000;
+
+static double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::vector<AABB> makeScene(int count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> position(-WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f);
+    std::uniform_real_distribution<float> size(0.5f, 6.0f);
+    std::uniform_real_distribution<float> height(0.0f, 20.0f);
+
+    std::vector<AABB> bounds(count);
+    for (AABB& box : bounds)
+    {
+        glm::vec3 center(position(rng), height(rng), position(rng));
+        glm::vec3 extent(size(rng), size(rng), size(rng));
+        box.minCorner = center - extent * 0.5f;
+        box.maxCorner = center + extent * 0.5f;
+    }
+    return bounds;
+}
+
+int main(int argc, char** argv)
+{
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    unsigned seed = argc > 2 ? (unsigned)std::atoi(argv[2]) : 1u;
+    if (objectCount <= 0)
+    {
+        std::cout << "Usage: BvhBenchmark [object-count] [seed]" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 rng(seed);
+    std::vector<AABB> bounds = makeScene(objectCount, rng);
+
+    BVH bvh;
+    Clock::time_point start = Clock::now();
+    bvh.build(bounds);
+    double buildTime = millisecondsSince(start);
+
+    // Refit after moving a tenth of the objects a little, like doors and fans
+    std::uniform_real_distribution<float> nudge(-0.5f, 0.5f);
+    for (int i = 0; i < objectCount; i += 10)
+    {
+        glm::vec3 offset(nudge(rng), 0.0f, nudge(rng));
+        bounds[i].minCorner += offset;
+        bounds[i].maxCorner += offset;
+    }
+    start = Clock::now();
+    bvh.refit(bounds);
+    double refitTime = millisecondsSince(start);
+
+    // Cameras at eye height looking along random directions
+    std::uniform_real_distribution<float> position(-WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f);
+    std::uniform_real_distribution<float> angle(0.0f, glm::radians(360.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+
+    std::vector<int> results;
+    size_t visibleTotal = 0;
+    start = Clock::now();
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        glm::vec3 eye(position(rng), 1.7f, position(rng));
+        float yaw = angle(rng);
+        glm::vec3 forward(std::cos(yaw), 0.0f, std::sin(yaw));
+        glm::mat4 view = glm::lookAt(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        results.clear();
+        bvh.queryFrustum(Frustum::fromMatrix(projection * view), results);
+        visibleTotal += results.size();
+    }
+    double frustumTime = millisecondsSince(start) / QUERY_COUNT;
+
+    int hits = 0;
+    start = Clock::now();
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        glm::vec3 origin(position(rng), 1.7f, position(rng));
+        float yaw = angle(rng);
+        glm::vec3 direction(std::cos(yaw), -0.05f, std::sin(yaw));
+
+        float distance;
+        if (bvh.raycast(origin, direction, WORLD_SIZE, distance) >= 0)
+            hits++;
+    }
+    double rayTime = millisecondsSince(start) / QUERY_COUNT * 1000.0;
+
+    std::cout << objectCount << " objects, " << bvh.getNodeCount() << " nodes ("
+              << bvh.getNodeCount() * sizeof(BVHNode) / 1024 << " KB)" << std::endl;
+    std::cout << "  build:   " << buildTime << " ms" << std::endl;
+    std::cout << "  refit:   " << refitTime << " ms" << std::endl;
+    std::cout << "  frustum: " << frustumTime << " ms/query, "
+              << visibleTotal / QUERY_COUNT << " objects visible on average" << std::endl;
+    std::cout << "  ray:     " << rayTime << " us/query, "
+              << hits << "/" << QUERY_COUNT << " hit" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Procedural mesh generation benchmark
+//
+// Times Mesh::GenerateSphere (sin/cos tables, exact-size output, rows
+// written in parallel) against the generator it replaced, which evaluated
+// cos/sin for every quad corner and grew its vector one float at a time.
+// The default size is a 1024x512 sphere, the kind of high LOD the scene's
+// 32x16 ones would be swapped for up close.
+//
+// Usage:
+//   MeshBenchmark [x-segments] [y-segments] [runs]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../../mesh.h"
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double millisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// The previous generateSphere, kept as the baseline
+static void generateSphereBaseline(int xSegments, int ySegments, std::vector<float>& out)
+{
+    const float PI = 3.1415926f;
+    out.clear();
+
+    auto pushVertex = [&out](glm::vec3 p, float u, float v)
+        {
+            out.push_back(p.x);
+            out.push_back(p.y);
+            out.push_back(p.z);
+            out.push_back(p.x);
+            out.push_back(p.y);
+            out.push_back(p.z);
+            out.push_back(u);
+            out.push_back(v);
+        };
+
+    for (int y = 0; y < ySegments; ++y)
+    {
+        for (int x = 0; x < xSegments; ++x)
+        {
+            float x0 = (float)x / xSegments;
+            float x1 = (float)(x + 1) / xSegments;
+            float y0 = (float)y / ySegments;
+            float y1 = (float)(y + 1) / ySegments;
+
+            float theta0 = x0 * 2.0f * PI;
+            float theta1 = x1 * 2.0f * PI;
+            float phi0 = y0 * PI;
+            float phi1 = y1 * PI;
+
+            glm::vec3 p0(std::cos(theta0) * std::sin(phi0), std::cos(phi0), std::sin(theta0) * std::sin(phi0));
+            glm::vec3 p1(std::cos(theta1) * std::sin(phi0), std::cos(phi0), std::sin(theta1) * std::sin(phi0));
+            glm::vec3 p2(std::cos(theta1) * std::sin(phi1), std::cos(phi1), std::sin(theta1) * std::sin(phi1));
+            glm::vec3 p3(std::cos(theta0) * std::sin(phi1), std::cos(phi1), std::sin(theta0) * std::sin(phi1));
+
+            pushVertex(p0, x0, y0);
+            pushVertex(p1, x1, y0);
+            pushVertex(p2, x1, y1);
+            pushVertex(p0, x0, y0);
+            pushVertex(p2, x1, y1);
+            pushVertex(p3, x0, y1);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int xSegments = argc > 1 ? std::atoi(argv[1]) : 1024;
+    int ySegments = argc > 2 ? std::atoi(argv[2]) : 512;
+    int runs = argc > 3 ? std::atoi(argv[3]) : 5;
+    if (xSegments <= 0 || ySegments <= 0 || runs <= 0)
+    {
+        std::cout << "Usage: MeshBenchmark [x-segments] [y-segments] [runs]" << std::endl;
+        return 1;
+    }
+
+    // Best of several runs; each starts from an empty vector like a first GetVertices
+    double baselineTime = 1e30;
+    double generatorTime = 1e30;
+    std::vector<float> baseline;
+    std::vector<float> generated;
+    for (int run = 0; run < runs; run++)
+    {
+        std::vector<float>().swap(baseline);
+        Clock::time_point start = Clock::now();
+        generateSphereBaseline(xSegments, ySegments, baseline);
+        baselineTime = std::min(baselineTime, millisecondsSince(start));
+
+        std::vector<float>().swap(generated);
+        start = Clock::now();
+        Mesh::GenerateSphere(xSegments, ySegments, generated);
+        generatorTime = std::min(generatorTime, millisecondsSince(start));
+    }
+
+    float maxError = 0.0f;
+    for (size_t i = 0; i < generated.size() && i < baseline.size(); i++)
+        maxError = std::max(maxError, std::fabs(generated[i] - baseline[i]));
+
+    size_t vertexCount = generated.size() / 8;
+    std::cout << xSegments << "x" << ySegments << " sphere, " << vertexCount << " vertices ("
+              << generated.size() * sizeof(float) / (1024 * 1024) << " MB), "
+              << std::thread::hardware_concurrency() << " threads" << std::endl;
+    std::cout << "  baseline:  " << baselineTime << " ms" << std::endl;
+    std::cout << "  generator: " << generatorTime << " ms (" << baselineTime / generatorTime << "x)" << std::endl;
+    std::cout << "  max difference: " << maxError
+              << (generated.size() == baseline.size() ? "" : " (size mismatch)") << std::endl;
+    return 0;
+}
@@ -0,0 +1,757 @@
+#include "ModelImport.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+namespace {
+    // Just enough JSON for glTF: a tree of values, parsed in one pass
+    struct JsonValue {
+        enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+        Type type = NUL;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue* find(const char* key) const
+        {
+            for (const auto& member : members)
+                if (member.first == key)
+                    return &member.second;
+            return nullptr;
+        }
+
+        double numberOr(const char* key, double fallback) const
+        {
+            const JsonValue* value = find(key);
+            return value && value->type == NUMBER ? value->number : fallback;
+        }
+
+        int intOr(const char* key, int fallback) const
+        {
+            return (int)numberOr(key, fallback);
+        }
+
+        std::string stringOr(const char* key, const char* fallback) const
+        {
+            const JsonValue* value = find(key);
+            return value && value->type == STRING ? value->string : fallback;
+        }
+
+        // Numeric array member into floats; false if absent or too short
+        bool floats(const char* key, float* out, int count) const
+        {
+            const JsonValue* value = find(key);
+            if (!value || value->type != ARRAY || (int)value->array.size() < count)
+                return false;
+            for (int i = 0; i < count; i++)
+                out[i] = (float)value->array[i].number;
+            return true;
+        }
+    };
+
+    class JsonParser
+    {
+    public:
+        JsonParser(const char* begin, const char* end)
+            : cursor(begin), end(end), failed(false)
+        {
+        }
+
+        bool parse(JsonValue& root)
+        {
+            parseValue(root, 0);
+            skipSpace();
+            return !failed && cursor == end;
+        }
+
+    private:
+        static const int MAX_DEPTH = 256;
+
+        void skipSpace()
+        {
+            while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+                cursor++;
+        }
+
+        bool consume(char c)
+        {
+            skipSpace();
+            if (cursor < end && *cursor == c)
+            {
+                cursor++;
+                return true;
+            }
+            return false;
+        }
+
+        bool consumeWord(const char* word)
+        {
+            size_t length = strlen(word);
+            if ((size_t)(end - cursor) < length || memcmp(cursor, word, length) != 0)
+                return false;
+            cursor += length;
+            return true;
+        }
+
+        void appendUtf8(std::string& out, unsigned codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                out += (char)codePoint;
+            }
+            else if (codePoint < 0x800)
+            {
+                out += (char)(0xC0 | (codePoint >> 6));
+                out += (char)(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                out += (char)(0xE0 | (codePoint >> 12));
+                out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+                out += (char)(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        bool parseString(std::string& out)
+        {
+            if (!consume('"'))
+                return false;
+            while (cursor < end && *cursor != '"')
+            {
+                char c = *cursor++;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                if (cursor >= end)
+                    return false;
+                char escape = *cursor++;
+                switch (escape)
+                {
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u':
+                    if (end - cursor < 4)
+                        return false;
+                    appendUtf8(out, (unsigned)strtoul(std::string(cursor, cursor + 4).c_str(), nullptr, 16));
+                    cursor += 4;
+                    break;
+                default: out += escape; break;
+                }
+            }
+            return consume('"');
+        }
+
+        void parseValue(JsonValue& value, int depth)
+        {
+            skipSpace();
+            if (cursor >= end || depth > MAX_DEPTH)
+            {
+                failed = true;
+                return;
+            }
+
+            char c = *cursor;
+            if (c == '{')
+            {
+                value.type = JsonValue::OBJECT;
+                cursor++;
+                if (consume('}'))
+                    return;
+                do
+                {
+                    std::string key;
+                    skipSpace();
+                    if (!parseString(key) || !consume(':'))
+                    {
+                        failed = true;
+                        return;
+                    }
+                    value.members.emplace_back(std::move(key), JsonValue());
+                    parseValue(value.members.back().second, depth + 1);
+                } while (!failed && consume(','));
+                failed = failed || !consume('}');
+            }
+            else if (c == '[')
+            {
+                value.type = JsonValue::ARRAY;
+                cursor++;
+                if (consume(']'))
+                    return;
+                do
+                {
+                    value.array.emplace_back();
+                    parseValue(value.array.back(), depth + 1);
+                } while (!failed && consume(','));
+                failed = failed || !consume(']');
+            }
+            else if (c == '"')
+            {
+                value.type = JsonValue::STRING;
+                failed = !parseString(value.string);
+            }
+            else if (consumeWord("true"))
+            {
+                value.type = JsonValue::BOOLEAN;
+                value.boolean = true;
+            }
+            else if (consumeWord("false"))
+            {
+                value.type = JsonValue::BOOLEAN;
+            }
+            else if (consumeWord("null"))
+            {
+                value.type = JsonValue::NUL;
+            }
+            else
+            {
+                // strtod needs a terminated string; numbers are short
+                const char* start = cursor;
+                while (cursor < end && *cursor && strchr("+-0123456789.eE", *cursor))
+                    cursor++;
+                std::string text(start, cursor);
+                char* parsedEnd = nullptr;
+                value.type = JsonValue::NUMBER;
+                value.number = strtod(text.c_str(), &parsedEnd);
+                failed = text.empty() || parsedEnd != text.c_str() + text.size();
+            }
+        }
+
+        const char* cursor;
+        const char* end;
+        bool failed;
+    };
+}
+
+// ============================================================================
+// BUFFERS AND ACCESSORS
+// ============================================================================
+
+namespace {
+    const uint32_t GLB_MAGIC = 0x46546C67;         // "glTF"
+    const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+    const uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+    const int COMPONENT_BYTE = 5120;
+    const int COMPONENT_UNSIGNED_BYTE = 5121;
+    const int COMPONENT_SHORT = 5122;
+    const int COMPONENT_UNSIGNED_SHORT = 5123;
+    const int COMPONENT_UNSIGNED_INT = 5125;
+    const int COMPONENT_FLOAT = 5126;
+
+    const int MODE_TRIANGLES = 4;
+
+    bool readFile(const fs::path& path, std::vector<unsigned char>& bytes)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    bool decodeBase64(const std::string& text, size_t start, std::vector<unsigned char>& bytes)
+    {
+        uint32_t accumulator = 0;
+        int bits = 0;
+        for (size_t i = start; i < text.size() && text[i] != '='; i++)
+        {
+            char c = text[i];
+            int digit;
+            if (c >= 'A' && c <= 'Z')      digit = c - 'A';
+            else if (c >= 'a' && c <= 'z') digit = c - 'a' + 26;
+            else if (c >= '0' && c <= '9') digit = c - '0' + 52;
+            else if (c == '+')             digit = 62;
+            else if (c == '/')             digit = 63;
+            else return false;
+
+            accumulator = (accumulator << 6) | (uint32_t)digit;
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                bytes.push_back((unsigned char)((accumulator >> bits) & 0xFF));
+            }
+        }
+        return true;
+    }
+
+    int componentCount(const std::string& type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2")   return 2;
+        if (type == "VEC3")   return 3;
+        if (type == "VEC4")   return 4;
+        if (type == "MAT4")   return 16;
+        return 0;
+    }
+
+    int componentSize(int componentType)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_BYTE:
+        case COMPONENT_UNSIGNED_BYTE:  return 1;
+        case COMPONENT_SHORT:
+        case COMPONENT_UNSIGNED_SHORT: return 2;
+        case COMPONENT_UNSIGNED_INT:
+        case COMPONENT_FLOAT:          return 4;
+        default:                       return 0;
+        }
+    }
+
+    float readComponent(const unsigned char* source, int componentType, bool normalized)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_BYTE:
+        {
+            int8_t v; memcpy(&v, source, 1);
+            return normalized ? std::max(v / 127.0f, -1.0f) : v;
+        }
+        case COMPONENT_UNSIGNED_BYTE:
+            return normalized ? source[0] / 255.0f : source[0];
+        case COMPONENT_SHORT:
+        {
+            int16_t v; memcpy(&v, source, 2);
+            return normalized ? std::max(v / 32767.0f, -1.0f) : v;
+        }
+        case COMPONENT_UNSIGNED_SHORT:
+        {
+            uint16_t v; memcpy(&v, source, 2);
+            return normalized ? v / 65535.0f : v;
+        }
+        case COMPONENT_UNSIGNED_INT:
+        {
+            uint32_t v; memcpy(&v, source, 4);
+            return (float)v;
+        }
+        default:
+        {
+            float v; memcpy(&v, source, 4);
+            return v;
+        }
+        }
+    }
+
+    struct GltfDocument {
+        JsonValue json;
+        std::vector<std::vector<unsigned char>> buffers;
+
+        const JsonValue* element(const char* list, int index) const
+        {
+            const JsonValue* array = json.find(list);
+            if (!array || array->type != JsonValue::ARRAY || index < 0 || index >= (int)array->array.size())
+                return nullptr;
+            return &array->array[index];
+        }
+
+        // Accessor as floats (components per element in 'width'); indices
+        // go through the same path, exact below 2^24 vertices
+        bool readAccessor(int index, std::vector<float>& out, int& width) const
+        {
+            const JsonValue* accessor = element("accessors", index);
+            if (!accessor)
+                return false;
+            if (accessor->find("sparse"))
+            {
+                std::cout << "Sparse accessors are not supported" << std::endl;
+                return false;
+            }
+
+            int count = accessor->intOr("count", 0);
+            int componentType = accessor->intOr("componentType", 0);
+            bool normalized = accessor->find("normalized") && accessor->find("normalized")->boolean;
+            width = componentCount(accessor->stringOr("type", ""));
+            int size = componentSize(componentType);
+            if (width == 0 || size == 0)
+                return false;
+
+            out.assign((size_t)count * width, 0.0f);
+            const JsonValue* view = element("bufferViews", accessor->intOr("bufferView", -1));
+            if (!view)
+                return true;     // No view: all zeros, per the spec
+
+            int bufferIndex = view->intOr("buffer", -1);
+            if (bufferIndex < 0 || bufferIndex >= (int)buffers.size())
+                return false;
+            const std::vector<unsigned char>& buffer = buffers[bufferIndex];
+
+            size_t elementSize = (size_t)size * width;
+            size_t stride = (size_t)view->intOr("byteStride", 0);
+            if (stride == 0)
+                stride = elementSize;
+            size_t offset = (size_t)view->intOr("byteOffset", 0) + (size_t)accessor->intOr("byteOffset", 0);
+            size_t viewEnd = (size_t)view->intOr("byteOffset", 0) + (size_t)view->intOr("byteLength", 0);
+            if (count > 0 && (offset + stride * (count - 1) + elementSize > viewEnd || viewEnd > buffer.size()))
+                return false;
+
+            for (int i = 0; i < count; i++)
+            {
+                const unsigned char* source = &buffer[offset + stride * i];
+                for (int c = 0; c < width; c++)
+                    out[(size_t)i * width + c] = readComponent(source + c * size, componentType, normalized);
+            }
+            return true;
+        }
+    };
+
+    bool loadBuffers(GltfDocument& document, const fs::path& directory, std::vector<unsigned char>& glbChunk)
+    {
+        const JsonValue* buffers = document.json.find("buffers");
+        if (!buffers)
+            return true;
+        for (size_t b = 0; b < buffers->array.size(); b++)
+        {
+            const JsonValue& buffer = buffers->array[b];
+            std::string uri = buffer.stringOr("uri", "");
+            std::vector<unsigned char> bytes;
+            if (uri.empty())
+            {
+                bytes = b == 0 ? glbChunk : std::vector<unsigned char>();
+            }
+            else if (uri.compare(0, 5, "data:") == 0)
+            {
+                size_t comma = uri.find(',');
+                if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos ||
+                    !decodeBase64(uri, comma + 1, bytes))
+                {
+                    std::cout << "Unsupported buffer URI in buffer " << b << std::endl;
+                    return false;
+                }
+            }
+            else if (!readFile(directory / fs::u8path(uri), bytes))
+            {
+                std::cout << "Failed to open buffer: " << (directory / fs::u8path(uri)).string() << std::endl;
+                return false;
+            }
+
+            if (bytes.size() < (size_t)buffer.intOr("byteLength", 0))
+            {
+                std::cout << "Buffer " << b << " is shorter than its byteLength" << std::endl;
+                return false;
+            }
+            document.buffers.push_back(std::move(bytes));
+        }
+        return true;
+    }
+}
+
+// ============================================================================
+// SCENE
+// ============================================================================
+
+namespace {
+    // Blinn-Phong stand-ins for the metallic-roughness factors: metals tint
+    // their highlight and lose their diffuse, rough surfaces get a broad,
+    // dim highlight. Ambient stays at a fifth of the base colour so fully
+    // metallic parts are not black under the scene's lights.
+    ImportedMaterial convertMaterial(const JsonValue& material, int index)
+    {
+        ImportedMaterial result = ModelImport::defaultMaterial(material.stringOr("name", ""));
+        if (result.name.empty())
+            result.name = "material" + std::to_string(index);
+
+        float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        float metallic = 1.0f;
+        float roughness = 1.0f;
+        if (const JsonValue* pbr = material.find("pbrMetallicRoughness"))
+        {
+            pbr->floats("baseColorFactor", baseColor, 4);
+            metallic = (float)pbr->numberOr("metallicFactor", 1.0);
+            roughness = (float)pbr->numberOr("roughnessFactor", 1.0);
+        }
+
+        glm::vec3 base(baseColor[0], baseColor[1], baseColor[2]);
+        result.diffuse = base * (1.0f - metallic);
+        result.ambient = base * 0.2f;
+        result.specular = glm::mix(glm::vec3(0.04f), base, metallic) * (1.0f - 0.5f * roughness);
+
+        float alphaRoughness = std::max(roughness * roughness, 0.01f);
+        result.shininess = std::min(std::max(2.0f / (alphaRoughness * alphaRoughness) - 2.0f, 1.0f), 256.0f);
+        result.alpha = material.stringOr("alphaMode", "OPAQUE") == "BLEND" ? baseColor[3] : 1.0f;
+        return result;
+    }
+
+    glm::mat4 nodeTransform(const JsonValue& node)
+    {
+        float matrix[16];
+        if (node.floats("matrix", matrix, 16))
+            return glm::make_mat4(matrix);     // Column-major, like glm
+
+        float translation[3] = { 0.0f, 0.0f, 0.0f };
+        float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };   // x, y, z, w
+        float scale[3] = { 1.0f, 1.0f, 1.0f };
+        node.floats("translation", translation, 3);
+        node.floats("rotation", rotation, 4);
+        node.floats("scale", scale, 3);
+
+        glm::quat q(rotation[3], rotation[0], rotation[1], rotation[2]);
+        glm::mat4 result = glm::mat4_cast(q);
+        result[0] *= scale[0];
+        result[1] *= scale[1];
+        result[2] *= scale[2];
+        result[3] = glm::vec4(translation[0], translation[1], translation[2], 1.0f);
+        return result;
+    }
+
+    class SceneImporter
+    {
+    public:
+        SceneImporter(const GltfDocument& document, ImportedModel& model)
+            : document(document), model(model)
+        {
+        }
+
+        bool importNode(int nodeIndex, const glm::mat4& parent, int depth)
+        {
+            const JsonValue* node = document.element("nodes", nodeIndex);
+            if (!node || depth > 64)
+                return false;
+
+            glm::mat4 world = parent * nodeTransform(*node);
+            int meshIndex = node->intOr("mesh", -1);
+            if (meshIndex >= 0 && !importMesh(meshIndex, world))
+                return false;
+
+            if (const JsonValue* children = node->find("children"))
+            {
+                for (const JsonValue& child : children->array)
+                    if (!importNode((int)child.number, world, depth + 1))
+                        return false;
+            }
+            return true;
+        }
+
+        bool importMesh(int meshIndex, const glm::mat4& world)
+        {
+            const JsonValue* mesh = document.element("meshes", meshIndex);
+            const JsonValue* primitives = mesh ? mesh->find("primitives") : nullptr;
+            if (!primitives)
+                return false;
+
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+            bool mirrored = glm::determinant(glm::mat3(world)) < 0.0f;
+
+            for (const JsonValue& primitive : primitives->array)
+            {
+                if (primitive.intOr("mode", MODE_TRIANGLES) != MODE_TRIANGLES)
+                {
+                    std::cout << "Skipping non-triangle primitive in mesh " << meshIndex << std::endl;
+                    continue;
+                }
+                const JsonValue* attributes = primitive.find("attributes");
+                if (!attributes || !attributes->find("POSITION"))
+                    continue;
+
+                std::vector<float> positions, normals, texCoords, indexValues;
+                int width = 0;
+                if (!document.readAccessor(attributes->intOr("POSITION", -1), positions, width) || width != 3)
+                    return false;
+                size_t vertexCount = positions.size() / 3;
+
+                bool hasNormals = attributes->find("NORMAL") != nullptr;
+                if (hasNormals && (!document.readAccessor(attributes->intOr("NORMAL", -1), normals, width) ||
+                    width != 3 || normals.size() != positions.size()))
+                    return false;
+                bool hasTexCoords = attributes->find("TEXCOORD_0") != nullptr;
+                if (hasTexCoords && (!document.readAccessor(attributes->intOr("TEXCOORD_0", -1), texCoords, width) ||
+                    width != 2 || texCoords.size() != vertexCount * 2))
+                    return false;
+
+                std::vector<uint32_t> indices;
+                if (primitive.find("indices"))
+                {
+                    if (!document.readAccessor(primitive.intOr("indices", -1), indexValues, width) || width != 1)
+                        return false;
+                    for (float value : indexValues)
+                    {
+                        if (value < 0.0f || value >= (float)vertexCount)
+                            return false;
+                        indices.push_back((uint32_t)value);
+                    }
+                }
+                else
+                {
+                    for (size_t v = 0; v < vertexCount; v++)
+                        indices.push_back((uint32_t)v);
+                }
+                indices.resize(indices.size() / 3 * 3);
+                if (mirrored)
+                {
+                    for (size_t i = 0; i < indices.size(); i += 3)
+                        std::swap(indices[i + 1], indices[i + 2]);
+                }
+
+                // Vertices in world space, appended after everything imported so far
+                std::vector<float> vertices(vertexCount * ModelImport::FLOATS_PER_VERTEX);
+                for (size_t v = 0; v < vertexCount; v++)
+                {
+                    float* vertex = &vertices[v * ModelImport::FLOATS_PER_VERTEX];
+                    glm::vec3 position = glm::vec3(world * glm::vec4(
+                        positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2], 1.0f));
+                    glm::vec3 normal(0.0f, 1.0f, 0.0f);
+                    if (hasNormals)
+                    {
+                        normal = normalMatrix * glm::vec3(normals[v * 3], normals[v * 3 + 1], normals[v * 3 + 2]);
+                        float length = glm::length(normal);
+                        normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                    }
+                    vertex[0] = position.x;
+                    vertex[1] = position.y;
+                    vertex[2] = position.z;
+                    vertex[3] = normal.x;
+                    vertex[4] = normal.y;
+                    vertex[5] = normal.z;
+                    // glTF puts the UV origin top-left
+                    vertex[6] = hasTexCoords ? texCoords[v * 2] : 0.0f;
+                    vertex[7] = hasTexCoords ? 1.0f - texCoords[v * 2 + 1] : 0.0f;
+                }
+                if (!hasNormals)
+                    ModelImport::generateNormals(vertices, indices);
+
+                uint32_t baseVertex = (uint32_t)(model.vertices.size() / ModelImport::FLOATS_PER_VERTEX);
+                model.vertices.insert(model.vertices.end(), vertices.begin(), vertices.end());
+
+                ImportedSubmesh& submesh = submeshFor(primitive.intOr("material", -1));
+                for (uint32_t index : indices)
+                    submesh.indices.push_back(baseVertex + index);
+            }
+            return true;
+        }
+
+    private:
+        // glTF material i is model material i; primitives without one share
+        // a default appended after them
+        ImportedSubmesh& submeshFor(int material)
+        {
+            int materialCount = 0;
+            if (const JsonValue* materials = document.json.find("materials"))
+                materialCount = (int)materials->array.size();
+            if (material < 0 || material >= materialCount)
+            {
+                material = materialCount;
+                if ((int)model.materials.size() == materialCount)
+                    model.materials.push_back(ModelImport::defaultMaterial("default"));
+            }
+
+            for (ImportedSubmesh& submesh : model.submeshes)
+                if (submesh.material == material)
+                    return submesh;
+            model.submeshes.push_back(ImportedSubmesh{ material, {} });
+            return model.submeshes.back();
+        }
+
+        const GltfDocument& document;
+        ImportedModel& model;
+    };
+}
+
+bool ModelImport::importGltf(const std::string& path, ImportedModel& model)
+{
+    std::vector<unsigned char> bytes;
+    if (!readFile(path, bytes))
+    {
+        std::cout << "Failed to open: " << path << std::endl;
+        return false;
+    }
+
+    // .glb: 12-byte header, then a JSON chunk and an optional binary chunk
+    const char* jsonBegin = (const char*)bytes.data();
+    const char* jsonEnd = jsonBegin + bytes.size();
+    std::vector<unsigned char> glbChunk;
+    uint32_t magic = 0;
+    if (bytes.size() >= 12)
+        memcpy(&magic, bytes.data(), 4);
+    if (magic == GLB_MAGIC)
+    {
+        size_t offset = 12;
+        bool hasJson = false;
+        while (offset + 8 <= bytes.size())
+        {
+            uint32_t chunkLength, chunkType;
+            memcpy(&chunkLength, &bytes[offset], 4);
+            memcpy(&chunkType, &bytes[offset + 4], 4);
+            offset += 8;
+            if (offset + chunkLength > bytes.size())
+                break;
+            if (chunkType == GLB_CHUNK_JSON && !hasJson)
+            {
+                jsonBegin = (const char*)&bytes[offset];
+                jsonEnd = jsonBegin + chunkLength;
+                hasJson = true;
+            }
+            else if (chunkType == GLB_CHUNK_BIN && glbChunk.empty())
+            {
+                glbChunk.assign(bytes.begin() + offset, bytes.begin() + offset + chunkLength);
+            }
+            offset += chunkLength;
+        }
+        if (!hasJson)
+        {
+            std::cout << "GLB without a JSON chunk: " << path << std::endl;
+            return false;
+        }
+    }
+
+    GltfDocument document;
+    if (!JsonParser(jsonBegin, jsonEnd).parse(document.json) || document.json.type != JsonValue::OBJECT)
+    {
+        std::cout << "Invalid glTF JSON: " << path << std::endl;
+        return false;
+    }
+    if (!loadBuffers(document, fs::path(path).parent_path(), glbChunk))
+        return false;
+
+    if (const JsonValue* materials = document.json.find("materials"))
+    {
+        for (size_t m = 0; m < materials->array.size(); m++)
+            model.materials.push_back(convertMaterial(materials->array[m], (int)m));
+    }
+
+    // The default scene's root nodes, or every mesh untransformed when the
+    // file has no scenes at all
+    SceneImporter importer(document, model);
+    const JsonValue* scene = document.element("scenes", document.json.intOr("scene", 0));
+    bool imported = true;
+    if (scene)
+    {
+        if (const JsonValue* nodes = scene->find("nodes"))
+            for (const JsonValue& node : nodes->array)
+                imported = imported && importer.importNode((int)node.number, glm::mat4(1.0f), 0);
+    }
+    else if (const JsonValue* meshes = document.json.find("meshes"))
+    {
+        for (size_t m = 0; m < meshes->array.size(); m++)
+            imported = imported && importer.importMesh((int)m, glm::mat4(1.0f));
+    }
+
+    if (!imported)
+    {
+        std::cout << "Invalid or unsupported glTF data: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
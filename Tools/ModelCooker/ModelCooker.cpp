@@ -0,0 +1,262 @@
+// Offline model cooker
+//
+// Imports OBJ (with MTL) and glTF 2.0 (.gltf/.glb) models and writes them in
+// the renderer's own format (CookedMeshFormat.h): vertices already encoded
+// as VertexFormat.h lays them out, 32-bit indices grouped by material and
+// cut into meshlets, materials mapped onto ambient/diffuse/specular, and the
+// bounds. CookedModel memory-maps the result and uploads it as is.
+//
+// Usage:
+//   ModelCooker <model-or-directory>...
+//
+// Each input "dir/name.obj" (or .gltf/.glb) is written to "dir/name.mesh".
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../CookedMeshFormat.h"
+#include "../../MeshletMesh.h"
+#include "../../MeshOptimizer.h"
+#include "../../VertexFormat.h"
+#include "ModelImport.h"
+
+namespace fs = std::filesystem;
+
+struct CookedData {
+    std::vector<CookedMeshFormat::Material> materials;
+    std::vector<CookedMeshFormat::Submesh> submeshes;
+    std::vector<CookedMeshFormat::Meshlet> meshlets;
+    std::vector<unsigned char> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t vertexCount = 0;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    float positionScale = 1.0f;
+};
+
+static void copyVec3(const glm::vec3& value, float* out)
+{
+    out[0] = value.x;
+    out[1] = value.y;
+    out[2] = value.z;
+}
+
+// ============================================================================
+// COOKING
+// ============================================================================
+
+static CookedMeshFormat::Material cookMaterial(const ImportedMaterial& material)
+{
+    CookedMeshFormat::Material cooked;
+    copyVec3(material.ambient, cooked.ambient);
+    copyVec3(material.diffuse, cooked.diffuse);
+    copyVec3(material.specular, cooked.specular);
+    cooked.alpha = material.alpha;
+    cooked.shininess = material.shininess;
+    return cooked;
+}
+
+static CookedMeshFormat::Meshlet cookMeshlet(const Meshlet& meshlet, uint32_t indexOffset)
+{
+    CookedMeshFormat::Meshlet cooked;
+    cooked.firstIndex = meshlet.firstIndex + indexOffset;
+    cooked.indexCount = meshlet.indexCount;
+    cooked.vertexCount = (uint32_t)meshlet.vertexCount;
+    copyVec3(meshlet.sphere.center, cooked.sphere);
+    cooked.sphere[3] = meshlet.sphere.radius;
+    copyVec3(meshlet.bounds.minCorner, cooked.boundsMin);
+    copyVec3(meshlet.bounds.maxCorner, cooked.boundsMax);
+    copyVec3(meshlet.coneApex, cooked.coneApex);
+    copyVec3(meshlet.coneAxis, cooked.coneAxis);
+    cooked.coneCutoff = meshlet.coneCutoff;
+    return cooked;
+}
+
+static void cook(const ImportedModel& model, CookedData& cooked)
+{
+    // Unused materials are dropped, the rest keep their order
+    std::vector<int> materialRemap(model.materials.size(), -1);
+    for (const ImportedSubmesh& submesh : model.submeshes)
+    {
+        if (submesh.indices.size() < 3 || materialRemap[submesh.material] >= 0)
+            continue;
+        materialRemap[submesh.material] = (int)cooked.materials.size();
+        cooked.materials.push_back(cookMaterial(model.materials[submesh.material]));
+    }
+
+    // Per submesh: vertex-cache order and meshlets (MeshletMesh does both),
+    // appended to one index list
+    std::vector<GLuint> indices;
+    for (const ImportedSubmesh& submesh : model.submeshes)
+    {
+        if (submesh.indices.size() < 3)
+            continue;
+
+        MeshletMesh meshletMesh;
+        meshletMesh.build(model.vertices, std::vector<GLuint>(submesh.indices.begin(), submesh.indices.end()));
+
+        CookedMeshFormat::Submesh cookedSubmesh;
+        cookedSubmesh.material = (uint32_t)materialRemap[submesh.material];
+        cookedSubmesh.firstIndex = (uint32_t)indices.size();
+        cookedSubmesh.indexCount = (uint32_t)meshletMesh.getIndices().size();
+        cookedSubmesh.firstMeshlet = (uint32_t)cooked.meshlets.size();
+        cookedSubmesh.meshletCount = (uint32_t)meshletMesh.getMeshlets().size();
+        cooked.submeshes.push_back(cookedSubmesh);
+
+        for (const Meshlet& meshlet : meshletMesh.getMeshlets())
+            cooked.meshlets.push_back(cookMeshlet(meshlet, cookedSubmesh.firstIndex));
+        indices.insert(indices.end(), meshletMesh.getIndices().begin(), meshletMesh.getIndices().end());
+    }
+
+    // Vertices in first-use order; ones no triangle references disappear
+    int sourceVertexCount = (int)(model.vertices.size() / ModelImport::FLOATS_PER_VERTEX);
+    std::vector<GLuint> remap = MeshOptimizer::optimizeVertexFetch(indices, sourceVertexCount);
+    cooked.indices.assign(indices.begin(), indices.end());
+    cooked.vertexCount = (uint32_t)remap.size();
+    cooked.vertices.resize(remap.size() * VertexFormat::VERTEX_SIZE);
+
+    // Bounds first: they pick the scale the positions are quantised against
+    cooked.boundsMin = glm::vec3(remap.empty() ? 0.0f : 1e30f);
+    cooked.boundsMax = glm::vec3(remap.empty() ? 0.0f : -1e30f);
+    for (GLuint source : remap)
+    {
+        const float* vertex = &model.vertices[source * ModelImport::FLOATS_PER_VERTEX];
+        glm::vec3 position(vertex[0], vertex[1], vertex[2]);
+        cooked.boundsMin = glm::min(cooked.boundsMin, position);
+        cooked.boundsMax = glm::max(cooked.boundsMax, position);
+    }
+    glm::vec3 maxAbs = glm::max(glm::abs(cooked.boundsMin), glm::abs(cooked.boundsMax));
+    cooked.positionScale = VertexFormat::positionScale(glm::max(maxAbs.x, glm::max(maxAbs.y, maxAbs.z)));
+
+    for (size_t v = 0; v < remap.size(); v++)
+    {
+        const float* source = &model.vertices[remap[v] * ModelImport::FLOATS_PER_VERTEX];
+        VertexFormat::encode(source, cooked.positionScale, &cooked.vertices[v * VertexFormat::VERTEX_SIZE]);
+    }
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+static bool writeCookedMesh(const fs::path& outPath, const CookedData& cooked)
+{
+    CookedMeshFormat::Header header = {};
+    memcpy(header.magic, CookedMeshFormat::MAGIC, sizeof(CookedMeshFormat::MAGIC));
+    header.version = CookedMeshFormat::VERSION;
+    header.vertexSize = (uint32_t)VertexFormat::VERTEX_SIZE;
+    header.vertexCount = cooked.vertexCount;
+    header.indexCount = (uint32_t)cooked.indices.size();
+    header.materialCount = (uint32_t)cooked.materials.size();
+    header.submeshCount = (uint32_t)cooked.submeshes.size();
+    header.meshletCount = (uint32_t)cooked.meshlets.size();
+    copyVec3(cooked.boundsMin, header.boundsMin);
+    copyVec3(cooked.boundsMax, header.boundsMax);
+    header.positionScale = cooked.positionScale;
+
+    FILE* file = fopen(outPath.string().c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "Failed to open for writing: " << outPath.string() << std::endl;
+        return false;
+    }
+
+    CookedMeshFormat::Layout layout = CookedMeshFormat::computeLayout(header);
+    const unsigned char padding[3] = { 0, 0, 0 };
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(cooked.materials.data(), sizeof(CookedMeshFormat::Material), cooked.materials.size(), file);
+    fwrite(cooked.submeshes.data(), sizeof(CookedMeshFormat::Submesh), cooked.submeshes.size(), file);
+    fwrite(cooked.meshlets.data(), sizeof(CookedMeshFormat::Meshlet), cooked.meshlets.size(), file);
+    fwrite(cooked.vertices.data(), 1, cooked.vertices.size(), file);
+    fwrite(padding, 1, (size_t)(layout.indices - layout.vertices - cooked.vertices.size()), file);
+    fwrite(cooked.indices.data(), sizeof(uint32_t), cooked.indices.size(), file);
+
+    bool written = ftell(file) == (long)layout.totalSize;
+    fclose(file);
+    if (!written)
+        std::cout << "Failed to write: " << outPath.string() << std::endl;
+    return written;
+}
+
+// ============================================================================
+// DRIVER
+// ============================================================================
+
+static std::string lowerExtension(const fs::path& path)
+{
+    std::string ext = path.extension().string();
+    for (char& c : ext)
+        c = (char)tolower((unsigned char)c);
+    return ext;
+}
+
+static bool isSourceModel(const fs::path& path)
+{
+    std::string ext = lowerExtension(path);
+    return ext == ".obj" || ext == ".gltf" || ext == ".glb";
+}
+
+static bool cookModel(const fs::path& inPath)
+{
+    ImportedModel model;
+    bool imported = lowerExtension(inPath) == ".obj"
+        ? ModelImport::importObj(inPath.string(), model)
+        : ModelImport::importGltf(inPath.string(), model);
+    if (!imported)
+        return false;
+
+    CookedData cooked;
+    cook(model, cooked);
+    if (cooked.indices.empty())
+    {
+        std::cout << "No triangles in " << inPath.string() << std::endl;
+        return false;
+    }
+
+    fs::path outPath = inPath;
+    outPath.replace_extension(".mesh");
+    if (!writeCookedMesh(outPath, cooked))
+        return false;
+
+    std::cout << inPath.string() << " -> " << outPath.string() << " ("
+        << cooked.vertexCount << " vertices, " << cooked.indices.size() / 3 << " triangles, "
+        << cooked.materials.size() << " materials, " << cooked.meshlets.size() << " meshlets, "
+        << fs::file_size(outPath) << " bytes)" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<fs::path> inputs;
+    for (int i = 1; i < argc; i++)
+        inputs.push_back(argv[i]);
+
+    if (inputs.empty())
+    {
+        std::cout << "Usage: ModelCooker <model-or-directory>..." << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const fs::path& input : inputs)
+    {
+        if (fs::is_directory(input))
+        {
+            for (const fs::directory_entry& entry : fs::directory_iterator(input))
+                if (entry.is_regular_file() && isSourceModel(entry.path()))
+                    failures += cookModel(entry.path()) ? 0 : 1;
+        }
+        else
+        {
+            failures += cookModel(input) ? 0 : 1;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
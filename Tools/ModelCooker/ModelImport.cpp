@@ -0,0 +1,41 @@
+#include "ModelImport.h"
+
+ImportedMaterial ModelImport::defaultMaterial(const std::string& name)
+{
+    // Matches the neutral grey the scene uses for unpainted furniture
+    ImportedMaterial material;
+    material.name = name;
+    material.ambient = glm::vec3(0.2f);
+    material.diffuse = glm::vec3(0.8f);
+    material.specular = glm::vec3(0.2f);
+    material.alpha = 1.0f;
+    material.shininess = 32.0f;
+    return material;
+}
+
+void ModelImport::generateNormals(std::vector<float>& vertices, const std::vector<uint32_t>& indices)
+{
+    std::vector<glm::vec3> normals(vertices.size() / FLOATS_PER_VERTEX, glm::vec3(0.0f));
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const float* a = &vertices[indices[i] * FLOATS_PER_VERTEX];
+        const float* b = &vertices[indices[i + 1] * FLOATS_PER_VERTEX];
+        const float* c = &vertices[indices[i + 2] * FLOATS_PER_VERTEX];
+        glm::vec3 pa(a[0], a[1], a[2]);
+        // Unnormalised cross product: larger triangles weigh more
+        glm::vec3 normal = glm::cross(glm::vec3(b[0], b[1], b[2]) - pa, glm::vec3(c[0], c[1], c[2]) - pa);
+        for (int corner = 0; corner < 3; corner++)
+            normals[indices[i + corner]] += normal;
+    }
+
+    for (uint32_t index : indices)
+    {
+        glm::vec3 normal = normals[index];
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        float* vertex = &vertices[index * FLOATS_PER_VERTEX];
+        vertex[3] = normal.x;
+        vertex[4] = normal.y;
+        vertex[5] = normal.z;
+    }
+}
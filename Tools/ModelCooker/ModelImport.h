@@ -0,0 +1,51 @@
+#ifndef MODEL_IMPORT_H
+#define MODEL_IMPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Material already mapped onto the renderer's ambient/diffuse/specular model
+struct ImportedMaterial {
+    std::string name;
+    glm::vec3 ambient;
+    glm::vec3 diffuse;
+    glm::vec3 specular;
+    float alpha;
+    float shininess;
+};
+
+// Triangles using one material, indexing ImportedModel::vertices
+struct ImportedSubmesh {
+    int material;
+    std::vector<uint32_t> indices;
+};
+
+// Source-format independent result of an import: one shared vertex list
+// (8 floats per vertex: position, normal, UV, like Mesh), node transforms
+// baked in, normals present (smooth ones generated where the file had none)
+// and UVs with OpenGL's bottom-left origin.
+struct ImportedModel {
+    std::vector<float> vertices;
+    std::vector<ImportedMaterial> materials;
+    std::vector<ImportedSubmesh> submeshes;
+};
+
+namespace ModelImport {
+    const int FLOATS_PER_VERTEX = 8;
+
+    // Wavefront OBJ with its MTL libraries. Polygons are fan-triangulated.
+    bool importObj(const std::string& path, ImportedModel& model);
+
+    // glTF 2.0, .gltf (external or data-URI buffers) or .glb. Only triangle
+    // primitives are imported; textures are ignored, factors are kept.
+    bool importGltf(const std::string& path, ImportedModel& model);
+
+    ImportedMaterial defaultMaterial(const std::string& name);
+
+    // Area-weighted smooth normals for the vertices of the given triangles
+    void generateNormals(std::vector<float>& vertices, const std::vector<uint32_t>& indices);
+}
+
+#endif
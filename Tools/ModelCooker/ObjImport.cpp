@@ -0,0 +1,302 @@
+#include "ModelImport.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // One face corner: 0-based position / UV / normal index, -1 when absent
+    struct Corner {
+        int position;
+        int texCoord;
+        int normal;
+
+        bool operator<(const Corner& other) const
+        {
+            return std::tie(position, texCoord, normal) < std::tie(other.position, other.texCoord, other.normal);
+        }
+    };
+
+    glm::vec3 readVec3(std::istringstream& line)
+    {
+        glm::vec3 value(0.0f);
+        line >> value.x >> value.y >> value.z;
+        return value;
+    }
+
+    // OBJ indices are 1-based, negative ones count back from the newest element
+    int resolveIndex(const std::string& token, int count)
+    {
+        if (token.empty())
+            return -1;
+        int index = atoi(token.c_str());
+        if (index > 0)
+            return index - 1 < count ? index - 1 : -2;
+        if (index < 0)
+            return count + index >= 0 ? count + index : -2;
+        return -2;
+    }
+
+    // "v", "v/vt", "v//vn" or "v/vt/vn"; false for out-of-range indices
+    bool parseCorner(const std::string& token, int positionCount, int texCoordCount, int normalCount,
+        Corner& corner)
+    {
+        std::string parts[3];
+        size_t start = 0;
+        for (int p = 0; p < 3; p++)
+        {
+            size_t slash = token.find('/', start);
+            parts[p] = token.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
+            if (slash == std::string::npos)
+                break;
+            start = slash + 1;
+        }
+
+        corner.position = resolveIndex(parts[0], positionCount);
+        corner.texCoord = resolveIndex(parts[1], texCoordCount);
+        corner.normal = resolveIndex(parts[2], normalCount);
+        return corner.position >= 0 && corner.texCoord != -2 && corner.normal != -2;
+    }
+
+    // Only the colour terms the renderer's material model has; maps are ignored
+    void loadMtl(const fs::path& path, std::vector<ImportedMaterial>& materials)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cout << "Failed to open material library: " << path.string() << std::endl;
+            return;
+        }
+
+        ImportedMaterial* current = nullptr;
+        bool hasAmbient = false;
+        auto finish = [&]() {
+            // Exporters often leave Ka black or out; the scene's materials
+            // use a fifth of the diffuse colour as ambient
+            if (current && !hasAmbient)
+                current->ambient = current->diffuse * 0.2f;
+        };
+
+        std::string text;
+        while (std::getline(file, text))
+        {
+            std::istringstream line(text);
+            std::string keyword;
+            line >> keyword;
+
+            if (keyword == "newmtl")
+            {
+                finish();
+                std::string name;
+                std::getline(line >> std::ws, name);
+                if (!name.empty() && name.back() == '\r')
+                    name.pop_back();
+                materials.push_back(ModelImport::defaultMaterial(name));
+                materials.back().specular = glm::vec3(0.0f);    // MTL's default Ks
+                current = &materials.back();
+                hasAmbient = false;
+            }
+            else if (!current)
+            {
+                continue;
+            }
+            else if (keyword == "Ka")
+            {
+                current->ambient = readVec3(line);
+                hasAmbient = current->ambient != glm::vec3(0.0f);
+            }
+            else if (keyword == "Kd")
+            {
+                current->diffuse = readVec3(line);
+            }
+            else if (keyword == "Ks")
+            {
+                current->specular = readVec3(line);
+            }
+            else if (keyword == "Ns")
+            {
+                line >> current->shininess;
+                if (current->shininess < 1.0f)
+                    current->shininess = 1.0f;
+            }
+            else if (keyword == "d")
+            {
+                line >> current->alpha;
+            }
+            else if (keyword == "Tr")
+            {
+                float transparency = 0.0f;
+                line >> transparency;
+                current->alpha = 1.0f - transparency;
+            }
+        }
+        finish();
+    }
+}
+
+bool ModelImport::importObj(const std::string& path, ImportedModel& model)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cout << "Failed to open: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+
+    // Triangulated corners per submesh, turned into vertices once every
+    // face is known so missing normals can be smoothed over all of them
+    std::vector<std::vector<Corner>> submeshCorners;
+    int currentSubmesh = -1;
+
+    auto selectMaterial = [&](const std::string& name) {
+        int material = -1;
+        for (size_t m = 0; m < model.materials.size(); m++)
+            if (model.materials[m].name == name)
+                material = (int)m;
+        if (material < 0)
+        {
+            if (!name.empty())
+                std::cout << "Unknown material \"" << name << "\" in " << path << ", using a default" << std::endl;
+            material = (int)model.materials.size();
+            model.materials.push_back(defaultMaterial(name));
+        }
+
+        for (size_t s = 0; s < model.submeshes.size(); s++)
+        {
+            if (model.submeshes[s].material == material)
+            {
+                currentSubmesh = (int)s;
+                return;
+            }
+        }
+        currentSubmesh = (int)model.submeshes.size();
+        model.submeshes.push_back(ImportedSubmesh{ material, {} });
+        submeshCorners.emplace_back();
+    };
+
+    std::vector<Corner> polygon;
+    std::string text;
+    int lineNumber = 0;
+    while (std::getline(file, text))
+    {
+        lineNumber++;
+        std::istringstream line(text);
+        std::string keyword;
+        line >> keyword;
+
+        if (keyword == "v")
+        {
+            positions.push_back(readVec3(line));
+        }
+        else if (keyword == "vt")
+        {
+            glm::vec2 uv(0.0f);
+            line >> uv.x >> uv.y;
+            texCoords.push_back(uv);
+        }
+        else if (keyword == "vn")
+        {
+            normals.push_back(readVec3(line));
+        }
+        else if (keyword == "mtllib")
+        {
+            std::string name;
+            std::getline(line >> std::ws, name);
+            if (!name.empty() && name.back() == '\r')
+                name.pop_back();
+            loadMtl(fs::path(path).parent_path() / name, model.materials);
+        }
+        else if (keyword == "usemtl")
+        {
+            std::string name;
+            std::getline(line >> std::ws, name);
+            if (!name.empty() && name.back() == '\r')
+                name.pop_back();
+            selectMaterial(name);
+        }
+        else if (keyword == "f")
+        {
+            polygon.clear();
+            std::string token;
+            while (line >> token)
+            {
+                Corner corner;
+                if (!parseCorner(token, (int)positions.size(), (int)texCoords.size(), (int)normals.size(), corner))
+                {
+                    std::cout << path << ":" << lineNumber << ": bad face index \"" << token << "\"" << std::endl;
+                    return false;
+                }
+                polygon.push_back(corner);
+            }
+
+            if (currentSubmesh < 0)
+                selectMaterial("");
+            for (size_t i = 2; i < polygon.size(); i++)
+            {
+                std::vector<Corner>& corners = submeshCorners[currentSubmesh];
+                corners.push_back(polygon[0]);
+                corners.push_back(polygon[i - 1]);
+                corners.push_back(polygon[i]);
+            }
+        }
+    }
+
+    // Smooth normals per position for corners that came without one
+    std::vector<glm::vec3> smoothNormals;
+    for (const std::vector<Corner>& corners : submeshCorners)
+    {
+        for (size_t i = 0; i < corners.size(); i += 3)
+        {
+            if (corners[i].normal >= 0 && corners[i + 1].normal >= 0 && corners[i + 2].normal >= 0)
+                continue;
+            if (smoothNormals.empty())
+                smoothNormals.assign(positions.size(), glm::vec3(0.0f));
+            const glm::vec3& a = positions[corners[i].position];
+            glm::vec3 normal = glm::cross(positions[corners[i + 1].position] - a, positions[corners[i + 2].position] - a);
+            for (int corner = 0; corner < 3; corner++)
+                smoothNormals[corners[i + corner].position] += normal;
+        }
+    }
+
+    // One vertex per distinct corner, shared across submeshes
+    std::map<Corner, uint32_t> vertexIds;
+    for (size_t s = 0; s < model.submeshes.size(); s++)
+    {
+        std::vector<uint32_t>& indices = model.submeshes[s].indices;
+        indices.reserve(submeshCorners[s].size());
+        for (const Corner& corner : submeshCorners[s])
+        {
+            auto found = vertexIds.find(corner);
+            if (found != vertexIds.end())
+            {
+                indices.push_back(found->second);
+                continue;
+            }
+
+            glm::vec3 normal = corner.normal >= 0 ? normals[corner.normal] : smoothNormals[corner.position];
+            float length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            glm::vec2 uv = corner.texCoord >= 0 ? texCoords[corner.texCoord] : glm::vec2(0.0f);
+            const glm::vec3& position = positions[corner.position];
+
+            uint32_t id = (uint32_t)(model.vertices.size() / FLOATS_PER_VERTEX);
+            float vertex[FLOATS_PER_VERTEX] = {
+                position.x, position.y, position.z, normal.x, normal.y, normal.z, uv.x, uv.y
+            };
+            model.vertices.insert(model.vertices.end(), vertex, vertex + FLOATS_PER_VERTEX);
+            vertexIds.emplace(corner, id);
+            indices.push_back(id);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,244 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+
+// Gather a 4x4 RGBA block, clamping reads at the image edge
+static void fetchBlock(const unsigned char* rgba, int width, int height, int bx, int by, unsigned char block[64])
+{
+    for (int y = 0; y < 4; y++)
+    {
+        int sy = std::min(by * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            int sx = std::min(bx * 4 + x, width - 1);
+            const unsigned char* src = rgba + ((size_t)sy * width + sx) * 4;
+            unsigned char* dst = block + (y * 4 + x) * 4;
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = src[3];
+        }
+    }
+}
+
+static uint16_t packRGB565(const float c[3])
+{
+    int r = (int)std::lround(std::min(std::max(c[0], 0.0f), 255.0f) * 31.0f / 255.0f);
+    int g = (int)std::lround(std::min(std::max(c[1], 0.0f), 255.0f) * 63.0f / 255.0f);
+    int b = (int)std::lround(std::min(std::max(c[2], 0.0f), 255.0f) * 31.0f / 255.0f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16_t packed, float c[3])
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    c[0] = (float)((r << 3) | (r >> 2));
+    c[1] = (float)((g << 2) | (g >> 4));
+    c[2] = (float)((b << 3) | (b >> 2));
+}
+
+static void writeLE16(unsigned char* out, uint16_t value)
+{
+    out[0] = (unsigned char)(value & 0xFF);
+    out[1] = (unsigned char)(value >> 8);
+}
+
+// Encode the colour half of a block (8 bytes) using the principal axis of the
+// block's colours to pick the two endpoints.
+static void encodeColorBlock(const unsigned char block[64], unsigned char out[8])
+{
+    // Mean colour
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 3; c++)
+            mean[c] += block[i * 4 + c];
+    for (int c = 0; c < 3; c++)
+        mean[c] /= 16.0f;
+
+    // Covariance matrix (symmetric, upper triangle)
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        float r = block[i * 4 + 0] - mean[0];
+        float g = block[i * 4 + 1] - mean[1];
+        float b = block[i * 4 + 2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    // Power iteration for the dominant eigenvector
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iter = 0; iter < 8; iter++)
+    {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = std::sqrt(x * x + y * y + z * z);
+        if (len < 1e-6f)
+            break;
+        axis[0] = x / len;
+        axis[1] = y / len;
+        axis[2] = z / len;
+    }
+
+    // Extremes along the axis
+    float minT = 1e30f, maxT = -1e30f;
+    for (int i = 0; i < 16; i++)
+    {
+        float t = (block[i * 4 + 0] - mean[0]) * axis[0] +
+            (block[i * 4 + 1] - mean[1]) * axis[1] +
+            (block[i * 4 + 2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    // Inset slightly to reduce the error of the interpolated colours
+    float inset = (maxT - minT) / 16.0f;
+    minT += inset;
+    maxT -= inset;
+
+    float endA[3], endB[3];
+    for (int c = 0; c < 3; c++)
+    {
+        endA[c] = mean[c] + axis[c] * maxT;
+        endB[c] = mean[c] + axis[c] * minT;
+    }
+
+    uint16_t c0 = packRGB565(endA);
+    uint16_t c1 = packRGB565(endB);
+    if (c0 < c1)
+        std::swap(c0, c1);   // c0 > c1 selects the opaque four-colour mode
+
+    writeLE16(out + 0, c0);
+    writeLE16(out + 2, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1)
+    {
+        float palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            float bestDist = 1e30f;
+            for (int p = 0; p < 4; p++)
+            {
+                float dr = block[i * 4 + 0] - palette[p][0];
+                float dg = block[i * 4 + 1] - palette[p][1];
+                float db = block[i * 4 + 2] - palette[p][2];
+                float dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    best = p;
+                }
+            }
+            indices |= (uint32_t)best << (i * 2);
+        }
+    }
+
+    out[4] = (unsigned char)(indices & 0xFF);
+    out[5] = (unsigned char)((indices >> 8) & 0xFF);
+    out[6] = (unsigned char)((indices >> 16) & 0xFF);
+    out[7] = (unsigned char)(indices >> 24);
+}
+
+// Encode the alpha half of a BC3 block (8 bytes), eight-value interpolation mode
+static void encodeAlphaBlock(const unsigned char block[64], unsigned char out[8])
+{
+    unsigned char a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        a0 = std::max(a0, block[i * 4 + 3]);
+        a1 = std::min(a1, block[i * 4 + 3]);
+    }
+
+    out[0] = a0;
+    out[1] = a1;
+
+    uint64_t indices = 0;
+    if (a0 != a1)
+    {
+        float palette[8];
+        palette[0] = a0;
+        palette[1] = a1;
+        for (int p = 1; p <= 6; p++)
+            palette[p + 1] = ((7 - p) * a0 + p * a1) / 7.0f;
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            float bestDist = 1e30f;
+            for (int p = 0; p < 8; p++)
+            {
+                float dist = std::fabs(block[i * 4 + 3] - palette[p]);
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (i * 3);
+        }
+    }
+
+    for (int b = 0; b < 6; b++)
+        out[2 + b] = (unsigned char)((indices >> (b * 8)) & 0xFF);
+}
+
+uint32_t BlockCompression::bc1Size(int width, int height)
+{
+    return (uint32_t)(((width + 3) / 4) * ((height + 3) / 4) * 8);
+}
+
+uint32_t BlockCompression::bc3Size(int width, int height)
+{
+    return (uint32_t)(((width + 3) / 4) * ((height + 3) / 4) * 16);
+}
+
+std::vector<unsigned char> BlockCompression::encodeBC1(const unsigned char* rgba, int width, int height)
+{
+    std::vector<unsigned char> result(bc1Size(width, height));
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+
+    unsigned char block[64];
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            fetchBlock(rgba, width, height, bx, by, block);
+            encodeColorBlock(block, &result[((size_t)by * blocksX + bx) * 8]);
+        }
+    }
+    return result;
+}
+
+std::vector<unsigned char> BlockCompression::encodeBC3(const unsigned char* rgba, int width, int height)
+{
+    std::vector<unsigned char> result(bc3Size(width, height));
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+
+    unsigned char block[64];
+    for (int by = 0; by < blocksY; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            fetchBlock(rgba, width, height, bx, by, block);
+            unsigned char* out = &result[((size_t)by * blocksX + bx) * 16];
+            encodeAlphaBlock(block, out);
+            encodeColorBlock(block, out + 8);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,19 @@
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+#include <cstdint>
+#include <vector>
+
+// CPU encoders for the S3TC block formats (BC1 = DXT1, BC3 = DXT5).
+// Input is tightly packed RGBA8; images whose size is not a multiple of four
+// are edge-clamped into full 4x4 blocks.
+namespace BlockCompression {
+    // Compressed size in bytes of a width x height level
+    uint32_t bc1Size(int width, int height);
+    uint32_t bc3Size(int width, int height);
+
+    std::vector<unsigned char> encodeBC1(const unsigned char* rgba, int width, int height);
+    std::vector<unsigned char> encodeBC3(const unsigned char* rgba, int width, int height);
+}
+
+#endif
@@ -0,0 +1,331 @@
+// Offline texture cooker
+//
+// Converts PNG/JPG images into KTX 1.1 containers with the full mip chain
+// pre-filtered, optionally block-compressed (BC1/BC3), so the renderer can
+// memory-map them and upload each level without decoding or glGenerateMipmap.
+//
+// Usage:
+//   TextureCooker [--format auto|rgba8|bc1|bc3] [--size WxH] <image-or-directory>...
+//
+// Each input "dir/name.png" is written to "dir/name.png.ktx"
+// (KtxFormat::cookedPath), which is where Texture::LoadTexture and
+// AsyncTextureLoader look for a cooked version first. --size resamples to a
+// fixed size first, as texture array layers need (512x512 for the posters);
+// the original size is kept in the file's SourceSize key.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "../../KtxFormat.h"
+#include "BlockCompression.h"
+
+namespace fs = std::filesystem;
+
+enum class CookFormat {
+    AUTO,
+    RGBA8,
+    BC1,
+    BC3
+};
+
+struct MipLevel {
+    int width;
+    int height;
+    std::vector<unsigned char> rgba;
+};
+
+// ============================================================================
+// MIP CHAIN
+// ============================================================================
+
+// Bilinear resample of level 0 to a fixed size
+static MipLevel resample(const unsigned char* src, int srcW, int srcH, int dstW, int dstH)
+{
+    MipLevel dst;
+    dst.width = dstW;
+    dst.height = dstH;
+    dst.rgba.resize((size_t)dstW * dstH * 4);
+
+    for (int y = 0; y < dstH; y++)
+    {
+        float sy = ((y + 0.5f) * srcH / dstH) - 0.5f;
+        int y0 = std::max(0, std::min((int)sy, srcH - 1));
+        int y1 = std::min(y0 + 1, srcH - 1);
+        float fy = std::max(0.0f, sy - y0);
+
+        for (int x = 0; x < dstW; x++)
+        {
+            float sx = ((x + 0.5f) * srcW / dstW) - 0.5f;
+            int x0 = std::max(0, std::min((int)sx, srcW - 1));
+            int x1 = std::min(x0 + 1, srcW - 1);
+            float fx = std::max(0.0f, sx - x0);
+
+            for (int c = 0; c < 4; c++)
+            {
+                float top = src[((size_t)y0 * srcW + x0) * 4 + c] * (1.0f - fx) + src[((size_t)y0 * srcW + x1) * 4 + c] * fx;
+                float bottom = src[((size_t)y1 * srcW + x0) * 4 + c] * (1.0f - fx) + src[((size_t)y1 * srcW + x1) * 4 + c] * fx;
+                dst.rgba[((size_t)y * dstW + x) * 4 + c] = (unsigned char)(top * (1.0f - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+    return dst;
+}
+
+// 2x2 box filter; odd edges reuse the last row/column
+static MipLevel downsample(const MipLevel& src)
+{
+    MipLevel dst;
+    dst.width = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.rgba.resize((size_t)dst.width * dst.height * 4);
+
+    for (int y = 0; y < dst.height; y++)
+    {
+        int y0 = std::min(y * 2, src.height - 1);
+        int y1 = std::min(y * 2 + 1, src.height - 1);
+        for (int x = 0; x < dst.width; x++)
+        {
+            int x0 = std::min(x * 2, src.width - 1);
+            int x1 = std::min(x * 2 + 1, src.width - 1);
+            for (int c = 0; c < 4; c++)
+            {
+                int sum = src.rgba[((size_t)y0 * src.width + x0) * 4 + c] +
+                    src.rgba[((size_t)y0 * src.width + x1) * 4 + c] +
+                    src.rgba[((size_t)y1 * src.width + x0) * 4 + c] +
+                    src.rgba[((size_t)y1 * src.width + x1) * 4 + c];
+                dst.rgba[((size_t)y * dst.width + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+static std::vector<MipLevel> buildMipChain(const unsigned char* pixels, int width, int height)
+{
+    std::vector<MipLevel> levels;
+    levels.push_back({ width, height, std::vector<unsigned char>(pixels, pixels + (size_t)width * height * 4) });
+    while (levels.back().width > 1 || levels.back().height > 1)
+        levels.push_back(downsample(levels.back()));
+    return levels;
+}
+
+static bool hasTransparency(const MipLevel& level)
+{
+    for (size_t i = 3; i < level.rgba.size(); i += 4)
+        if (level.rgba[i] != 255)
+            return true;
+    return false;
+}
+
+// ============================================================================
+// KTX WRITER
+// ============================================================================
+
+static bool writeKtx(const fs::path& outPath, const std::vector<MipLevel>& levels, CookFormat format,
+    int sourceWidth, int sourceHeight)
+{
+    // One key/value entry: the source size, NUL-terminated key and value
+    std::string sourceSize = std::to_string(sourceWidth) + "x" + std::to_string(sourceHeight);
+    std::string keyValue = std::string(KtxFormat::SOURCE_SIZE_KEY) + '\0' + sourceSize + '\0';
+    uint32_t keyValueSize = (uint32_t)keyValue.size();
+
+    KtxFormat::Header header;
+    memcpy(header.identifier, KtxFormat::IDENTIFIER, sizeof(KtxFormat::IDENTIFIER));
+    header.endianness = KtxFormat::ENDIANNESS;
+    header.glTypeSize = 1;
+    header.pixelWidth = (uint32_t)levels[0].width;
+    header.pixelHeight = (uint32_t)levels[0].height;
+    header.pixelDepth = 0;
+    header.numberOfArrayElements = 0;
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = (uint32_t)levels.size();
+    header.bytesOfKeyValueData = (uint32_t)sizeof(keyValueSize) + KtxFormat::padToFour(keyValueSize);
+
+    switch (format)
+    {
+    case CookFormat::BC1:
+        header.glType = 0;
+        header.glFormat = 0;
+        header.glInternalFormat = KtxFormat::INTERNAL_BC1_RGB;
+        header.glBaseInternalFormat = KtxFormat::FORMAT_RGB;
+        break;
+    case CookFormat::BC3:
+        header.glType = 0;
+        header.glFormat = 0;
+        header.glInternalFormat = KtxFormat::INTERNAL_BC3_RGBA;
+        header.glBaseInternalFormat = KtxFormat::FORMAT_RGBA;
+        break;
+    default:
+        header.glType = KtxFormat::TYPE_UNSIGNED_BYTE;
+        header.glFormat = KtxFormat::FORMAT_RGBA;
+        header.glInternalFormat = KtxFormat::INTERNAL_RGBA8;
+        header.glBaseInternalFormat = KtxFormat::FORMAT_RGBA;
+        break;
+    }
+
+    FILE* file = fopen(outPath.string().c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "Failed to open for writing: " << outPath.string() << std::endl;
+        return false;
+    }
+
+    const unsigned char padding[3] = { 0, 0, 0 };
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(&keyValueSize, sizeof(keyValueSize), 1, file);
+    fwrite(keyValue.data(), 1, keyValue.size(), file);
+    fwrite(padding, 1, KtxFormat::padToFour(keyValueSize) - keyValueSize, file);
+
+    for (const MipLevel& level : levels)
+    {
+        std::vector<unsigned char> encoded;
+        const std::vector<unsigned char>* data = &level.rgba;
+        if (format == CookFormat::BC1)
+        {
+            encoded = BlockCompression::encodeBC1(level.rgba.data(), level.width, level.height);
+            data = &encoded;
+        }
+        else if (format == CookFormat::BC3)
+        {
+            encoded = BlockCompression::encodeBC3(level.rgba.data(), level.width, level.height);
+            data = &encoded;
+        }
+
+        uint32_t imageSize = (uint32_t)data->size();
+        fwrite(&imageSize, sizeof(imageSize), 1, file);
+        fwrite(data->data(), 1, data->size(), file);
+        fwrite(padding, 1, KtxFormat::padToFour(imageSize) - imageSize, file);
+    }
+
+    fclose(file);
+    return true;
+}
+
+// ============================================================================
+// DRIVER
+// ============================================================================
+
+static const char* formatName(CookFormat format)
+{
+    switch (format)
+    {
+    case CookFormat::BC1:   return "BC1";
+    case CookFormat::BC3:   return "BC3";
+    case CookFormat::RGBA8: return "RGBA8";
+    default:                return "auto";
+    }
+}
+
+static bool cookImage(const fs::path& inPath, CookFormat requested, int targetWidth, int targetHeight)
+{
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(inPath.string().c_str(), &width, &height, &channels, 4);
+    if (!pixels)
+    {
+        std::cout << "Failed to load image: " << inPath.string() << std::endl;
+        return false;
+    }
+
+    std::vector<MipLevel> levels;
+    if (targetWidth > 0 && (targetWidth != width || targetHeight != height))
+    {
+        MipLevel resized = resample(pixels, width, height, targetWidth, targetHeight);
+        levels = buildMipChain(resized.rgba.data(), resized.width, resized.height);
+    }
+    else
+    {
+        levels = buildMipChain(pixels, width, height);
+    }
+    stbi_image_free(pixels);
+
+    CookFormat format = requested;
+    if (format == CookFormat::AUTO)
+        format = hasTransparency(levels[0]) ? CookFormat::BC3 : CookFormat::BC1;
+
+    fs::path outPath = KtxFormat::cookedPath(inPath.string());
+    if (!writeKtx(outPath, levels, format, width, height))
+        return false;
+
+    std::cout << inPath.string() << " -> " << outPath.string() << " ("
+        << levels[0].width << "x" << levels[0].height << ", " << levels.size() << " mips, "
+        << formatName(format) << ", " << fs::file_size(outPath) << " bytes)" << std::endl;
+    return true;
+}
+
+static bool isSourceImage(const fs::path& path)
+{
+    std::string ext = path.extension().string();
+    for (char& c : ext)
+        c = (char)tolower((unsigned char)c);
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg";
+}
+
+int main(int argc, char** argv)
+{
+    CookFormat format = CookFormat::AUTO;
+    int targetWidth = 0;
+    int targetHeight = 0;
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+        {
+            std::string value = argv[++i];
+            if (value == "rgba8")     format = CookFormat::RGBA8;
+            else if (value == "bc1")  format = CookFormat::BC1;
+            else if (value == "bc3")  format = CookFormat::BC3;
+            else if (value == "auto") format = CookFormat::AUTO;
+            else
+            {
+                std::cout << "Unknown format: " << value << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--size" && i + 1 < argc)
+        {
+            if (sscanf(argv[++i], "%dx%d", &targetWidth, &targetHeight) != 2 || targetWidth <= 0 || targetHeight <= 0)
+            {
+                std::cout << "Invalid size (expected WxH): " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        std::cout << "Usage: TextureCooker [--format auto|rgba8|bc1|bc3] [--size WxH] <image-or-directory>..." << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const fs::path& input : inputs)
+    {
+        if (fs::is_directory(input))
+        {
+            for (const fs::directory_entry& entry : fs::directory_iterator(input))
+                if (entry.is_regular_file() && isSourceImage(entry.path()))
+                    failures += cookImage(entry.path(), format, targetWidth, targetHeight) ? 0 : 1;
+        }
+        else
+        {
+            failures += cookImage(input, format, targetWidth, targetHeight) ? 0 : 1;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "VertexFormat.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    glm::vec3 decodeOctahedral(int8_t x, int8_t y)
+    {
+        glm::vec3 v(glm::unpackSnorm1x8((uint8_t)x), glm::unpackSnorm1x8((uint8_t)y), 0.0f);
+        v.z = 1.0f - std::fabs(v.x) - std::fabs(v.y);
+        if (v.z < 0.0f)
+        {
+            float sx = v.x >= 0.0f ? 1.0f : -1.0f;
+            float sy = v.y >= 0.0f ? 1.0f : -1.0f;
+            float x0 = v.x;
+            v.x = (1.0f - std::fabs(v.y)) * sx;
+            v.y = (1.0f - std::fabs(x0)) * sy;
+        }
+        return glm::normalize(v);
+    }
+
+    // Projects the normal onto the octahedron and unfolds the lower half.
+    // Of the four roundings to 8 bits, keeps the one that decodes closest.
+    void encodeOctahedral(glm::vec3 n, int8_t out[2])
+    {
+        float length = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+        if (length == 0.0f)
+        {
+            out[0] = 0;
+            out[1] = 0;
+            return;
+        }
+        n /= length;
+        glm::vec2 p(n.x, n.y);
+        if (n.z < 0.0f)
+        {
+            p.x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+            p.y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+        }
+
+        glm::vec3 unit = glm::normalize(n);
+        float bestDot = -2.0f;
+        for (int corner = 0; corner < 4; corner++)
+        {
+            float x = (corner & 1 ? std::ceil(p.x * 127.0f) : std::floor(p.x * 127.0f)) / 127.0f;
+            float y = (corner & 2 ? std::ceil(p.y * 127.0f) : std::floor(p.y * 127.0f)) / 127.0f;
+            int8_t cx = (int8_t)glm::packSnorm1x8(x);
+            int8_t cy = (int8_t)glm::packSnorm1x8(y);
+            float d = glm::dot(decodeOctahedral(cx, cy), unit);
+            if (d > bestDot)
+            {
+                bestDot = d;
+                out[0] = cx;
+                out[1] = cy;
+            }
+        }
+    }
+
+}
+
+float VertexFormat::positionScale(float maxAbsCoordinate)
+{
+#if PACKED_VERTICES
+    float scale = 1.0f;
+    while (scale < maxAbsCoordinate)
+        scale *= 2.0f;
+    return scale;
+#else
+    return 1.0f;
+#endif
+}
+
+void VertexFormat::encode(const float* source, float positionScale, unsigned char* out)
+{
+#if PACKED_VERTICES
+    PackedVertex packed;
+    for (int i = 0; i < 3; i++)
+        packed.position[i] = (int16_t)glm::packSnorm1x16(source[i] / positionScale);
+    encodeOctahedral(glm::vec3(source[3], source[4], source[5]), packed.normal);
+    packed.texCoords[0] = glm::packHalf1x16(source[6]);
+    packed.texCoords[1] = glm::packHalf1x16(source[7]);
+    memcpy(out, &packed, sizeof(packed));
+#else
+    memcpy(out, source, 8 * sizeof(float));
+#endif
+}
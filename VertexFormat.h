@@ -0,0 +1,68 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <cstdint>
+
+// Vertex layout of the MeshArena. With PACKED_VERTICES the float vertices of
+// Mesh (32 bytes) are quantised once at MeshArena::build() into 12 bytes:
+// snorm16 position over a per-mesh scale, half-float UVs, and the normal
+// octahedral-encoded into two snorm bytes. Set it to 0 to get the float
+// layout back; the C++ side and the shaders (DECODE_NORMAL_GLSL) both follow
+// this one define, and so do cooked models, which store vertices ready for
+// upload.
+//
+// Positions are fixed point so large meshes (the merged desk and bench
+// prototypes) keep the same absolute precision everywhere; half floats lose
+// a bit per doubling of distance from the origin. The scale is uniform, so
+// folding it into the model matrix leaves normals alone.
+#define PACKED_VERTICES 1
+
+struct PackedVertex {
+    int16_t position[3];     // GL_SHORT normalized, times the mesh's position scale
+    int8_t normal[2];        // Octahedral, GL_BYTE normalized
+    uint16_t texCoords[2];   // GL_HALF_FLOAT
+};
+
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex must stay tightly packed");
+
+namespace VertexFormat {
+#if PACKED_VERTICES
+    const int VERTEX_SIZE = sizeof(PackedVertex);
+#else
+    const int VERTEX_SIZE = 8 * sizeof(float);
+#endif
+
+    // Scale a mesh's positions are stored against: the smallest power of two
+    // covering its largest coordinate, never below 1 so unit-sized meshes
+    // need no scale at all. Always 1 for the float layout.
+    float positionScale(float maxAbsCoordinate);
+
+    // One Mesh vertex (8 floats: position, normal, UV) to VERTEX_SIZE bytes
+    // of the active layout, positions divided by positionScale. Shared with
+    // Tools/ModelCooker, so no GL here.
+    void encode(const float* source, float positionScale, unsigned char* out);
+}
+
+#define VERTEX_FORMAT_STRINGIFY(x) #x
+#define VERTEX_FORMAT_VALUE(x) VERTEX_FORMAT_STRINGIFY(x)
+
+// GLSL for vertex shaders reading aNormal from the arena: a packed normal
+// arrives as (octX, octY, 0) and is unfolded back to a unit vector here
+#define DECODE_NORMAL_GLSL \
+"#define PACKED_VERTICES " VERTEX_FORMAT_VALUE(PACKED_VERTICES) "\n" \
+"vec3 decodeNormal(vec3 n)\n" \
+"{\n" \
+"#if PACKED_VERTICES\n" \
+"    vec3 v = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));\n" \
+"    if (v.z < 0.0)\n" \
+"    {\n" \
+"        vec2 s = vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);\n" \
+"        v.xy = (1.0 - abs(v.yx)) * s;\n" \
+"    }\n" \
+"    return normalize(v);\n" \
+"#else\n" \
+"    return n;\n" \
+"#endif\n" \
+"}\n"
+
+#endif
@@ -1,7 +1,9 @@
 #include "camera.h"
+#include "CollisionWorld.h"
 
 Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
-    : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(5.0f), MouseSensitivity(0.1f), Zoom(45.0f)
+    : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(5.0f), MouseSensitivity(0.1f), Zoom(45.0f),
+      collisionWorld(nullptr)
 {
     Position = position;
     WorldUp = up;
@@ -18,14 +20,25 @@ glm::mat4 Camera::GetViewMatrix()
 void Camera::ProcessKeyboard(int direction, float deltaTime)
 {
     float velocity = MovementSpeed * deltaTime;
+    glm::vec3 motion(0.0f);
     if (direction == FORWARD)
-        Position += Front * velocity;
+        motion = Front * velocity;
     if (direction == BACKWARD)
-        Position -= Front * velocity;
+        motion = -Front * velocity;
     if (direction == LEFT)
-        Position -= Right * velocity;
+        motion = -Right * velocity;
     if (direction == RIGHT)
-        Position += Right * velocity;
+        motion = Right * velocity;
+
+    if (collisionWorld)
+        Position = collisionWorld->moveCapsule(Position, motion);
+    else
+        Position += motion;
+}
+
+void Camera::SetCollisionWorld(CollisionWorld* world)
+{
+    collisionWorld = world;
 }
 
 void Camera::ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch)
@@ -4,6 +4,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+class CollisionWorld;
+
 class Camera
 {
 public:
@@ -35,6 +37,9 @@ public:
     // Processes keyboard input
     void ProcessKeyboard(int direction, float deltaTime);
 
+    // Movement is swept against this world when set (nullptr: fly freely)
+    void SetCollisionWorld(CollisionWorld* world);
+
     // Processes mouse movement
     void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true);
 
@@ -42,6 +47,8 @@ public:
     void ProcessMouseScroll(float yoffset);
 
 private:
+    CollisionWorld* collisionWorld;
+
     void updateCameraVectors();
 };
 
@@ -0,0 +1,180 @@
+#ifndef CONFIG_CULLING_H
+#define CONFIG_CULLING_H
+
+// Shaders for visibility culling: GpuCuller's compute passes (GL 4.3 only)
+// and OcclusionQueries' bounding boxes (GL 3.3)
+
+// Frustum + Hi-Z test per opaque instance; survivors are compacted into
+// their command's slice of the visible-instance buffer.
+static const char* cullComputeShaderSource =
+"#version 430 core\n"
+"layout (local_size_x = 64) in;\n"
+"\n"
+"struct Instance {\n"                 // RenderQueue InstanceData (80 bytes)
+"    mat4 model;\n"
+"    uint materialId;\n"
+"    uint commandIndex;\n"
+"    uint pad0;\n"
+"    uint pad1;\n"
+"};\n"
+"\n"
+"struct Command {\n"                  // DrawElementsIndirectCommand
+"    uint count;\n"
+"    uint instanceCount;\n"
+"    uint firstIndex;\n"
+"    int baseVertex;\n"
+"    uint baseInstance;\n"
+"};\n"
+"\n"
+"struct Bounds {\n"
+"    vec4 minCorner;\n"
+"    vec4 maxCorner;\n"
+"};\n"
+"\n"
+"layout (std430, binding = 0) readonly buffer SourceInstances { Instance sourceInstances[]; };\n"
+"layout (std430, binding = 1) writeonly buffer VisibleInstances { Instance visibleInstances[]; };\n"
+"layout (std430, binding = 2) buffer Commands { Command commands[]; };\n"
+"layout (std430, binding = 3) readonly buffer CommandBounds { Bounds bounds[]; };\n"
+"\n"
+"layout (binding = 0) uniform sampler2D hiZ;\n"
+"\n"
+"uniform uint instanceCount;\n"
+"uniform vec4 frustumPlanes[6];\n"
+"uniform bool useHiZ;\n"
+"uniform mat4 hiZViewProjection;\n"   // camera of the frame the pyramid came from
+"uniform vec2 hiZSize;\n"
+"uniform int hiZLevels;\n"
+"\n"
+"bool isOccluded(vec3 boxMin, vec3 boxMax)\n"
+"{\n"
+"    vec2 uvMin = vec2(1.0);\n"
+"    vec2 uvMax = vec2(0.0);\n"
+"    float nearestDepth = 1.0;\n"
+"    for (int i = 0; i < 8; i++)\n"
+"    {\n"
+"        vec3 corner = mix(boxMin, boxMax, vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1));\n"
+"        vec4 clip = hiZViewProjection * vec4(corner, 1.0);\n"
+"        if (clip.w <= 0.0)\n"
+"            return false;\n"         // crosses the camera plane
+"        vec3 ndc = clip.xyz / clip.w;\n"
+"        uvMin = min(uvMin, ndc.xy * 0.5 + 0.5);\n"
+"        uvMax = max(uvMax, ndc.xy * 0.5 + 0.5);\n"
+"        nearestDepth = min(nearestDepth, ndc.z * 0.5 + 0.5);\n"
+"    }\n"
+"\n"
+"    // Integer texel rectangle; level N texel i covers level 0 texels [i << N, (i + 1) << N)\n"
+"    // (clamp in float first: corners near the camera plane project far off screen)\n"
+"    ivec2 baseSize = ivec2(hiZSize);\n"
+"    ivec2 minTexel = min(ivec2(clamp(uvMin, 0.0, 1.0) * hiZSize), baseSize - 1);\n"
+"    ivec2 maxTexel = min(ivec2(clamp(uvMax, 0.0, 1.0) * hiZSize), baseSize - 1);\n"
+"\n"
+"    // Coarsest-needed level where the rectangle spans at most 2x2 texels\n"
+"    ivec2 span = maxTexel - minTexel;\n"
+"    int level = int(ceil(log2(float(max(max(span.x, span.y), 1)))));\n"
+"    while (level < hiZLevels - 1 && any(greaterThan((maxTexel >> level) - (minTexel >> level), ivec2(1))))\n"
+"        level++;\n"
+"    level = min(level, hiZLevels - 1);\n"
+"\n"
+"    ivec2 levelMax = max(baseSize >> level, ivec2(1)) - 1;\n"
+"    ivec2 a = min(minTexel >> level, levelMax);\n"
+"    ivec2 b = min(maxTexel >> level, levelMax);\n"
+"    float farthest = max(\n"
+"        max(texelFetch(hiZ, a, level).r, texelFetch(hiZ, ivec2(b.x, a.y), level).r),\n"
+"        max(texelFetch(hiZ, ivec2(a.x, b.y), level).r, texelFetch(hiZ, b, level).r));\n"
+"    return nearestDepth > farthest;\n"
+"}\n"
+"\n"
+"void main()\n"
+"{\n"
+"    uint index = gl_GlobalInvocationID.x;\n"
+"    if (index >= instanceCount)\n"
+"        return;\n"
+"\n"
+"    Instance instance = sourceInstances[index];\n"
+"    Bounds local = bounds[instance.commandIndex];\n"
+"\n"
+"    // World-space box (Arvo)\n"
+"    vec3 center = (local.minCorner.xyz + local.maxCorner.xyz) * 0.5;\n"
+"    vec3 extent = (local.maxCorner.xyz - local.minCorner.xyz) * 0.5;\n"
+"    vec3 worldCenter = (instance.model * vec4(center, 1.0)).xyz;\n"
+"    vec3 worldExtent = abs(instance.model[0].xyz) * extent.x +\n"
+"                       abs(instance.model[1].xyz) * extent.y +\n"
+"                       abs(instance.model[2].xyz) * extent.z;\n"
+"\n"
+"    for (int i = 0; i < 6; i++)\n"
+"    {\n"
+"        vec4 plane = frustumPlanes[i];\n"
+"        if (dot(plane.xyz, worldCenter) + plane.w < -dot(abs(plane.xyz), worldExtent))\n"
+"            return;\n"
+"    }\n"
+"\n"
+"    if (useHiZ && isOccluded(worldCenter - worldExtent, worldCenter + worldExtent))\n"
+"        return;\n"
+"\n"
+"    uint slot = atomicAdd(commands[instance.commandIndex].instanceCount, 1u);\n"
+"    visibleInstances[commands[instance.commandIndex].baseInstance + slot] = instance;\n"
+"}\n\0";
+
+// Hi-Z level 0: copy of the depth buffer
+static const char* hiZCopyComputeShaderSource =
+"#version 430 core\n"
+"layout (local_size_x = 8, local_size_y = 8) in;\n"
+"\n"
+"layout (binding = 0) uniform sampler2D depthTexture;\n"
+"layout (r32f, binding = 0) writeonly uniform image2D destination;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);\n"
+"    if (any(greaterThanEqual(texel, imageSize(destination))))\n"
+"        return;\n"
+"    imageStore(destination, texel, vec4(texelFetch(depthTexture, texel, 0).r));\n"
+"}\n\0";
+
+// Hi-Z level N: farthest depth of the 2x2 (3 wide on odd edges) footprint in level N-1
+static const char* hiZReduceComputeShaderSource =
+"#version 430 core\n"
+"layout (local_size_x = 8, local_size_y = 8) in;\n"
+"\n"
+"layout (r32f, binding = 0) readonly uniform image2D source;\n"
+"layout (r32f, binding = 1) writeonly uniform image2D destination;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);\n"
+"    ivec2 destinationSize = imageSize(destination);\n"
+"    if (any(greaterThanEqual(texel, destinationSize)))\n"
+"        return;\n"
+"\n"
+"    ivec2 sourceSize = imageSize(source);\n"
+"    ivec2 footprint = ivec2(2) + ivec2(equal(texel, destinationSize - 1)) * (sourceSize & 1);\n"
+"\n"
+"    float farthest = 0.0;\n"
+"    for (int y = 0; y < footprint.y; y++)\n"
+"        for (int x = 0; x < footprint.x; x++)\n"
+"            farthest = max(farthest, imageLoad(source, min(texel * 2 + ivec2(x, y), sourceSize - 1)).r);\n"
+"    imageStore(destination, texel, vec4(farthest));\n"
+"}\n\0";
+
+// Occlusion query proxy: unit cube stretched over a world-space box
+static const char* occlusionBoxVertexShaderSource =
+"#version 330 core\n"
+"layout (location = 0) in vec3 aPos;\n"   // corner of [0, 1]^3
+"\n"
+"uniform mat4 viewProjection;\n"
+"uniform vec3 boxMin;\n"
+"uniform vec3 boxMax;\n"
+"\n"
+"void main()\n"
+"{\n"
+"    gl_Position = viewProjection * vec4(mix(boxMin, boxMax, aPos), 1.0);\n"
+"}\n\0";
+
+// Color writes are masked off while querying; only the depth test matters
+static const char* occlusionBoxFragmentShaderSource =
+"#version 330 core\n"
+"void main()\n"
+"{\n"
+"}\n\0";
+
+#endif
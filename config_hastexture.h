@@ -1,30 +1,33 @@
 #ifndef CONFIG_TEXTURE_H
 #define CONFIG_TEXTURE_H
 
+#include "VertexFormat.h"
+
+// Instanced poster vertex shader: per-instance model matrix and texture-array layer
 static const char* vertexShaderSource_withTexture =
 "#version 330 core\n"
 "layout (location = 0) in vec3 aPos;\n"
 "layout (location = 1) in vec3 aNormal;\n"
 "layout (location = 2) in vec2 aTexCoords;\n"
+"layout (location = 3) in mat4 aModel;\n"   // locations 3-6
+"layout (location = 7) in float aLayer;\n"
 "\n"
 "out vec3 FragPos;\n"
 "out vec3 Normal;\n"
 "out vec2 TexCoords;\n"
+"flat out float Layer;\n"
 "\n"
-"uniform mat4 model;\n"
 "uniform mat4 view;\n"
 "uniform mat4 projection;\n"
-"uniform float texRotation;\n"
+"\n"
+DECODE_NORMAL_GLSL
 "\n"
 "void main()\n"
 "{\n"
-"    FragPos = vec3(model * vec4(aPos, 1.0));\n"
-"    Normal = mat3(transpose(inverse(model))) * aNormal;\n"
-"	 vec2 center = aTexCoords - vec2(0.5);\n"
-"	 float cosA = cos(texRotation);\n"
-"	 float sinA = sin(texRotation);\n"
-"	 mat2 rotMat = mat2(cosA, -sinA, sinA, cosA);\n"
-"    TexCoords =  rotMat * aTexCoords ;\n"
+"    FragPos = vec3(aModel * vec4(aPos, 1.0));\n"
+"    Normal = mat3(transpose(inverse(aModel))) * decodeNormal(aNormal);\n"
+"    TexCoords = aTexCoords;\n"
+"    Layer = aLayer;\n"
 "    gl_Position = projection * view * vec4(FragPos, 1.0);\n"
 "}\n\0";
 
@@ -39,13 +42,14 @@ static const char* lightCubeFragmentShaderSource_withTexture =
 "}\n\0";
 
 
+// Lit fragment shader sampling a GL_TEXTURE_2D_ARRAY layer (posters)
 static const char* lightingFragmentShaderSource_withTexture =
 "#version 330 core\n"
 "out vec4 FragColor;\n"
 "\n"
 "struct Material {\n"
-"    sampler2D diffuse;\n"
-"    sampler2D specular;\n"
+"    sampler2DArray diffuse;\n"
+"    vec3 specular;\n"
 "    float shininess;\n"
 "};\n"
 "\n"
@@ -84,11 +88,15 @@ static const char* lightingFragmentShaderSource_withTexture =
 "in vec3 FragPos;\n"
 "in vec3 Normal;\n"
 "in vec2 TexCoords;\n"
+"flat in float Layer;\n"
 "\n"
 "uniform vec3 viewPos;\n"
-"uniform DirLight dirLight;\n"
-"uniform PointLight pointLights[NR_POINT_LIGHTS];\n"
-"uniform SpotLight spotLight;\n"
+"\n"
+"layout (std140) uniform Lighting {\n"  // LightingBuffer
+"    DirLight dirLight;\n"
+"    PointLight pointLights[NR_POINT_LIGHTS];\n"
+"    SpotLight spotLight;\n"
+"};\n"
 "uniform Material material;\n"
 "\n"
 "vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);\n"
@@ -115,10 +123,10 @@ static const char* lightingFragmentShaderSource_withTexture =
 "    float diff = max(dot(normal, lightDir), 0.0);\n"
 "    vec3 reflectDir = reflect(-lightDir, normal);\n"
 "    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);\n"
-"    vec3 texColor = vec3(texture(material.diffuse, TexCoords));\n"
+"    vec3 texColor = vec3(texture(material.diffuse, vec3(TexCoords, Layer)));\n"
 "    vec3 ambient = light.ambient * texColor;\n"
 "    vec3 diffuse = light.diffuse * diff * texColor;\n"
-"    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));\n"
+"    vec3 specular = light.specular * spec * material.specular;\n"
 "    return (ambient + diffuse + specular);\n"
 "}\n"
 "\n"
@@ -130,10 +138,10 @@ static const char* lightingFragmentShaderSource_withTexture =
 "    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);\n"
 "    float distance = length(light.position - fragPos);\n"
 "    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));\n"
-"    vec3 texColor = vec3(texture(material.diffuse, TexCoords));\n"
+"    vec3 texColor = vec3(texture(material.diffuse, vec3(TexCoords, Layer)));\n"
 "    vec3 ambient = light.ambient * texColor;\n"
 "    vec3 diffuse = light.diffuse * diff * texColor;\n"
-"    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));\n"
+"    vec3 specular = light.specular * spec * material.specular;\n"
 "    ambient *= attenuation;\n"
 "    diffuse *= attenuation;\n"
 "    specular *= attenuation;\n"
@@ -154,10 +162,10 @@ static const char* lightingFragmentShaderSource_withTexture =
 "    float epsilon = light.cutOff - light.outerCutOff;\n"
 "    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);\n"
 "\n"
-"    vec3 texColor = vec3(texture(material.diffuse, TexCoords));\n"
+"    vec3 texColor = vec3(texture(material.diffuse, vec3(TexCoords, Layer)));\n"
 "    vec3 ambient = light.ambient * texColor;\n"
 "    vec3 diffuse = light.diffuse * diff * texColor;\n"
-"    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));\n"
+"    vec3 specular = light.specular * spec * material.specular;\n"
 "\n"
 "    ambient *= attenuation * intensity;\n"
 "    diffuse *= attenuation * intensity;\n"
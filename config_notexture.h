@@ -1,26 +1,61 @@
 #ifndef CONFIG_NOTEXTURE_H
 #define CONFIG_NOTEXTURE_H
 
+#include "VertexFormat.h"
+
 // Vertex Shader source code (used by both cubes)
 static const char* vertexShaderSource =
 "#version 330 core\n"
 "layout (location = 0) in vec3 aPos;\n"
 "layout (location = 1) in vec3 aNormal;\n"
 "layout (location = 2) in vec2 aTexCoords;\n"
+"layout (location = 3) in uint aMaterialId;\n"  // MaterialRegistry table index
 "\n"
 "out vec3 FragPos;\n"
 "out vec3 Normal;\n"
 "out vec2 TexCoords;\n"
+"flat out uint MaterialId;\n"
 "\n"
 "uniform mat4 model;\n"
 "uniform mat4 view;\n"
 "uniform mat4 projection;\n"
 "\n"
+DECODE_NORMAL_GLSL
+"\n"
 "void main()\n"
 "{\n"
 "    FragPos = vec3(model * vec4(aPos, 1.0));\n"
-"    Normal = mat3(transpose(inverse(model))) * aNormal;\n"
+"    Normal = mat3(transpose(inverse(model))) * decodeNormal(aNormal);\n"
+"    TexCoords = aTexCoords;\n"
+"    MaterialId = aMaterialId;\n"
+"    gl_Position = projection * view * vec4(FragPos, 1.0);\n"
+"}\n\0";
+
+// Vertex Shader for RenderQueue batches: model matrix and material ID per instance
+static const char* vertexShaderSource_instanced =
+"#version 330 core\n"
+"layout (location = 0) in vec3 aPos;\n"
+"layout (location = 1) in vec3 aNormal;\n"
+"layout (location = 2) in vec2 aTexCoords;\n"
+"layout (location = 3) in uint aMaterialId;\n"
+"layout (location = 4) in mat4 aModel;\n"   // locations 4-7
+"\n"
+"out vec3 FragPos;\n"
+"out vec3 Normal;\n"
+"out vec2 TexCoords;\n"
+"flat out uint MaterialId;\n"
+"\n"
+"uniform mat4 view;\n"
+"uniform mat4 projection;\n"
+"\n"
+DECODE_NORMAL_GLSL
+"\n"
+"void main()\n"
+"{\n"
+"    FragPos = vec3(aModel * vec4(aPos, 1.0));\n"
+"    Normal = mat3(transpose(inverse(aModel))) * decodeNormal(aNormal);\n"
 "    TexCoords = aTexCoords;\n"
+"    MaterialId = aMaterialId;\n"
 "    gl_Position = projection * view * vec4(FragPos, 1.0);\n"
 "}\n\0";
 
@@ -79,15 +114,32 @@ static const char* lightingFragmentShaderSource =
 "\n"
 "#define NR_POINT_LIGHTS 4\n"
 "\n"
+"#define MAX_MATERIALS 256\n"  // MaterialRegistry::MAX_MATERIALS
+"\n"
+"struct GpuMaterial {\n"
+"    vec4 ambient;\n"
+"    vec4 diffuseAlpha;\n"
+"    vec4 specularShininess;\n"
+"};\n"
+"\n"
+"layout (std140) uniform Materials {\n"
+"    GpuMaterial materials[MAX_MATERIALS];\n"
+"};\n"
+"\n"
 "in vec3 FragPos;\n"
 "in vec3 Normal;\n"
 "in vec2 TexCoords;\n"
+"flat in uint MaterialId;\n"
 "\n"
 "uniform vec3 viewPos;\n"
-"uniform DirLight dirLight;\n"
-"uniform PointLight pointLights[NR_POINT_LIGHTS];\n"
-"uniform SpotLight spotLight;\n"
-"uniform Material material;\n"
+"\n"
+"layout (std140) uniform Lighting {\n"  // LightingBuffer
+"    DirLight dirLight;\n"
+"    PointLight pointLights[NR_POINT_LIGHTS];\n"
+"    SpotLight spotLight;\n"
+"};\n"
+"\n"
+"Material material;\n"  // Filled from the material table in main()
 "\n"
 "vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);\n"
 "vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);\n"
@@ -95,6 +147,13 @@ static const char* lightingFragmentShaderSource =
 "\n"
 "void main()\n"
 "{\n"
+"    GpuMaterial entry = materials[MaterialId];\n"
+"    material.ambient = entry.ambient.rgb;\n"
+"    material.diffuse = entry.diffuseAlpha.rgb;\n"
+"    material.alpha = entry.diffuseAlpha.a;\n"
+"    material.specular = entry.specularShininess.rgb;\n"
+"    material.shininess = entry.specularShininess.a;\n"
+"\n"
 "    vec3 norm = normalize(Normal);\n"
 "    vec3 viewDir = normalize(viewPos - FragPos);\n"
 "\n"
@@ -4,13 +4,34 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
+#include <vector>
 
 // Project headers
 #include "mesh.h"
 #include "shader.h"
 #include "camera.h"
 #include "texture.h"
+#include "AsyncTextureLoader.h"
+#include "GLCaps.h"
+#include "MaterialRegistry.h"
+#include "MeshArena.h"
+#include "MeshRegistry.h"
+#include "RenderQueue.h"
+#include "LightingBuffer.h"
+#include "StreamBuffer.h"
+#include "GpuCuller.h"
+#include "OcclusionQueries.h"
+#include "PortalGraph.h"
+#include "BVH.h"
+#include "CollisionWorld.h"
+#include "SceneObjects.h"
+#include "SceneGraph.h"
+#include "EntityWorld.h"
+#include "TextureArray.h"
+#include "PosterBatch.h"
+#include "CookedModel.h"
 #include "config_notexture.h"
+#include "config_hastexture.h"
 #include "ObjectAnimator.h"
 
 // New modular headers
@@ -33,6 +54,8 @@ bool lightsOn = false;
 bool projectorOn = false;
 bool fanOn = false;
 bool doorOpen = false;
+bool pickRequested = false;    // Left click, handled once the frame's bounds are up to date
+bool uploadReport = false;     // Print the bytes sent to the GPU every frame
 
 ObjectAnimator* sunAnimator = nullptr;
 
@@ -42,8 +65,9 @@ ObjectAnimator* sunAnimator = nullptr;
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 void processInput(GLFWwindow* window);
-void setupLighting(Shader& lightingShader, const glm::vec3 ceilingLightPositions[4], glm::vec3 sunPosition);
+void setupLighting(LightingBuffer& lighting, const glm::vec3 ceilingLightPositions[4], glm::vec3 sunPosition);
 
 // ============================================================================
 // MAIN FUNCTION
@@ -75,9 +99,14 @@ int main()
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
     gladLoadGL();
+    GLCaps::init((GLADloadproc)glfwGetProcAddress);
+    MaterialRegistry::init();
+    ClassroomObjects::registerPrototypes();
+    MeshRegistry::init();
     glViewport(0, 0, WindowConfig::SCR_WIDTH, WindowConfig::SCR_HEIGHT);
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
@@ -86,80 +115,89 @@ int main()
     // Create shaders
     Shader lightingShader(vertexShaderSource, lightingFragmentShaderSource);
     Shader lightCubeShader(vertexShaderSource, lightCubeFragmentShaderSource);
-
-    // Setup VAOs and VBOs
-    GLuint cubeVAO, cubeVBO;
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
-    const auto& cubeVerts = Mesh::GetVertices(Mesh::CUBE);
-    glBindVertexArray(cubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, cubeVerts.size() * sizeof(float), cubeVerts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    GLuint planeVAO, planeVBO;
-    glGenVertexArrays(1, &planeVAO);
-    glGenBuffers(1, &planeVBO);
-    const auto& planeVerts = Mesh::GetVertices(Mesh::PLANE);
-    glBindVertexArray(planeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, planeVBO);
-    glBufferData(GL_ARRAY_BUFFER, planeVerts.size() * sizeof(float), planeVerts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    GLuint sphereVAO, sphereVBO;
-    glGenVertexArrays(1, &sphereVAO);
-    glGenBuffers(1, &sphereVBO);
-    const auto& sphereVerts = Mesh::GetVertices(Mesh::SPHERE);
-    glBindVertexArray(sphereVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, sphereVBO);
-    glBufferData(GL_ARRAY_BUFFER, sphereVerts.size() * sizeof(float), sphereVerts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    GLuint windowVAO, windowVBO;
-    glGenVertexArrays(1, &windowVAO);
-    glGenBuffers(1, &windowVBO);
-    const auto& windowVerts = Mesh::GetVertices(Mesh::WINDOW);
-    glBindVertexArray(windowVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, windowVBO);
-    glBufferData(GL_ARRAY_BUFFER, windowVerts.size() * sizeof(float), windowVerts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    GLuint cylinderVAO, cylinderVBO;
-    glGenVertexArrays(1, &cylinderVAO);
-    glGenBuffers(1, &cylinderVBO);
-    const auto& cylinderVerts = Mesh::GetVertices(Mesh::CYLINDER);
-    glBindVertexArray(cylinderVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, cylinderVBO);
-    glBufferData(GL_ARRAY_BUFFER, cylinderVerts.size() * sizeof(float), cylinderVerts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    Shader posterShader(vertexShaderSource_withTexture, lightingFragmentShaderSource_withTexture);
+    Shader sceneShader(vertexShaderSource_instanced, lightingFragmentShaderSource);
+    MaterialRegistry::bindShader(lightingShader);
+    MaterialRegistry::bindShader(sceneShader);
+
+    // Per-frame uploads are staged in a ring of three frame-sized regions
+    StreamBuffer streamBuffer(256 * 1024);
+
+    // Lights shared by every lit shader; only changed sections are re-sent
+    LightingBuffer lightingBuffer;
+    LightingBuffer::bindShader(lightingShader);
+    LightingBuffer::bindShader(sceneShader);
+    LightingBuffer::bindShader(posterShader);
+    posterShader.use();
+    posterShader.setFloat("material.shininess", 32.0f);
+
+    // Static scene: all meshes in shared buffers, submitted through one queue per frame
+    const MeshArena& meshArena = MeshRegistry::getArena();
+    RenderQueue renderQueue(meshArena);
+    renderQueue.setStreamBuffer(&streamBuffer);
+
+    // GPU frustum/Hi-Z culling on GL 4.3 contexts, CPU frustum culling otherwise
+    GpuCuller* gpuCuller = GpuCuller::isSupported() ? new GpuCuller() : nullptr;
+    renderQueue.setGpuCuller(gpuCuller);
+
+    // Room-sized groups are skipped when last frame's box query found them hidden
+    OcclusionQueries occlusionQueries(OcclusionGroups::COUNT);
+    renderQueue.setOcclusionQueries(&occlusionQueries);
+
+    // Classroom, hallway and outdoors joined by the door and window openings
+    PortalGraph portalGraph;
+    int doorPortal = ClassroomObjects::buildPortalGraph(portalGraph);
+
+    // The camera slides along walls and furniture instead of passing through
+    std::vector<AABB> colliders;
+    ClassroomObjects::buildColliders(colliders);
+    CollisionWorld collisionWorld(
+        CollisionConfig::CAPSULE_RADIUS, CollisionConfig::CAPSULE_HEIGHT, CollisionConfig::CELL_SIZE);
+    collisionWorld.build(colliders);
+    camera.SetCollisionWorld(&collisionWorld);
+
+    // Walls hide whatever is behind them from clicks
+    std::vector<AABB> pickOccluderBoxes;
+    ClassroomObjects::buildWallColliders(pickOccluderBoxes);
+    BVH pickOccluders;
+    pickOccluders.build(pickOccluderBoxes);
+
+    // Moving parts: only the subtree under a changed node is recomputed each frame
+    SceneGraph sceneGraph;
+    CeilingFanNodes fanNodes = ClassroomObjects::buildCeilingFan(sceneGraph);
+    float doorX = -ClassroomConfig::WIDTH / 2.0f + 0.15f;
+    float doorY = 4.0f;
+    DoorNodes doorNodes = ClassroomObjects::buildDoor(
+        sceneGraph, glm::vec3(doorX, doorY, DoorConfig::Z_POSITION), DoorConfig::WIDTH, 90.0f);
+
+    // Renderables recorded once into packed component arrays; each object's
+    // bounds go into a BVH for culling and picking
+    SceneObjects sceneObjects;
+    EntityWorld entityWorld(meshArena);
+    InteractiveObjects interactive = ClassroomObjects::populateEntities(
+        entityWorld, sceneObjects, fanNodes, doorNodes, lightingShader
+    );
+    entityWorld.finalize(sceneObjects);
+
+    // Posters: every image lives in one texture array, drawn as one instanced
+    // batch. Layers stream in through the loader (decode on workers, PBO
+    // uploads here) and start out as grey placeholders.
+    AsyncTextureLoader textureLoader;
+    TextureArray posterTextures;
+    posterTextures.addImage("Images/Tet.png");
+    posterTextures.addImage("Images/Tet1.jpg");
+    posterTextures.build(textureLoader, PosterConfig::LAYER_WIDTH, PosterConfig::LAYER_HEIGHT);
+
+    PosterBatch posterBatch(meshArena);
+    posterBatch.setInstances(ClassroomObjects::layoutPosters(posterTextures));
+
+    // Imported model, cooked offline and uploaded straight from the mapped file
+    CookedModel importedModel;
+    importedModel.load(ImportedModelConfig::PATH);
+    glm::mat4 importedModelTransform = glm::translate(glm::mat4(1.0f), ImportedModelConfig::POSITION);
+    importedModelTransform = glm::rotate(importedModelTransform,
+        glm::radians(ImportedModelConfig::ROTATION_Y), glm::vec3(0.0f, 1.0f, 0.0f));
+    importedModelTransform = glm::scale(importedModelTransform, glm::vec3(ImportedModelConfig::SCALE));
 
     // Sun animator setup
     sunAnimator = new ObjectAnimator(glm::vec3(30.0f, 20.0f, -50.0f));
@@ -185,6 +223,13 @@ int main()
 
         processInput(window);
 
+        // Posters are resized to each image's aspect ratio as it arrives
+        textureLoader.update();
+        if (posterTextures.takeAspectChanges())
+            posterBatch.setInstances(ClassroomObjects::layoutPosters(posterTextures));
+
+        streamBuffer.beginFrame();
+
         glClearColor(0.5f, 0.7f, 0.9f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -198,156 +243,124 @@ int main()
         );
         glm::mat4 view = camera.GetViewMatrix();
 
+        ClassroomObjects::animateCeilingFan(sceneGraph, fanNodes, currentFrame, fanOn);
+        ClassroomObjects::setDoorOpen(sceneGraph, doorNodes, DoorConfig::WIDTH, doorOpen);
+        sceneGraph.update();
+        entityWorld.animate(sceneGraph, sceneObjects);
+
+        // Which cells can be seen from the camera's cell this frame
+        portalGraph.setPortalOpen(doorPortal, doorOpen);
+        portalGraph.update(projection * view, camera.Position);
+        Frustum frustum = Frustum::fromMatrix(projection * view);
+        sceneObjects.update(frustum);
+
+        // Click the door, fan or projector to toggle it. The cursor is captured,
+        // so the ray goes through the crosshair at the center of the screen.
+        if (pickRequested)
+        {
+            pickRequested = false;
+            float distance, wallDistance;
+            int picked = sceneObjects.raycast(camera.Position, camera.Front, PickConfig::MAX_DISTANCE, distance);
+            if (picked >= 0 && pickOccluders.raycast(camera.Position, camera.Front, distance, wallDistance) >= 0 &&
+                wallDistance < distance)
+                picked = -1;
+            if (picked == interactive.door)
+                doorOpen = !doorOpen;
+            else if (picked == interactive.fan)
+                fanOn = !fanOn;
+            else if (picked == interactive.projector)
+                projectorOn = !projectorOn;
+        }
+
         // Setup lighting
-        setupLighting(lightingShader, ceilingLightPositions, sunPosition);
+        setupLighting(lightingBuffer, ceilingLightPositions, sunPosition);
+        lightingBuffer.upload(&streamBuffer);
+        posterShader.use();
+        posterShader.setVec3("viewPos", camera.Position);
+        lightingShader.use();
+        lightingShader.setVec3("viewPos", camera.Position);
         lightingShader.setMat4("projection", projection);
         lightingShader.setMat4("view", view);
+        sceneShader.use();
+        sceneShader.setVec3("viewPos", camera.Position);
+        sceneShader.setMat4("projection", projection);
+        sceneShader.setMat4("view", view);
 
-        // Render main scene structure
-        ClassroomObjects::renderClassroomStructure(
-            cubeVAO, planeVAO, windowVAO,
-            lightingShader, view, projection
-        );
+        // Everything drawn through RenderUtils from here on is recorded
+        renderQueue.begin();
+        RenderQueue::setActive(&renderQueue);
 
-        // Render hallway with handrail
-        ClassroomObjects::renderHallway(
-            cubeVAO, lightingShader, view, projection
-        );
+        entityWorld.submit(renderQueue, portalGraph, sceneObjects);
 
-        float frontZ = ClassroomConfig::DEPTH / 2.0f;
-
-        // Blackboard
-        PanelStyle blackboard{
-            25.0f, 8.0f, 0.15f, 0.2f,
-            {0.3f, 0.2f, 0.1f}, {0.5f, 0.3f, 0.15f}, {0.2f, 0.15f, 0.1f},
-            {0.05f, 0.1f, 0.05f}, {0.1f, 0.2f, 0.1f}, {0.05f, 0.05f, 0.05f},
-            true
-        };
-        ClassroomObjects::renderFramedPanel(
-            cubeVAO, lightingShader, view, projection,
-            glm::vec3(10.0f, 8.0f, frontZ - 0.2f), blackboard
-        );
+        // Classroom contents outside the entity world: skipped unless a portal chain reaches the room
+        if (portalGraph.isCellVisible(PortalCells::CLASSROOM))
+        {
+            // Posters on the back wall
+            ClassroomObjects::renderPosters(
+                posterShader, view, projection,
+                posterTextures, posterBatch
+            );
+
+            // Ceiling lights
+            ClassroomObjects::renderCeilingLights(
+                lightCubeShader, view, projection,
+                ceilingLightPositions, lightsOn
+            );
+        }
 
-        // Projection screen
-        PanelStyle screen{
-            15.0f, 9.0f, 0.05f, 0.15f,
-            {0.05f, 0.05f, 0.05f}, {0.1f, 0.1f, 0.1f}, {0.2f, 0.2f, 0.2f},
-            {0.8f, 0.8f, 0.8f}, {0.95f, 0.95f, 0.95f}, {0.3f, 0.3f, 0.3f},
-            false
-        };
-        ClassroomObjects::renderFramedPanel(
-            cubeVAO, lightingShader, view, projection,
-            glm::vec3(-12.0f, 8.0f, frontZ - 0.2f), screen
-        );
+        // Sun
+        if (portalGraph.isCellVisible(PortalCells::OUTDOORS))
+        {
+            lightCubeShader.use();
+            lightCubeShader.setMat4("projection", projection);
+            lightCubeShader.setMat4("view", view);
+            lightCubeShader.setVec3("lightColor", 1.0f, 1.0f, 0.8f);
 
-        // Projector
-        ClassroomObjects::renderProjector(
-            cubeVAO, cylinderVAO, lightingShader, view, projection,
-            glm::vec3(-10.0f, 12.0f, frontZ - 20.0f)
-        );
 
-        // Door
-        PanelStyle door{
-            DoorConfig::WIDTH, DoorConfig::HEIGHT, 0.15f, 0.15f,
-            {0.2f, 0.1f, 0.05f}, {0.4f, 0.2f, 0.1f}, {0.3f, 0.15f, 0.08f},
-            {0.3f, 0.2f, 0.1f}, {0.6f, 0.4f, 0.2f}, {0.4f, 0.3f, 0.2f},
-            false
-        };
-        float doorX = -ClassroomConfig::WIDTH / 2.0f + 0.15f;
-        float doorY = 4.0f;
-        ClassroomObjects::renderFramedPanel(
-            cubeVAO, lightingShader, view, projection,
-            glm::vec3(doorX, doorY, DoorConfig::Z_POSITION),
-            door, 90.0f, true, doorOpen
-        );
+            glm::mat4 sunModel = glm::mat4(1.0f);
+            sunModel = glm::translate(sunModel, sunPosition);
+            sunModel = glm::scale(sunModel, glm::vec3(5.0f));
+            lightCubeShader.setMat4("model", sunModel);
+            MeshRegistry::draw(Mesh::SPHERE);
+        }
 
-        // Ceiling lights
-        ClassroomObjects::renderCeilingLights(
-            cubeVAO, lightCubeShader, view, projection,
-            ceilingLightPositions, lightsOn
-        );
+        RenderQueue::setActive(nullptr);
+        renderQueue.flush(sceneShader, projection * view, camera.Position);
 
-        // Ceiling fan
-        ClassroomObjects::renderCeilingFan(
-            cubeVAO, cylinderVAO, lightingShader,
-            view, projection, currentFrame, fanOn
-        );
+        // Drawn after the queue so its translucent parts blend over the scene
+        if (importedModel.isLoaded() && portalGraph.isCellVisible(PortalCells::CLASSROOM))
+            importedModel.draw(lightingShader, importedModelTransform, frustum, camera.Position);
 
-        // Desks and benches
-        float deskStride = DeskDimensions::MAIN_WIDTH + DeskLayout::PAIR_SPACING;
-        float columnWidth = DeskLayout::NUM_DESKS_PER_GROUP * deskStride;
+        streamBuffer.endFrame();
 
-        for (int row = 0; row < DeskLayout::NUM_ROWS; row++)
+        if (uploadReport)
         {
-            for (int col = 0; col < DeskLayout::NUM_COLS; col++)
-            {
-                // Bench
-                ClassroomObjects::renderBench(
-                    cubeVAO, lightingShader, view, projection,
-                    glm::vec3(
-                        DeskLayout::START_X + col * (columnWidth + DeskLayout::COL_SPACING) +
-                        (columnWidth - DeskLayout::PAIR_SPACING) / 2.0f - deskStride / 2.0f,
-                        0.0f,
-                        DeskLayout::START_Z + row * DeskLayout::ROW_SPACING - DeskLayout::ROW_SPACING / 2.0f
-                    ),
-                    columnWidth,
-                    BenchDimensions::DEPTH,
-                    BenchDimensions::HEIGHT,
-                    BenchDimensions::LEG_WIDTH,
-                    BenchDimensions::HEIGHT
-                );
-
-                // Desks
-                for (int i = 0; i < DeskLayout::NUM_DESKS_PER_GROUP; i++)
-                {
-                    float x = DeskLayout::START_X + col * (columnWidth + DeskLayout::COL_SPACING) + i * deskStride;
-                    float z = DeskLayout::START_Z + row * DeskLayout::ROW_SPACING;
-                    ClassroomObjects::renderDesk(
-                        cubeVAO, planeVAO, lightingShader, view, projection,
-                        glm::vec3(x, 0.0f, z)
-                    );
-                }
-            }
+            std::cout << "Uploaded: " << renderQueue.getLastUploadBytes() << " B instances/commands, "
+                << lightingBuffer.getLastUploadBytes() << " B lighting, "
+                << streamBuffer.getLastFrameBytes() << " B staged"
+                << (streamBuffer.getLastBeginWaited() ? " (waited for the GPU)" : "") << std::endl;
         }
 
-        // Sun
-        lightCubeShader.use();
-        lightCubeShader.setMat4("projection", projection);
-        lightCubeShader.setMat4("view", view);
-        lightCubeShader.setVec3("lightColor", 1.0f, 1.0f, 0.8f);
-
-
-        glBindVertexArray(sphereVAO);
-        glm::mat4 sunModel = glm::mat4(1.0f);
-        sunModel = glm::translate(sunModel, sunPosition);
-        sunModel = glm::scale(sunModel, glm::vec3(5.0f));
-        lightCubeShader.setMat4("model", sunModel);
-        glDrawArrays(GL_TRIANGLES, 0, Mesh::GetVertexCount(Mesh::SPHERE));
-
-        // Teacher's desk
-        ClassroomObjects::renderTeacherDesk(
-            cubeVAO, planeVAO, lightingShader, view, projection,
-            glm::vec3(-15.0f, 0.0f, frontZ - 5.0f)  // Center front
-        );
-
-
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
     // Cleanup
-    glDeleteVertexArrays(1, &cubeVAO);
-    glDeleteVertexArrays(1, &planeVAO);
-    glDeleteVertexArrays(1, &sphereVAO);
-    glDeleteVertexArrays(1, &windowVAO);
-    glDeleteVertexArrays(1, &cylinderVAO);
-    glDeleteBuffers(1, &cubeVBO);
-    glDeleteBuffers(1, &planeVBO);
-    glDeleteBuffers(1, &sphereVBO);
-    glDeleteBuffers(1, &windowVBO);
-    glDeleteBuffers(1, &cylinderVBO);
     lightingShader.deleteProgram();
     lightCubeShader.deleteProgram();
+    posterShader.deleteProgram();
+    sceneShader.deleteProgram();
+    renderQueue.release();
+    lightingBuffer.release();
+    streamBuffer.release();
+    occlusionQueries.release();
+    delete gpuCuller;
+    MeshRegistry::release();
+    textureLoader.shutdown();
+    posterBatch.release();
+    posterTextures.release();
+    importedModel.release();
+    MaterialRegistry::release();
 
     delete sunAnimator;
 
@@ -359,75 +372,68 @@ int main()
 // LIGHTING SETUP
 // ============================================================================
 
-void setupLighting(Shader& lightingShader, const glm::vec3 ceilingLightPositions[4], glm::vec3 sunPosition)
+void setupLighting(LightingBuffer& lighting, const glm::vec3 ceilingLightPositions[4], glm::vec3 sunPosition)
 {
-    lightingShader.use();
-    lightingShader.setVec3("viewPos", camera.Position);
-    lightingShader.setFloat("material.shininess", 32.0f);
-
     // Directional light (sun)
-    glm::vec3 sunDirection = glm::normalize(glm::vec3(0.0f, 0.0f, 0.0f) - sunPosition);
-    lightingShader.setVec3("dirLight.direction", sunDirection);
-    lightingShader.setVec3("dirLight.ambient", 0.3f, 0.3f, 0.3f);
-    lightingShader.setVec3("dirLight.diffuse", 0.8f, 0.8f, 0.7f);
-    lightingShader.setVec3("dirLight.specular", 0.5f, 0.5f, 0.5f);
+    DirLightDesc sun;
+    sun.direction = glm::normalize(glm::vec3(0.0f, 0.0f, 0.0f) - sunPosition);
+    sun.ambient = glm::vec3(0.3f, 0.3f, 0.3f);
+    sun.diffuse = glm::vec3(0.8f, 0.8f, 0.7f);
+    sun.specular = glm::vec3(0.5f, 0.5f, 0.5f);
+    lighting.setSun(sun);
 
     // Point lights (ceiling lights)
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < LightingBuffer::NUM_POINT_LIGHTS; i++)
     {
-        std::string number = std::to_string(i);
-        lightingShader.setVec3("pointLights[" + number + "].position", ceilingLightPositions[i]);
+        PointLightDesc light;
+        light.position = ceilingLightPositions[i];
 
         if (lightsOn)
         {
-            lightingShader.setVec3("pointLights[" + number + "].ambient", 0.2f, 0.2f, 0.2f);
-            lightingShader.setVec3("pointLights[" + number + "].diffuse", 0.8f, 0.8f, 0.8f);
-            lightingShader.setVec3("pointLights[" + number + "].specular", 1.0f, 1.0f, 1.0f);
+            light.ambient = glm::vec3(0.2f, 0.2f, 0.2f);
+            light.diffuse = glm::vec3(0.8f, 0.8f, 0.8f);
+            light.specular = glm::vec3(1.0f, 1.0f, 1.0f);
         }
         else
         {
-            lightingShader.setVec3("pointLights[" + number + "].ambient", 0.0f, 0.0f, 0.0f);
-            lightingShader.setVec3("pointLights[" + number + "].diffuse", 0.0f, 0.0f, 0.0f);
-            lightingShader.setVec3("pointLights[" + number + "].specular", 0.0f, 0.0f, 0.0f);
+            light.ambient = glm::vec3(0.0f, 0.0f, 0.0f);
+            light.diffuse = glm::vec3(0.0f, 0.0f, 0.0f);
+            light.specular = glm::vec3(0.0f, 0.0f, 0.0f);
         }
 
-        lightingShader.setFloat("pointLights[" + number + "].constant", 1.0f);
-        lightingShader.setFloat("pointLights[" + number + "].linear", 0.045f);
-        lightingShader.setFloat("pointLights[" + number + "].quadratic", 0.0075f);
+        light.constant = 1.0f;
+        light.linear = 0.045f;
+        light.quadratic = 0.0075f;
+        lighting.setPointLight(i, light);
     }
 
     // Spotlight (projector)
-    lightingShader.setVec3("spotLight.position", glm::vec3(-10.0f, 12.0f, 5.0f));
-    lightingShader.setVec3("spotLight.direction",
-        glm::normalize(glm::vec3(-12.0f, 8.0f, 24.8f) - glm::vec3(-10.0f, 12.0f, 5.0f)));
-
-    //first frame default values
-    lightingShader.setVec3("spotLight.ambient", 0.0f, 0.0f, 0.0f);
-    lightingShader.setVec3("spotLight.diffuse", 0.0f, 0.0f, 0.0f);
-    lightingShader.setVec3("spotLight.specular", 0.0f, 0.0f, 0.0f);
-    lightingShader.setFloat("spotLight.constant", 1.0f);
-    lightingShader.setFloat("spotLight.linear", 0.09f);
-    lightingShader.setFloat("spotLight.quadratic", 0.032f);
-    lightingShader.setFloat("spotLight.cutOff", glm::cos(glm::radians(12.5f)));
-    lightingShader.setFloat("spotLight.outerCutOff", glm::cos(glm::radians(15.0f)));
+    SpotLightDesc spot;
+    spot.position = glm::vec3(-10.0f, 12.0f, 5.0f);
+    spot.direction = glm::normalize(glm::vec3(-12.0f, 8.0f, 24.8f) - glm::vec3(-10.0f, 12.0f, 5.0f));
+    spot.ambient = glm::vec3(0.0f, 0.0f, 0.0f);
 
     if (projectorOn)
     {
-        lightingShader.setVec3("spotLight.ambient", 0.0f, 0.0f, 0.0f);
-        lightingShader.setVec3("spotLight.diffuse", 1.5f, 1.8f, 4.0f);
-        lightingShader.setVec3("spotLight.specular", 2.0f, 2.5f, 4.5f);
-        lightingShader.setFloat("spotLight.constant", 1.0f);
-        lightingShader.setFloat("spotLight.linear", 0.014f);
-        lightingShader.setFloat("spotLight.quadratic", 0.0007f);
-        lightingShader.setFloat("spotLight.cutOff", glm::cos(glm::radians(10.0f)));
-        lightingShader.setFloat("spotLight.outerCutOff", glm::cos(glm::radians(13.0f)));
+        spot.diffuse = glm::vec3(1.5f, 1.8f, 4.0f);
+        spot.specular = glm::vec3(2.0f, 2.5f, 4.5f);
+        spot.constant = 1.0f;
+        spot.linear = 0.014f;
+        spot.quadratic = 0.0007f;
+        spot.cutOff = glm::cos(glm::radians(10.0f));
+        spot.outerCutOff = glm::cos(glm::radians(13.0f));
     }
     else
     {
-        lightingShader.setVec3("spotLight.ambient", 0.0f, 0.0f, 0.0f);
-        lightingShader.setVec3("spotLight.diffuse", 0.0f, 0.0f, 0.0f);
-        lightingShader.setVec3("spotLight.specular", 0.0f, 0.0f, 0.0f);
+        spot.diffuse = glm::vec3(0.0f, 0.0f, 0.0f);
+        spot.specular = glm::vec3(0.0f, 0.0f, 0.0f);
+        spot.constant = 1.0f;
+        spot.linear = 0.09f;
+        spot.quadratic = 0.032f;
+        spot.cutOff = glm::cos(glm::radians(12.5f));
+        spot.outerCutOff = glm::cos(glm::radians(15.0f));
     }
+    lighting.setSpotLight(spot);
 }
 
 // ============================================================================
@@ -460,40 +466,16 @@ void processInput(GLFWwindow* window)
         cKeyPressed = false;
     }
 
-    // V = toggle fan
-    static bool vKeyPressed = false;
-    if (glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS && !vKeyPressed)
-    {
-        vKeyPressed = true;
-        fanOn = !fanOn;
-    }
-    if (glfwGetKey(window, GLFW_KEY_V) == GLFW_RELEASE)
-    {
-        vKeyPressed = false;
-    }
-
-    // B = toggle projector
-    static bool bKeyPressed = false;
-    if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !bKeyPressed)
-    {
-        bKeyPressed = true;
-        projectorOn = !projectorOn;
-    }
-    if (glfwGetKey(window, GLFW_KEY_B) == GLFW_RELEASE)
-    {
-        bKeyPressed = false;
-    }
-
-    // Z = toggle door
-    static bool zKeyPressed = false;
-    if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS && !zKeyPressed)
+    // U = toggle the per-frame upload report
+    static bool uKeyPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_U) == GLFW_PRESS && !uKeyPressed)
     {
-        zKeyPressed = true;
-        doorOpen = !doorOpen;
+        uKeyPressed = true;
+        uploadReport = !uploadReport;
     }
-    if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_RELEASE)
+    if (glfwGetKey(window, GLFW_KEY_U) == GLFW_RELEASE)
     {
-        zKeyPressed = false;
+        uKeyPressed = false;
     }
 }
 
@@ -514,6 +496,12 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos)
     camera.ProcessMouseMovement(xoffset, yoffset);
 }
 
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
+        pickRequested = true;
+}
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
     glViewport(0, 0, width, height);
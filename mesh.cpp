@@ -1,8 +1,13 @@
 #include "Mesh.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <mutex>
 #include<glm/glm.hpp>
 
-static std::vector<float> cubeVertices = {
+static constexpr std::array<float, 36 * 8> cubeVertices = {
     // positions          // normals           // texture coords
     -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
      0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
@@ -47,7 +52,7 @@ static std::vector<float> cubeVertices = {
     -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
 };
 
-static std::vector<float> planeVertices = {
+static constexpr std::array<float, 6 * 8> planeVertices = {
      0.5f, 0.0f,  0.5f,   0,1,0,   1,1,
     -0.5f, 0.0f,  0.5f,   0,1,0,   0,1,
     -0.5f, 0.0f, -0.5f,   0,1,0,   0,0,
@@ -57,7 +62,7 @@ static std::vector<float> planeVertices = {
      0.5f, 0.0f, -0.5f,   0,1,0,   1,0
 };
 
-static std::vector<float> tetrahedronVertices = {
+static constexpr std::array<float, 12 * 8> tetrahedronVertices = {
     // positions          // normals           // texcoords
      0.0f,  0.577f,  0.0f,   0,1,0,  0.5f,1.0f,
     -0.5f, -0.289f,  0.5f,   0,1,0,  0,0,
@@ -77,7 +82,7 @@ static std::vector<float> tetrahedronVertices = {
 };
 
 
-static std::vector<float> pentahedronVertices = {
+static constexpr std::array<float, 12 * 8> pentahedronVertices = {
     // Front triangle
      0.0f,  0.5f,  0.5f,   0,0,1,  0.5f,1,
     -0.5f, -0.5f,  0.5f,   0,0,1,  0,0,
@@ -98,13 +103,35 @@ static std::vector<float> pentahedronVertices = {
       0.5f,  0.5f,  0.0f,   1,0,0, 0.5f,1
 };
 
-// Window geometry - a frame with 4 rectangular panes (2x2 grid)
-static std::vector<float> windowVertices;
-static std::vector<float> sphereVertices;
-static std::vector<float> cylinderVertices;
-static std::vector<float> paraboloidVertices;
+// Largest |coordinate| along one axis, evaluated at compile time for the
+// tables above
+template <size_t N>
+constexpr float extent(const std::array<float, N>& vertices, int axis)
+{
+    float result = 0.0f;
+    for (size_t i = axis; i < N; i += 8)
+    {
+        float value = vertices[i] < 0.0f ? -vertices[i] : vertices[i];
+        result = value > result ? value : result;
+    }
+    return result;
+}
 
-static void generateWindow()
+template <size_t N>
+constexpr bool fitsUnitCube(const std::array<float, N>& vertices)
+{
+    return extent(vertices, 0) <= 0.5f && extent(vertices, 1) <= 0.5f && extent(vertices, 2) <= 0.5f;
+}
+
+// RenderUtils and ClassroomObjects scale these by object dimensions, which
+// only works while they span exactly the unit cube
+static_assert(fitsUnitCube(cubeVertices) && extent(cubeVertices, 1) == 0.5f, "cube must span the unit cube");
+static_assert(fitsUnitCube(planeVertices) && extent(planeVertices, 1) == 0.0f, "plane must be flat at y = 0");
+static_assert(fitsUnitCube(pentahedronVertices), "pentahedron must fit the unit cube");
+
+// Window geometry - a frame with 4 rectangular panes (2x2 grid)
+// Returns the first vertex of the glass panes; the frame comes before them
+static int generateWindow(std::vector<float>& windowVertices)
 {
     windowVertices.clear();
 
@@ -120,7 +147,7 @@ static void generateWindow()
     float midX = 0.0f;  // Middle vertical bar position
     float midY = 0.0f;  // Middle horizontal bar position
 
-    auto addQuad = [](glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec3 p4, glm::vec3 normal,
+    auto addQuad = [&windowVertices](glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec3 p4, glm::vec3 normal,
         float u1, float v1, float u2, float v2, float u3, float v3, float u4, float v4)
         {
             // Triangle 1
@@ -259,6 +286,7 @@ static void generateWindow()
     // ============================================
 
     float glassZ = 0.0f; // Glass sits in the middle
+    int glassFirstVertex = (int)windowVertices.size() / 8;
 
     // Top-left pane
     addQuad(
@@ -295,293 +323,362 @@ static void generateWindow()
         glm::vec3(midX + halfFW, midY - halfFW, glassZ),
         normalFront, 0.5f, 0, 1, 0, 1, 0.5f, 0.5f, 0.5f
     );
+
+    return glassFirstVertex;
 }
 
-// lightweight generated UV sphere
-static void generateSphere()
-{
-    const unsigned int X_SEGMENTS = 32;
-    const unsigned int Y_SEGMENTS = 16;
+namespace {
     const float PI = 3.1415926f;
+    const int FLOATS_PER_VERTEX = 8;
 
-    for (unsigned int y = 0; y < Y_SEGMENTS; ++y)
-    {
-        for (unsigned int x = 0; x < X_SEGMENTS; ++x)
-        {
-            float x0 = (float)x / X_SEGMENTS;
-            float x1 = (float)(x + 1) / X_SEGMENTS;
-            float y0 = (float)y / Y_SEGMENTS;
-            float y1 = (float)(y + 1) / Y_SEGMENTS;
-
-            float theta0 = x0 * 2.0f * PI;
-            float theta1 = x1 * 2.0f * PI;
-            float phi0 = y0 * PI;
-            float phi1 = y1 * PI;
-
-            glm::vec3 p0(
-                cos(theta0) * sin(phi0),
-                cos(phi0),
-                sin(theta0) * sin(phi0)
-            );
-            glm::vec3 p1(
-                cos(theta1) * sin(phi0),
-                cos(phi0),
-                sin(theta1) * sin(phi0)
-            );
-            glm::vec3 p2(
-                cos(theta1) * sin(phi1),
-                cos(phi1),
-                sin(theta1) * sin(phi1)
-            );
-            glm::vec3 p3(
-                cos(theta0) * sin(phi1),
-                cos(phi1),
-                sin(theta0) * sin(phi1)
-            );
-
-            auto pushVertex = [](glm::vec3 p, float u, float v)
-                {
-                    sphereVertices.push_back(p.x);
-                    sphereVertices.push_back(p.y);
-                    sphereVertices.push_back(p.z);
-
-
-                    sphereVertices.push_back(p.x);
-                    sphereVertices.push_back(p.y);
-                    sphereVertices.push_back(p.z);
-
-                    sphereVertices.push_back(u);
-                    sphereVertices.push_back(v);
-                };
+    // Rows are only worth a thread each once a mesh has a few thousand quads
+    const int MIN_ROWS_PER_THREAD = 16;
 
-            // Triangle 1
-            pushVertex(p0, x0, y0);
-            pushVertex(p1, x1, y0);
-            pushVertex(p2, x1, y1);
+    // cos/sin of steps * 2pi / segments for steps 0..segments, computed once
+    // per mesh instead of per quad corner
+    struct TrigTable {
+        std::vector<float> cosines;
+        std::vector<float> sines;
 
-            // Triangle 2
-            pushVertex(p0, x0, y0);
-            pushVertex(p2, x1, y1);
-            pushVertex(p3, x0, y1);
+        TrigTable(int segments, float range)
+            : cosines(segments + 1), sines(segments + 1)
+        {
+            for (int i = 0; i <= segments; i++)
+            {
+                float angle = (float)i / segments * range;
+                cosines[i] = cos(angle);
+                sines[i] = sin(angle);
+            }
         }
+    };
+
+    inline float* writeVertex(float* out, float x, float y, float z, float nx, float ny, float nz, float u, float v)
+    {
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+        out[3] = nx;
+        out[4] = ny;
+        out[5] = nz;
+        out[6] = u;
+        out[7] = v;
+        return out + FLOATS_PER_VERTEX;
     }
 }
 
+// UV sphere of radius 1. Every quad is 6 vertices, so row y starts at a
+// known offset and rows are written in parallel straight into the output.
+void Mesh::GenerateSphere(int xSegments, int ySegments, std::vector<float>& out)
+{
+    const int QUAD_FLOATS = 6 * FLOATS_PER_VERTEX;
+    TrigTable theta(xSegments, 2.0f * PI);
+    TrigTable phi(ySegments, PI);
+
+    out.resize((size_t)xSegments * ySegments * QUAD_FLOATS);
+    float* base = out.data();
+    parallelFor(ySegments, MIN_ROWS_PER_THREAD, [&](int firstRow, int endRow) {
+        for (int y = firstRow; y < endRow; ++y)
+        {
+            float* v = base + (size_t)y * xSegments * QUAD_FLOATS;
+            float y0 = (float)y / ySegments;
+            float y1 = (float)(y + 1) / ySegments;
+            for (int x = 0; x < xSegments; ++x)
+            {
+                float x0 = (float)x / xSegments;
+                float x1 = (float)(x + 1) / xSegments;
+
+                glm::vec3 p0(theta.cosines[x] * phi.sines[y], phi.cosines[y], theta.sines[x] * phi.sines[y]);
+                glm::vec3 p1(theta.cosines[x + 1] * phi.sines[y], phi.cosines[y], theta.sines[x + 1] * phi.sines[y]);
+                glm::vec3 p2(theta.cosines[x + 1] * phi.sines[y + 1], phi.cosines[y + 1], theta.sines[x + 1] * phi.sines[y + 1]);
+                glm::vec3 p3(theta.cosines[x] * phi.sines[y + 1], phi.cosines[y + 1], theta.sines[x] * phi.sines[y + 1]);
+
+                // On a unit sphere the normal is the position
+                v = writeVertex(v, p0.x, p0.y, p0.z, p0.x, p0.y, p0.z, x0, y0);
+                v = writeVertex(v, p1.x, p1.y, p1.z, p1.x, p1.y, p1.z, x1, y0);
+                v = writeVertex(v, p2.x, p2.y, p2.z, p2.x, p2.y, p2.z, x1, y1);
+
+                v = writeVertex(v, p0.x, p0.y, p0.z, p0.x, p0.y, p0.z, x0, y0);
+                v = writeVertex(v, p2.x, p2.y, p2.z, p2.x, p2.y, p2.z, x1, y1);
+                v = writeVertex(v, p3.x, p3.y, p3.z, p3.x, p3.y, p3.z, x0, y1);
+            }
+        }
+    });
+}
 
-static void generateCylinder()
+// Cylinder of radius 0.5 and height 1 around Y. Each segment is a top cap
+// triangle, a bottom cap triangle and a side quad: 12 vertices.
+void Mesh::GenerateCylinder(int segments, std::vector<float>& out)
 {
-    const unsigned int SEGMENTS = 32;
-    const float PI = 3.1415926f;
+    const int SEGMENT_FLOATS = 12 * FLOATS_PER_VERTEX;
     const float radius = 0.5f;
     const float height = 1.0f;
+    TrigTable angle(segments, 2.0f * PI);
 
-    auto pushVertex = [](float x, float y, float z, float nx, float ny, float nz, float u, float v)
+    out.resize((size_t)segments * SEGMENT_FLOATS);
+    float* base = out.data();
+    parallelFor(segments, MIN_ROWS_PER_THREAD * 64, [&](int first, int end) {
+        for (int i = first; i < end; ++i)
         {
-            cylinderVertices.push_back(x);
-            cylinderVertices.push_back(y);
-            cylinderVertices.push_back(z);
-            cylinderVertices.push_back(nx);
-            cylinderVertices.push_back(ny);
-            cylinderVertices.push_back(nz);
-            cylinderVertices.push_back(u);
-            cylinderVertices.push_back(v);
-        };
-
-    // Top and bottom circles
-    for (unsigned int i = 0; i < SEGMENTS; ++i)
-    {
-        float angle1 = (float)i / SEGMENTS * 2.0f * PI;
-        float angle2 = (float)(i + 1) / SEGMENTS * 2.0f * PI;
-
-        float x1 = cos(angle1) * radius;
-        float z1 = sin(angle1) * radius;
-        float x2 = cos(angle2) * radius;
-        float z2 = sin(angle2) * radius;
-
-        // Top cap
-        pushVertex(0.0f, height / 2, 0.0f, 0.0f, 1.0f, 0.0f, 0.5f, 0.5f);
-        pushVertex(x1, height / 2, z1, 0.0f, 1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
-        pushVertex(x2, height / 2, z2, 0.0f, 1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
-
-        // Bottom cap
-        pushVertex(0.0f, -height / 2, 0.0f, 0.0f, -1.0f, 0.0f, 0.5f, 0.5f);
-        pushVertex(x2, -height / 2, z2, 0.0f, -1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
-        pushVertex(x1, -height / 2, z1, 0.0f, -1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
-
-        // Side faces
-        float nx1 = cos(angle1);
-        float nz1 = sin(angle1);
-        float nx2 = cos(angle2);
-        float nz2 = sin(angle2);
-
-        // First triangle of quad
-        pushVertex(x1, -height / 2, z1, nx1, 0.0f, nz1, (float)i / SEGMENTS, 0.0f);
-        pushVertex(x1, height / 2, z1, nx1, 0.0f, nz1, (float)i / SEGMENTS, 1.0f);
-        pushVertex(x2, height / 2, z2, nx2, 0.0f, nz2, (float)(i + 1) / SEGMENTS, 1.0f);
-
-        // Second triangle of quad
-        pushVertex(x1, -height / 2, z1, nx1, 0.0f, nz1, (float)i / SEGMENTS, 0.0f);
-        pushVertex(x2, height / 2, z2, nx2, 0.0f, nz2, (float)(i + 1) / SEGMENTS, 1.0f);
-        pushVertex(x2, -height / 2, z2, nx2, 0.0f, nz2, (float)(i + 1) / SEGMENTS, 0.0f);
-    }
+            float* v = base + (size_t)i * SEGMENT_FLOATS;
+            float nx1 = angle.cosines[i];
+            float nz1 = angle.sines[i];
+            float nx2 = angle.cosines[i + 1];
+            float nz2 = angle.sines[i + 1];
+            float x1 = nx1 * radius;
+            float z1 = nz1 * radius;
+            float x2 = nx2 * radius;
+            float z2 = nz2 * radius;
+            float u1 = (float)i / segments;
+            float u2 = (float)(i + 1) / segments;
+
+            // Top cap
+            v = writeVertex(v, 0.0f, height / 2, 0.0f, 0.0f, 1.0f, 0.0f, 0.5f, 0.5f);
+            v = writeVertex(v, x1, height / 2, z1, 0.0f, 1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
+            v = writeVertex(v, x2, height / 2, z2, 0.0f, 1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
+
+            // Bottom cap
+            v = writeVertex(v, 0.0f, -height / 2, 0.0f, 0.0f, -1.0f, 0.0f, 0.5f, 0.5f);
+            v = writeVertex(v, x2, -height / 2, z2, 0.0f, -1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
+            v = writeVertex(v, x1, -height / 2, z1, 0.0f, -1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
+
+            // Side quad
+            v = writeVertex(v, x1, -height / 2, z1, nx1, 0.0f, nz1, u1, 0.0f);
+            v = writeVertex(v, x1, height / 2, z1, nx1, 0.0f, nz1, u1, 1.0f);
+            v = writeVertex(v, x2, height / 2, z2, nx2, 0.0f, nz2, u2, 1.0f);
+
+            v = writeVertex(v, x1, -height / 2, z1, nx1, 0.0f, nz1, u1, 0.0f);
+            v = writeVertex(v, x2, height / 2, z2, nx2, 0.0f, nz2, u2, 1.0f);
+            v = writeVertex(v, x2, -height / 2, z2, nx2, 0.0f, nz2, u2, 0.0f);
+        }
+    });
 }
 
-// Generate paraboloid shape (y = a * (x^2 + z^2))
-static void generateParaboloid()
+// Paraboloid y = a * (x^2 + z^2) spanning y in [-0.5, 0.5], opening upwards,
+// plus a small bottom cap: heightSegments rows of quads, then one fan
+void Mesh::GenerateParaboloid(int radialSegments, int heightSegments, std::vector<float>& out)
 {
-    paraboloidVertices.clear();
-
-    const unsigned int RADIAL_SEGMENTS = 32;
-    const unsigned int HEIGHT_SEGMENTS = 16;
-    const float PI = 3.1415926f;
+    const int QUAD_FLOATS = 6 * FLOATS_PER_VERTEX;
+    const int CAP_FLOATS = 3 * FLOATS_PER_VERTEX;
     const float maxRadius = 0.5f;
     const float height = 1.0f;
+    const float capRadius = 0.01f;
     const float a = height / (maxRadius * maxRadius); // Parabola coefficient
+    TrigTable angle(radialSegments, 2.0f * PI);
 
-    auto pushVertex = [](float x, float y, float z, float nx, float ny, float nz, float u, float v)
-        {
-            paraboloidVertices.push_back(x);
-            paraboloidVertices.push_back(y);
-            paraboloidVertices.push_back(z);
-            paraboloidVertices.push_back(nx);
-            paraboloidVertices.push_back(ny);
-            paraboloidVertices.push_back(nz);
-            paraboloidVertices.push_back(u);
-            paraboloidVertices.push_back(v);
-        };
-
-    // Generate the paraboloid surface
-    for (unsigned int h = 0; h < HEIGHT_SEGMENTS; ++h)
+    // Ring height, radius and the slope terms of the normal, per ring
+    std::vector<float> ringY(heightSegments + 1);
+    std::vector<float> ringRadius(heightSegments + 1);
+    for (int h = 0; h <= heightSegments; h++)
     {
-        for (unsigned int r = 0; r < RADIAL_SEGMENTS; ++r)
+        float t = (float)h / heightSegments;
+        ringY[h] = t * height - height / 2.0f;
+        ringRadius[h] = std::sqrt(std::fabs(ringY[h] + height / 2.0f) / a);
+    }
+
+    size_t surfaceFloats = (size_t)radialSegments * heightSegments * QUAD_FLOATS;
+    out.resize(surfaceFloats + (size_t)radialSegments * CAP_FLOATS);
+    float* base = out.data();
+
+    parallelFor(heightSegments, MIN_ROWS_PER_THREAD, [&](int firstRow, int endRow) {
+        for (int h = firstRow; h < endRow; ++h)
         {
-            // Calculate radii for current and next height level
-            float t0 = (float)h / HEIGHT_SEGMENTS;
-            float t1 = (float)(h + 1) / HEIGHT_SEGMENTS;
-
-            float y0 = t0 * height - height / 2.0f;  // Map to [-height/2, height/2]
-            float y1 = t1 * height - height / 2.0f;
-
-            // For paraboloid: r = sqrt(y/a), but we reverse it
-            float radius0 = sqrt(abs(y0 + height / 2.0f) / a);
-            float radius1 = sqrt(abs(y1 + height / 2.0f) / a);
-
-            // Calculate angles
-            float angle0 = (float)r / RADIAL_SEGMENTS * 2.0f * PI;
-            float angle1 = (float)(r + 1) / RADIAL_SEGMENTS * 2.0f * PI;
-
-            // Calculate positions
-            float x00 = cos(angle0) * radius0;
-            float z00 = sin(angle0) * radius0;
-            float x01 = cos(angle1) * radius0;
-            float z01 = sin(angle1) * radius0;
-            float x10 = cos(angle0) * radius1;
-            float z10 = sin(angle0) * radius1;
-            float x11 = cos(angle1) * radius1;
-            float z11 = sin(angle1) * radius1;
-
-            // Calculate normals (derivative of paraboloid)
-            glm::vec3 p00(x00, y0, z00);
-            glm::vec3 p01(x01, y0, z01);
-            glm::vec3 p10(x10, y1, z10);
-            glm::vec3 p11(x11, y1, z11);
-
-            // Approximate normal for each vertex
-            float dydx0 = 2.0f * a * radius0 * cos(angle0);
-            float dydz0 = 2.0f * a * radius0 * sin(angle0);
-            glm::vec3 n00 = glm::normalize(glm::vec3(-dydx0, 1.0f, -dydz0));
-
-            float dydx1 = 2.0f * a * radius0 * cos(angle1);
-            float dydz1 = 2.0f * a * radius0 * sin(angle1);
-            glm::vec3 n01 = glm::normalize(glm::vec3(-dydx1, 1.0f, -dydz1));
-
-            float dydx2 = 2.0f * a * radius1 * cos(angle0);
-            float dydz2 = 2.0f * a * radius1 * sin(angle0);
-            glm::vec3 n10 = glm::normalize(glm::vec3(-dydx2, 1.0f, -dydz2));
-
-            float dydx3 = 2.0f * a * radius1 * cos(angle1);
-            float dydz3 = 2.0f * a * radius1 * sin(angle1);
-            glm::vec3 n11 = glm::normalize(glm::vec3(-dydx3, 1.0f, -dydz3));
-
-            // UV coordinates
-            float u0 = (float)r / RADIAL_SEGMENTS;
-            float u1 = (float)(r + 1) / RADIAL_SEGMENTS;
-            float v0 = t0;
-            float v1 = t1;
-
-            // First triangle
-            pushVertex(p00.x, p00.y, p00.z, n00.x, n00.y, n00.z, u0, v0);
-            pushVertex(p10.x, p10.y, p10.z, n10.x, n10.y, n10.z, u0, v1);
-            pushVertex(p11.x, p11.y, p11.z, n11.x, n11.y, n11.z, u1, v1);
-
-            // Second triangle
-            pushVertex(p00.x, p00.y, p00.z, n00.x, n00.y, n00.z, u0, v0);
-            pushVertex(p11.x, p11.y, p11.z, n11.x, n11.y, n11.z, u1, v1);
-            pushVertex(p01.x, p01.y, p01.z, n01.x, n01.y, n01.z, u1, v0);
+            float* v = base + (size_t)h * radialSegments * QUAD_FLOATS;
+            float y0 = ringY[h];
+            float y1 = ringY[h + 1];
+            float radius0 = ringRadius[h];
+            float radius1 = ringRadius[h + 1];
+            float v0 = (float)h / heightSegments;
+            float v1 = (float)(h + 1) / heightSegments;
+
+            for (int r = 0; r < radialSegments; ++r)
+            {
+                float cos0 = angle.cosines[r];
+                float sin0 = angle.sines[r];
+                float cos1 = angle.cosines[r + 1];
+                float sin1 = angle.sines[r + 1];
+
+                glm::vec3 p00(cos0 * radius0, y0, sin0 * radius0);
+                glm::vec3 p01(cos1 * radius0, y0, sin1 * radius0);
+                glm::vec3 p10(cos0 * radius1, y1, sin0 * radius1);
+                glm::vec3 p11(cos1 * radius1, y1, sin1 * radius1);
+
+                // Normal from the slope: (-dy/dx, 1, -dy/dz)
+                glm::vec3 n00 = glm::normalize(glm::vec3(-2.0f * a * radius0 * cos0, 1.0f, -2.0f * a * radius0 * sin0));
+                glm::vec3 n01 = glm::normalize(glm::vec3(-2.0f * a * radius0 * cos1, 1.0f, -2.0f * a * radius0 * sin1));
+                glm::vec3 n10 = glm::normalize(glm::vec3(-2.0f * a * radius1 * cos0, 1.0f, -2.0f * a * radius1 * sin0));
+                glm::vec3 n11 = glm::normalize(glm::vec3(-2.0f * a * radius1 * cos1, 1.0f, -2.0f * a * radius1 * sin1));
+
+                float u0 = (float)r / radialSegments;
+                float u1 = (float)(r + 1) / radialSegments;
+
+                v = writeVertex(v, p00.x, p00.y, p00.z, n00.x, n00.y, n00.z, u0, v0);
+                v = writeVertex(v, p10.x, p10.y, p10.z, n10.x, n10.y, n10.z, u0, v1);
+                v = writeVertex(v, p11.x, p11.y, p11.z, n11.x, n11.y, n11.z, u1, v1);
+
+                v = writeVertex(v, p00.x, p00.y, p00.z, n00.x, n00.y, n00.z, u0, v0);
+                v = writeVertex(v, p11.x, p11.y, p11.z, n11.x, n11.y, n11.z, u1, v1);
+                v = writeVertex(v, p01.x, p01.y, p01.z, n01.x, n01.y, n01.z, u1, v0);
+            }
         }
-    }
+    });
 
-    // Add bottom cap (optional)
-    for (unsigned int i = 0; i < RADIAL_SEGMENTS; ++i)
+    float* v = base + surfaceFloats;
+    for (int i = 0; i < radialSegments; ++i)
     {
-        float angle1 = (float)i / RADIAL_SEGMENTS * 2.0f * PI;
-        float angle2 = (float)(i + 1) / RADIAL_SEGMENTS * 2.0f * PI;
+        float x1 = angle.cosines[i] * capRadius;
+        float z1 = angle.sines[i] * capRadius;
+        float x2 = angle.cosines[i + 1] * capRadius;
+        float z2 = angle.sines[i + 1] * capRadius;
+
+        v = writeVertex(v, 0.0f, -height / 2.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.5f, 0.5f);
+        v = writeVertex(v, x2, -height / 2.0f, z2, 0.0f, -1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
+        v = writeVertex(v, x1, -height / 2.0f, z1, 0.0f, -1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
+    }
+}
 
-        float x1 = cos(angle1) * 0.01f;  // Very small radius at bottom
-        float z1 = sin(angle1) * 0.01f;
-        float x2 = cos(angle2) * 0.01f;
-        float z2 = sin(angle2) * 0.01f;
+// Generated meshes, written once under generateOnce and read-only after.
+// The hand-written tables are constexpr and need no initialisation at all.
+// Every lookup goes through the per-type tables, so no switch on the hot path.
+static std::once_flag generateOnce;
+static std::vector<float> windowVertices;
+static std::vector<float> sphereVertices;
+static std::vector<float> cylinderVertices;
+static std::vector<float> paraboloidVertices;
+static const float* vertexTables[Mesh::TYPE_COUNT];
+static int vertexCounts[Mesh::TYPE_COUNT];
+static AABB meshBounds[Mesh::TYPE_COUNT];
+static BoundingSphere meshSpheres[Mesh::TYPE_COUNT];
+static Mesh::Part windowParts[Mesh::WINDOW_PART_COUNT];
+
+// Box of a vertex range, and a sphere around the box centre reaching the
+// farthest vertex (never larger than the box's own bounding sphere)
+static void computeBounds(const float* vertices, int firstVertex, int vertexCount,
+    AABB& box, BoundingSphere& sphere)
+{
+    box.minCorner = glm::vec3(vertexCount > 0 ? 1e30f : 0.0f);
+    box.maxCorner = glm::vec3(vertexCount > 0 ? -1e30f : 0.0f);
+    for (int v = firstVertex; v < firstVertex + vertexCount; v++)
+    {
+        glm::vec3 position(vertices[v * FLOATS_PER_VERTEX], vertices[v * FLOATS_PER_VERTEX + 1],
+            vertices[v * FLOATS_PER_VERTEX + 2]);
+        box.minCorner = glm::min(box.minCorner, position);
+        box.maxCorner = glm::max(box.maxCorner, position);
+    }
 
-        pushVertex(0.0f, -height / 2.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.5f, 0.5f);
-        pushVertex(x2, -height / 2.0f, z2, 0.0f, -1.0f, 0.0f, 0.5f + x2, 0.5f + z2);
-        pushVertex(x1, -height / 2.0f, z1, 0.0f, -1.0f, 0.0f, 0.5f + x1, 0.5f + z1);
+    sphere.center = (box.minCorner + box.maxCorner) * 0.5f;
+    float radiusSquared = 0.0f;
+    for (int v = firstVertex; v < firstVertex + vertexCount; v++)
+    {
+        glm::vec3 offset = glm::vec3(vertices[v * FLOATS_PER_VERTEX], vertices[v * FLOATS_PER_VERTEX + 1],
+            vertices[v * FLOATS_PER_VERTEX + 2]) - sphere.center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
     }
+    sphere.radius = std::sqrt(radiusSquared);
 }
 
-const std::vector<float>& Mesh::GetVertices(Type type)
+template <size_t N>
+static void registerTable(Mesh::Type type, const std::array<float, N>& vertices)
 {
-    if (sphereVertices.empty())
-        generateSphere();
-
-    if (windowVertices.empty())
-        generateWindow();
+    vertexTables[type] = vertices.data();
+    vertexCounts[type] = (int)N / FLOATS_PER_VERTEX;
+}
 
-    if (cylinderVertices.empty())
-        generateCylinder();
+static void registerTable(Mesh::Type type, const std::vector<float>& vertices)
+{
+    vertexTables[type] = vertices.data();
+    vertexCounts[type] = (int)vertices.size() / FLOATS_PER_VERTEX;
+}
 
-    if (paraboloidVertices.empty())
-        generateParaboloid();
+static void mergeParts(const std::vector<Mesh::PrototypePart>& parts, std::vector<float>& out)
+{
+    size_t floatCount = 0;
+    for (const Mesh::PrototypePart& part : parts)
+        floatCount += (size_t)vertexCounts[part.type] * FLOATS_PER_VERTEX;
+    out.resize(floatCount);
 
-    switch (type)
+    float* cursor = out.data();
+    for (const Mesh::PrototypePart& part : parts)
     {
-    case CUBE:         return cubeVertices;
-    case PLANE:        return planeVertices;
-    case SPHERE:       return sphereVertices;
-    case TETRAHEDRON:  return tetrahedronVertices;
-    case PENTAHEDRON:  return pentahedronVertices;
-    case WINDOW:       return windowVertices;
-    case CYLINDER:     return cylinderVertices;
-    case PARABOLOID:   return paraboloidVertices;
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(part.model)));
+        const float* source = vertexTables[part.type];
+        for (int v = 0; v < vertexCounts[part.type]; v++, source += FLOATS_PER_VERTEX)
+        {
+            glm::vec3 position = glm::vec3(part.model * glm::vec4(source[0], source[1], source[2], 1.0f));
+            glm::vec3 normal = glm::normalize(normalMatrix * glm::vec3(source[3], source[4], source[5]));
+            cursor = writeVertex(cursor, position.x, position.y, position.z,
+                normal.x, normal.y, normal.z, source[6], source[7]);
+        }
     }
-
-    return cubeVertices;
 }
 
+static void generateMeshes()
+{
+    int glassFirstVertex = generateWindow(windowVertices);
+    Mesh::GenerateSphere(Mesh::SPHERE_X_SEGMENTS, Mesh::SPHERE_Y_SEGMENTS, sphereVertices);
+    Mesh::GenerateCylinder(Mesh::CYLINDER_SEGMENTS, cylinderVertices);
+    Mesh::GenerateParaboloid(Mesh::PARABOLOID_RADIAL_SEGMENTS, Mesh::PARABOLOID_HEIGHT_SEGMENTS, paraboloidVertices);
+
+    registerTable(Mesh::CUBE, cubeVertices);
+    registerTable(Mesh::PLANE, planeVertices);
+    registerTable(Mesh::SPHERE, sphereVertices);
+    registerTable(Mesh::TETRAHEDRON, tetrahedronVertices);
+    registerTable(Mesh::PENTAHEDRON, pentahedronVertices);
+    registerTable(Mesh::WINDOW, windowVertices);
+    registerTable(Mesh::CYLINDER, cylinderVertices);
+    registerTable(Mesh::PARABOLOID, paraboloidVertices);
+
+    for (int t = 0; t < Mesh::TYPE_COUNT; t++)
+        computeBounds(vertexTables[t], 0, vertexCounts[t], meshBounds[t], meshSpheres[t]);
+
+    windowParts[Mesh::WINDOW_FRAME].firstVertex = 0;
+    windowParts[Mesh::WINDOW_FRAME].vertexCount = glassFirstVertex;
+    windowParts[Mesh::WINDOW_GLASS].firstVertex = glassFirstVertex;
+    windowParts[Mesh::WINDOW_GLASS].vertexCount = vertexCounts[Mesh::WINDOW] - glassFirstVertex;
+    for (Mesh::Part& part : windowParts)
+        computeBounds(windowVertices.data(), part.firstVertex, part.vertexCount, part.bounds, part.sphere);
+}
 
+const float* Mesh::GetVertices(Type type)
+{
+    std::call_once(generateOnce, generateMeshes);
+    if (type < 0 || type >= TYPE_COUNT)
+        return cubeVertices.data();
+    return vertexTables[type];
+}
 
 int Mesh::GetVertexCount(Type type)
 {
-    switch (type)
-    {
-    case CUBE:         return (int)cubeVertices.size() / 8;
-    case PLANE:        return (int)planeVertices.size() / 8;
-    case SPHERE:       return (int)sphereVertices.size() / 8;
-    case TETRAHEDRON:  return (int)tetrahedronVertices.size() / 8;
-    case PENTAHEDRON:  return (int)pentahedronVertices.size() / 8;
-    case WINDOW:       return (int)windowVertices.size() / 8;
-    case CYLINDER:     return (int)cylinderVertices.size() / 8;
-    case PARABOLOID:   return (int)paraboloidVertices.size() / 8;
-    }
+    std::call_once(generateOnce, generateMeshes);
+    if (type < 0 || type >= TYPE_COUNT)
+        return 0;
+    return vertexCounts[type];
+}
+
+const AABB& Mesh::GetBounds(Type type)
+{
+    std::call_once(generateOnce, generateMeshes);
+    return meshBounds[type];
+}
+
+const BoundingSphere& Mesh::GetBoundingSphere(Type type)
+{
+    std::call_once(generateOnce, generateMeshes);
+    return meshSpheres[type];
+}
+
+AABB Mesh::GetWorldBounds(Type type, const glm::mat4& model)
+{
+    return transformAABB(model, GetBounds(type));
+}
 
-    return 0;
-}
\ No newline at end of file
+void Mesh::BuildPrototype(const std::vector<PrototypePart>& parts, std::vector<float>& out)
+{
+    std::call_once(generateOnce, generateMeshes);
+    mergeParts(parts, out);
+}
+
+const Mesh::Part& Mesh::GetWindowPart(WindowPart part)
+{
+    std::call_once(generateOnce, generateMeshes);
+    return windowParts[part];
+}
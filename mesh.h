@@ -1,8 +1,10 @@
 #ifndef MESH_H
 #define MESH_H
 
+#include <glm/glm.hpp>
 #include <vector>
 #include <string>
+#include "Frustum.h"
 
 class Mesh
 {
@@ -15,12 +17,64 @@ public:
         PENTAHEDRON,
         WINDOW,
         CYLINDER,
-        PARABOLOID
+        PARABOLOID,
+        TYPE_COUNT      // Not a mesh; new types go above
     };
 
+    // WINDOW is one mesh, but its frame is opaque and its panes are glass
+    enum WindowPart {
+        WINDOW_FRAME,
+        WINDOW_GLASS,
+        WINDOW_PART_COUNT
+    };
+
+    // A vertex range of one mesh and its object-space bounds
+    struct Part {
+        int firstVertex;
+        int vertexCount;
+        AABB bounds;
+        BoundingSphere sphere;
+    };
+
+
+    // One primitive of a prototype, placed in the prototype's object space
+    struct PrototypePart {
+        Type type;
+        glm::mat4 model;
+    };
 
-    static const std::vector<float>& GetVertices(Type type);
+    // Resolution of the procedural meshes returned by GetVertices
+    static const int SPHERE_X_SEGMENTS = 32;
+    static const int SPHERE_Y_SEGMENTS = 16;
+    static const int CYLINDER_SEGMENTS = 32;
+    static const int PARABOLOID_RADIAL_SEGMENTS = 32;
+    static const int PARABOLOID_HEIGHT_SEGMENTS = 16;
+
+    // GetVertexCount() vertices of 8 floats (position, normal, UV), as
+    // non-indexed triangles. Safe from any thread: the procedural meshes are
+    // generated once, on first use, and never change afterwards.
+    static const float* GetVertices(Type type);
     static int GetVertexCount(Type type);
+
+    // Object-space bounds, computed once with the vertices
+    static const AABB& GetBounds(Type type);
+    static const BoundingSphere& GetBoundingSphere(Type type);
+    static const Part& GetWindowPart(WindowPart part);
+
+    // Bounds of the mesh drawn with this model matrix
+    static AABB GetWorldBounds(Type type, const glm::mat4& model);
+
+    // Procedural generators at any resolution, non-indexed triangles with
+    // the same 8-float layout as GetVertices. Sin/cos come from per-call
+    // tables and large meshes are written by several threads.
+    static void GenerateSphere(int xSegments, int ySegments, std::vector<float>& out);
+    static void GenerateCylinder(int segments, std::vector<float>& out);
+    static void GenerateParaboloid(int radialSegments, int heightSegments, std::vector<float>& out);
+
+    // Bakes the parts into one mesh (positions and normals transformed, UVs
+    // kept), so an object repeated many times, like a desk, is one instance
+    // per placement instead of one per part. See MeshArena::addPrototype.
+    static void BuildPrototype(const std::vector<PrototypePart>& parts, std::vector<float>& out);
 };
 
 #endif
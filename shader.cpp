@@ -1,4 +1,5 @@
 #include "shader.h"
+#include "GLCaps.h"
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -28,6 +29,21 @@ Shader::Shader(const char* vertexSource, const char* fragmentSource)
     glDeleteShader(fragmentShader);
 }
 
+Shader::Shader(const char* computeSource)
+{
+    GLuint computeShader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(computeShader, 1, &computeSource, NULL);
+    glCompileShader(computeShader);
+    checkCompileErrors(computeShader, "COMPUTE");
+
+    ID = glCreateProgram();
+    glAttachShader(ID, computeShader);
+    glLinkProgram(ID);
+    checkCompileErrors(ID, "PROGRAM");
+
+    glDeleteShader(computeShader);
+}
+
 void Shader::use()
 {
     glUseProgram(ID);
@@ -43,6 +59,11 @@ void Shader::setInt(const std::string& name, int value) const
     glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
 }
 
+void Shader::setUInt(const std::string& name, unsigned int value) const
+{
+    glUniform1ui(glGetUniformLocation(ID, name.c_str()), value);
+}
+
 void Shader::setFloat(const std::string& name, float value) const
 {
     glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
@@ -58,6 +79,16 @@ void Shader::setVec3(const std::string& name, const glm::vec3& value) const
     glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
 }
 
+void Shader::setVec2(const std::string& name, const glm::vec2& value) const
+{
+    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+}
+
+void Shader::setVec4(const std::string& name, const glm::vec4& value) const
+{
+    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+}
+
 void Shader::setMat4(const std::string& name, const glm::mat4& mat) const
 {
     glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
@@ -71,6 +102,7 @@ void Shader::setAlpha(const std::string& name, float value) const
 void Shader::deleteProgram()
 {
     glDeleteProgram(ID);
+    ID = 0;
 }
 
 void Shader::checkCompileErrors(GLuint shader, std::string type)
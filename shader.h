@@ -13,15 +13,21 @@ public:
     // Constructor reads and builds the shader
     Shader(const char* vertexSource, const char* fragmentSource);
 
+    // Compute-only program (GL 4.3)
+    explicit Shader(const char* computeSource);
+
     // Use/activate the shader
     void use();
 
     // Utility uniform functions
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
+    void setUInt(const std::string& name, unsigned int value) const;
     void setFloat(const std::string& name, float value) const;
     void setVec3(const std::string& name, float x, float y, float z) const;
     void setVec3(const std::string& name, const glm::vec3& value) const;
+    void setVec2(const std::string& name, const glm::vec2& value) const;
+    void setVec4(const std::string& name, const glm::vec4& value) const;
     void setMat4(const std::string& name, const glm::mat4& mat) const;
 
     // Add alpha support
@@ -1,10 +1,19 @@
 #include "texture.h"
+#include "GLCaps.h"
+#include "KtxFormat.h"
+#include "MappedFile.h"
 #include <iostream>
+#include <vector>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 unsigned int Texture::LoadTexture(const char* path)
 {
+    // Cooked containers carry pre-filtered mips, so no decode or glGenerateMipmap
+    unsigned int cookedID = LoadKTX(KtxFormat::cookedPath(path).c_str());
+    if (cookedID != 0)
+        return cookedID;
+
     unsigned int textureID; 
     glGenTextures(1, &textureID);
 
@@ -39,4 +48,66 @@ unsigned int Texture::LoadTexture(const char* path)
     }
 
     return textureID;
-}
\ No newline at end of file
+}
+
+unsigned int Texture::LoadKTX(const char* path)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return 0;
+
+    KtxFormat::Header header;
+    std::vector<KtxFormat::Level> levels;
+    switch (KtxFormat::parse(file.data(), file.size(), header, levels))
+    {
+    case KtxFormat::PARSE_INVALID:
+        std::cout << "Invalid KTX file: " << path << std::endl;
+        return 0;
+    case KtxFormat::PARSE_UNSUPPORTED:
+        std::cout << "Unsupported KTX layout (only single 2D images): " << path << std::endl;
+        return 0;
+    case KtxFormat::PARSE_TRUNCATED:
+        std::cout << "Truncated KTX file: " << path << std::endl;
+        return 0;
+    default:
+        break;
+    }
+
+    bool compressed = header.glType == 0;
+    bool isS3TC = header.glInternalFormat >= GL_COMPRESSED_RGB_S3TC_DXT1_EXT &&
+        header.glInternalFormat <= GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    if (compressed && isS3TC && !GLCaps::hasS3TC())
+    {
+        std::cout << "S3TC not supported by this driver, skipping: " << path << std::endl;
+        return 0;
+    }
+
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    // Upload straight from the mapped file - no intermediate copy
+    GLsizei levelCount = (GLsizei)levels.size();
+    for (GLsizei level = 0; level < levelCount; level++)
+    {
+        const KtxFormat::Level& data = levels[level];
+        if (compressed)
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, header.glInternalFormat,
+                (GLsizei)data.width, (GLsizei)data.height, 0, (GLsizei)data.imageSize, data.pixels);
+        }
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D, level, header.glInternalFormat,
+                (GLsizei)data.width, (GLsizei)data.height, 0, header.glFormat, header.glType, data.pixels);
+        }
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return textureID;
+}
@@ -7,7 +7,12 @@
 class Texture
 {
 public:
+    // Loads a texture, preferring a cooked "<path>.ktx" next to the source
+    // image (see Tools/TextureCooker) and falling back to decoding the source.
     static unsigned int LoadTexture(const char* path);
+
+    // Loads a KTX container with all of its mip levels. Returns 0 on failure.
+    static unsigned int LoadKTX(const char* path);
 };
 
-#endif
\ No newline at end of file
+#endif